@@ -44,6 +44,19 @@
 #include "Containers/Ticker.h"
 
 #include "TextureManagerStats.h"
+#include "TextureThumbnailCache.h"
+#include "TextureAnalysisLibrary.h"
+#include "TextureMemoryEstimator.h"
+#include "TextureRebuildCostModel.h"
+#include "TextureRebuildScheduler.h"
+#include "TextureBulkJournal.h"
+#include "STextureResidencyReport.h"
+#include "TextureManagerLists.h"
+#include "TextureManagerMetrics.h"
+#include "TexturePreviewPool.h"
+
+#include "Widgets/Images/SImage.h"
+#include "Widgets/Layout/SBox.h"
 
 // ---------- Structs ------------------------
 
@@ -114,38 +127,6 @@
 //	};
 //}
 
-// ---------- Helper ------------------------
-
-UTexture2D* SMyTwoColumnWidget::CloneTextureTransient(UTexture2D* Source)
-{
-	if (!Source) return nullptr;
-
-	UTexture2D* Clone = DuplicateObject<UTexture2D>(
-		Source,
-		GetTransientPackage(),
-		FName(*FString::Printf(TEXT("%s_Copy"), *Source->GetName()))
-	);
-
-	Clone->ClearFlags(RF_Standalone | RF_Public);
-	Clone->SetFlags(RF_Transient);
-	return Clone;
-}
-
-static UTexturePresetAsset* ClonePresetTransient(UTexturePresetAsset* Source)
-{
-	if (!Source) return nullptr;
-
-	UTexturePresetAsset* Clone = DuplicateObject<UTexturePresetAsset>(
-		Source,
-		GetTransientPackage(),
-		FName(*FString::Printf(TEXT("%s_Copy"), *Source->GetName()))
-	);
-
-	Clone->ClearFlags(RF_Standalone | RF_Public);
-	Clone->SetFlags(RF_Transient);
-	return Clone;
-}
-
 // ---------- Construct / Destruct ----------
 
 void SMyTwoColumnWidget::Construct(const FArguments& InArgs)
@@ -155,6 +136,9 @@ void SMyTwoColumnWidget::Construct(const FArguments& InArgs)
 
 	InitializePropertyWatcher();
 
+	ThumbnailCache = MakeShared<FTextureThumbnailCache>();
+	PreviewPool = MakeShared<FTexturePreviewPool>();
+
 	// Use injected DetailsView if provided, otherwise create one
 	if (InArgs._DetailsViewWidget.IsValid())
 	{
@@ -200,11 +184,16 @@ void SMyTwoColumnWidget::Construct(const FArguments& InArgs)
 		FTickerDelegate::CreateSP(this, &SMyTwoColumnWidget::BindWindowCloseEventOnce),
 		0.0f
 	);
+
+	TextureRebuildScheduler::OnGatherPriority().AddSP(this, &SMyTwoColumnWidget::GatherRebuildPriority);
+	TextureRebuildScheduler::OnDrained().AddSP(this, &SMyTwoColumnWidget::OnRebuildsDrained);
 }
 
 SMyTwoColumnWidget::~SMyTwoColumnWidget()
 {
 	ShutdownPropertyWatcher();
+	TextureRebuildScheduler::OnGatherPriority().RemoveAll(this);
+	TextureRebuildScheduler::OnDrained().RemoveAll(this);
 }
 
 // ---------- Keyboard: Ctrl+S ----------
@@ -282,21 +271,96 @@ TSharedRef<SWidget> SMyTwoColumnWidget::BuildLeftColumn()
 							.Visibility(this, &SMyTwoColumnWidget::IsFilesChosen)
 					]
 
+				// Files layout: flat list or grouped tree
+				+ SVerticalBox::Slot()
+					.AutoHeight()
+					.Padding(2)
+					[
+						SNew(SSegmentedControl<ETextureGrouping>)
+							.Value(this, &SMyTwoColumnWidget::GetGrouping)
+							.OnValueChanged(this, &SMyTwoColumnWidget::OnGroupingChanged)
+							.Visibility(this, &SMyTwoColumnWidget::IsFilesChosen)
+							+ SSegmentedControl<ETextureGrouping>::Slot(ETextureGrouping::Flat)
+							.Text(NSLOCTEXT("TextureManager", "GroupFlat", "List"))
+							+ SSegmentedControl<ETextureGrouping>::Slot(ETextureGrouping::ByPreset)
+							.Text(NSLOCTEXT("TextureManager", "GroupByPreset", "By Preset"))
+							+ SSegmentedControl<ETextureGrouping>::Slot(ETextureGrouping::ByFolder)
+							.Text(NSLOCTEXT("TextureManager", "GroupByFolder", "By Folder"))
+							+ SSegmentedControl<ETextureGrouping>::Slot(ETextureGrouping::Duplicates)
+							.Text(NSLOCTEXT("TextureManager", "GroupDuplicates", "Duplicates"))
+					]
+
+				// Duplicates: hash, status, consolidate
+				+ SVerticalBox::Slot()
+					.AutoHeight()
+					.Padding(2)
+					[
+						SNew(SHorizontalBox)
+							.Visibility(this, &SMyTwoColumnWidget::GetDuplicatesVisibility)
+							+ SHorizontalBox::Slot()
+							.FillWidth(1.f)
+							.VAlign(VAlign_Center)
+							[
+								SNew(STextBlock)
+									.Text(this, &SMyTwoColumnWidget::GetDuplicatesStatusText)
+									.AutoWrapText(true)
+							]
+							+ SHorizontalBox::Slot()
+							.AutoWidth()
+							.Padding(4.f, 0.f)
+							[
+								SNew(SButton)
+									.Text(NSLOCTEXT("TextureManager", "FindDuplicates", "Find Duplicates"))
+									.ToolTipText(NSLOCTEXT("TextureManager", "FindDuplicatesTip", "Hash the source pixels of every texture that has no cached hash yet"))
+									.OnClicked(this, &SMyTwoColumnWidget::OnFindDuplicatesClicked)
+									.IsEnabled_Lambda([this]()
+										{
+											return !bDuplicateHashingRunning;
+										})
+							]
+							+ SHorizontalBox::Slot()
+							.AutoWidth()
+							[
+								SNew(SButton)
+									.Text(NSLOCTEXT("TextureManager", "Consolidate", "Consolidate"))
+									.ToolTipText(NSLOCTEXT("TextureManager", "ConsolidateTip", "Replace the copies in the selected groups (or all groups) with the first texture of each group"))
+									.OnClicked(this, &SMyTwoColumnWidget::OnConsolidateDuplicatesClicked)
+									.IsEnabled_Lambda([this]()
+										{
+											return !bDuplicateHashingRunning && DuplicateClusters.Num() > 0;
+										})
+							]
+					]
+
 				// Presets Save
 				+ SVerticalBox::Slot()
 					.AutoHeight()
 					.Padding(2)
 					.HAlign(HAlign_Center)
 					[
-						SNew(SButton)
-							.Text(NSLOCTEXT("TextureManager", "NewButton", "Make New Preset"))
-							.OnClicked(this, &SMyTwoColumnWidget::OnPresetNewButtonClicked)
+						SNew(SHorizontalBox)
 							.Visibility_Lambda([this]()
 								{
 									return (ActiveTab != ENavigationTab::Files)
 										? EVisibility::Visible
 										: EVisibility::Collapsed;
 								})
+							+ SHorizontalBox::Slot()
+							.AutoWidth()
+							[
+								SNew(SButton)
+									.Text(NSLOCTEXT("TextureManager", "NewButton", "Make New Preset"))
+									.OnClicked(this, &SMyTwoColumnWidget::OnPresetNewButtonClicked)
+							]
+							+ SHorizontalBox::Slot()
+							.AutoWidth()
+							.Padding(4.f, 0.f, 0.f, 0.f)
+							[
+								SNew(SButton)
+									.Text(NSLOCTEXT("TextureManager", "MergePresets", "Merge Duplicates"))
+									.ToolTipText(NSLOCTEXT("TextureManager", "MergePresetsTip", "Merge presets with identical settings into one and relink their textures"))
+									.OnClicked(this, &SMyTwoColumnWidget::OnMergePresetsClicked)
+							]
 					]
 
 				// Body switched by tab: Files list / Presets list
@@ -310,10 +374,22 @@ TSharedRef<SWidget> SMyTwoColumnWidget::BuildLeftColumn()
 								return (ActiveTab == ENavigationTab::Files) ? 0 : 1;
 							})
 
-						// Files list
+						// Files list / grouped tree
 						+ SWidgetSwitcher::Slot()
 						[
-							BuildFilesList()
+							SNew(SWidgetSwitcher)
+								.WidgetIndex_Lambda([this]()
+									{
+										return (Grouping == ETextureGrouping::Flat) ? 0 : 1;
+									})
+								+ SWidgetSwitcher::Slot()
+								[
+									BuildFilesList()
+								]
+								+ SWidgetSwitcher::Slot()
+								[
+									BuildTextureTree()
+								]
 						]
 
 						// Presets list
@@ -331,11 +407,25 @@ TSharedRef<SWidget> SMyTwoColumnWidget::BuildFilesList()
 		.ListItemsSource(&FilteredTextureItems)
 		.SelectionMode(ESelectionMode::Multi)
 		.OnGenerateRow(this, &SMyTwoColumnWidget::GenerateTextureRow)
+		.OnRowReleased(this, &SMyTwoColumnWidget::OnTextureRowReleased)
 		.OnSelectionChanged(this, &SMyTwoColumnWidget::OnTextureSelected);
 
 	return TextureListView.ToSharedRef();
 }
 
+TSharedRef<SWidget> SMyTwoColumnWidget::BuildTextureTree()
+{
+	SAssignNew(TextureTreeView, STreeView<FTextureTreeItem>)
+		.TreeItemsSource(&TextureTreeRoots)
+		.SelectionMode(ESelectionMode::Multi)
+		.OnGenerateRow(this, &SMyTwoColumnWidget::GenerateTreeRow)
+		.OnGetChildren(this, &SMyTwoColumnWidget::OnGetTreeChildren)
+		.OnRowReleased(this, &SMyTwoColumnWidget::OnTextureRowReleased)
+		.OnSelectionChanged(this, &SMyTwoColumnWidget::OnTreeSelectionChanged);
+
+	return TextureTreeView.ToSharedRef();
+}
+
 TSharedRef<SWidget> SMyTwoColumnWidget::BuildPresetsList()
 {
 	SAssignNew(PresetListView, SListView<FPresetItem>)
@@ -401,67 +491,1497 @@ TSharedRef<SWidget> SMyTwoColumnWidget::BuildRightColumn()
 												return bPendingPresetChange || bPendingPropertyChange;
 											})
 
-								]
+								]
+
+								// Presets Save
+								+ SWidgetSwitcher::Slot()
+								[
+									SNew(SButton)
+										.Text(NSLOCTEXT("TextureManager", "SaveButton", "Save"))
+										.OnClicked(this, &SMyTwoColumnWidget::OnPresetSaveButtonClicked)
+								]
+						]
+				]
+
+				// Alpha usage of the selected texture
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(0.f, 2.f)
+				[
+					SNew(SHorizontalBox)
+						.Visibility(this, &SMyTwoColumnWidget::IsFilesChosen)
+						+ SHorizontalBox::Slot()
+						.FillWidth(1.f)
+						.VAlign(VAlign_Center)
+						[
+							SNew(STextBlock)
+								.Text(this, &SMyTwoColumnWidget::GetAlphaStatusText)
+								.AutoWrapText(true)
+						]
+						+ SHorizontalBox::Slot()
+						.AutoWidth()
+						.Padding(4.f, 0.f)
+						[
+							SNew(SButton)
+								.Text(NSLOCTEXT("TextureManager", "UseAlphaSuggestion", "Use Suggested Preset"))
+								.OnClicked(this, &SMyTwoColumnWidget::OnApplyAlphaSuggestionClicked)
+								.Visibility(this, &SMyTwoColumnWidget::GetAlphaSuggestionVisibility)
+						]
+						+ SHorizontalBox::Slot()
+						.AutoWidth()
+						[
+							SNew(SButton)
+								.Text(NSLOCTEXT("TextureManager", "AnalyzeAlpha", "Analyze Alpha"))
+								.ToolTipText(NSLOCTEXT("TextureManager", "AnalyzeAlphaTip", "Scan the source pixels of the selected textures (or the whole list) for unused alpha"))
+								.OnClicked(this, &SMyTwoColumnWidget::OnAnalyzeAlphaClicked)
+								.IsEnabled_Lambda([this]()
+									{
+										return !bAlphaAnalysisRunning;
+									})
+						]
+				]
+
+				// Content based suggestions, only while the <NONE> filter is active
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(0.f, 2.f)
+				[
+					SNew(SHorizontalBox)
+						.Visibility(this, &SMyTwoColumnWidget::GetContentSuggestionVisibility)
+						+ SHorizontalBox::Slot()
+						.FillWidth(1.f)
+						.VAlign(VAlign_Center)
+						[
+							SNew(STextBlock)
+								.Text(this, &SMyTwoColumnWidget::GetContentStatusText)
+								.AutoWrapText(true)
+						]
+						+ SHorizontalBox::Slot()
+						.AutoWidth()
+						.Padding(4.f, 0.f)
+						[
+							SNew(SButton)
+								.Text(NSLOCTEXT("TextureManager", "SuggestPresets", "Suggest Presets"))
+								.ToolTipText(NSLOCTEXT("TextureManager", "SuggestPresetsTip", "Look at the pixels of every unassigned texture and pick the closest existing preset"))
+								.OnClicked(this, &SMyTwoColumnWidget::OnSuggestPresetsClicked)
+								.IsEnabled_Lambda([this]()
+									{
+										return !bContentAnalysisRunning;
+									})
+						]
+						+ SHorizontalBox::Slot()
+						.AutoWidth()
+						[
+							SNew(SButton)
+								.Text(NSLOCTEXT("TextureManager", "ApplySuggestions", "Apply Suggestions"))
+								.OnClicked(this, &SMyTwoColumnWidget::OnApplySuggestionsClicked)
+								.IsEnabled_Lambda([this]()
+									{
+										return !bContentAnalysisRunning;
+									})
+						]
+				]
+
+				// Presets proposed from the settings unassigned textures already share
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(0.f, 2.f)
+				[
+					SNew(SHorizontalBox)
+						.Visibility(this, &SMyTwoColumnWidget::GetContentSuggestionVisibility)
+						+ SHorizontalBox::Slot()
+						.FillWidth(1.f)
+						.VAlign(VAlign_Center)
+						[
+							SNew(STextBlock)
+								.Text(this, &SMyTwoColumnWidget::GetClusteringStatusText)
+								.AutoWrapText(true)
+						]
+						+ SHorizontalBox::Slot()
+						.AutoWidth()
+						.Padding(4.f, 0.f)
+						[
+							SNew(SButton)
+								.Text(NSLOCTEXT("TextureManager", "ClusterSettings", "Group By Settings"))
+								.ToolTipText(NSLOCTEXT("TextureManager", "ClusterSettingsTip", "Group every unassigned texture by identical or near-identical settings and propose one preset per group"))
+								.OnClicked(this, &SMyTwoColumnWidget::OnClusterSettingsClicked)
+						]
+						+ SHorizontalBox::Slot()
+						.AutoWidth()
+						[
+							SNew(SButton)
+								.Text(NSLOCTEXT("TextureManager", "AssignClusters", "Create and Assign"))
+								.OnClicked(this, &SMyTwoColumnWidget::OnAssignClustersClicked)
+								.IsEnabled_Lambda([this]()
+									{
+										return SettingsClusters.Clusters.Num() > 0;
+									})
+						]
+				]
+
+				// Compression optimizer for the selected textures
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(0.f, 2.f)
+				[
+					SNew(SHorizontalBox)
+						.Visibility(this, &SMyTwoColumnWidget::IsFilesChosen)
+						+ SHorizontalBox::Slot()
+						.FillWidth(1.f)
+						.VAlign(VAlign_Center)
+						[
+							SNew(STextBlock)
+								.Text(this, &SMyTwoColumnWidget::GetOptimizerStatusText)
+								.AutoWrapText(true)
+						]
+						+ SHorizontalBox::Slot()
+						.AutoWidth()
+						[
+							SNew(SButton)
+								.Text(NSLOCTEXT("TextureManager", "OptimizeCompression", "Optimize Compression"))
+								.ToolTipText(NSLOCTEXT("TextureManager", "OptimizeCompressionTip", "Try compression, max size and LOD bias combinations on the selected textures and keep the smallest that still looks like the source"))
+								.OnClicked(this, &SMyTwoColumnWidget::OnOptimizeCompressionClicked)
+								.IsEnabled_Lambda([this]()
+									{
+										return !bOptimizerRunning;
+									})
+						]
+				]
+
+				// Estimated memory of the selected preset's textures
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(0.f, 2.f)
+				[
+					SNew(SHorizontalBox)
+						.Visibility(this, &SMyTwoColumnWidget::IsPresetsChosen)
+						+ SHorizontalBox::Slot()
+						.FillWidth(1.f)
+						.VAlign(VAlign_Center)
+						[
+							SNew(STextBlock)
+								.Text(this, &SMyTwoColumnWidget::GetPresetMemoryText)
+								.ToolTipText(NSLOCTEXT("TextureManager", "PresetMemoryTip", "Estimated from source size and preset settings; no derived data is built"))
+								.AutoWrapText(true)
+						]
+						+ SHorizontalBox::Slot()
+						.AutoWidth()
+						.Padding(4.f, 0.f, 0.f, 0.f)
+						[
+							SNew(SButton)
+								.Text(NSLOCTEXT("TextureManager", "ResidencyReport", "Residency Report"))
+								.ToolTipText(NSLOCTEXT("TextureManager", "ResidencyReportTip", "Always-resident memory per preset and texture group, compared with the streaming pool"))
+								.OnClicked_Lambda([]()
+									{
+										STextureResidencyReport::OpenWindow();
+										return FReply::Handled();
+									})
+						]
+				]
+
+				// Texture rebuilds still queued or running
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(0.f, 2.f)
+				[
+					SNew(SHorizontalBox)
+						.Visibility_Lambda([]()
+							{
+								return TextureRebuildScheduler::GetState().IsIdle() ? EVisibility::Collapsed : EVisibility::Visible;
+							})
+						+ SHorizontalBox::Slot()
+						.FillWidth(1.f)
+						.VAlign(VAlign_Center)
+						[
+							SNew(STextBlock)
+								.Text(this, &SMyTwoColumnWidget::GetRebuildStatusText)
+								.ToolTipText(NSLOCTEXT("TextureManager", "RebuildStatusTip", "Rebuilds run a few at a time within the memory budget (Project Settings > Texture Manager); visible and selected textures go first"))
+						]
+						+ SHorizontalBox::Slot()
+						.AutoWidth()
+						.Padding(4.f, 0.f, 0.f, 0.f)
+						[
+							SNew(SButton)
+								.Text_Lambda([]()
+									{
+										return TextureRebuildScheduler::GetState().bPaused
+											? NSLOCTEXT("TextureManager", "ResumeRebuilds", "Resume")
+											: NSLOCTEXT("TextureManager", "PauseRebuilds", "Pause");
+									})
+								.OnClicked_Lambda([]()
+									{
+										if (TextureRebuildScheduler::GetState().bPaused)
+										{
+											TextureRebuildScheduler::Resume();
+										}
+										else
+										{
+											TextureRebuildScheduler::Pause();
+										}
+										return FReply::Handled();
+									})
+						]
+						+ SHorizontalBox::Slot()
+						.AutoWidth()
+						.Padding(4.f, 0.f, 0.f, 0.f)
+						[
+							SNew(SButton)
+								.Text(NSLOCTEXT("TextureManager", "CancelRebuilds", "Cancel"))
+								.ToolTipText(NSLOCTEXT("TextureManager", "CancelRebuildsTip", "Drop the queued rebuilds; those textures keep their old settings. Running ones finish."))
+								.OnClicked_Lambda([]()
+									{
+										TextureRebuildScheduler::Cancel();
+										return FReply::Handled();
+									})
+						]
+				]
+
+				// Single DetailsView (behavior controlled by ActiveTab + selection)
+				+ SVerticalBox::Slot()
+				.FillHeight(1.f)
+				.Padding(0.f, 4.f)
+				[
+					DetailsView.ToSharedRef()
+				]
+		];
+}
+
+// ---------- Row generators ----------
+
+TSharedRef<ITableRow> SMyTwoColumnWidget::GenerateTextureRow(FTextureItem Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	const float ThumbnailSize = ThumbnailCache.IsValid() ? ThumbnailCache->GetThumbnailSize() * 0.5f : 32.f;
+
+	TSharedRef<STableRow<FTextureItem>> Row =
+		SNew(STableRow<FTextureItem>, OwnerTable)
+		[
+			SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(0.f, 1.f, 4.f, 1.f)
+				[
+					SNew(SBox)
+						.WidthOverride(ThumbnailSize)
+						.HeightOverride(ThumbnailSize)
+						[
+							// Only rows that are actually drawn ask for a thumbnail
+							SNew(SImage)
+								.Image_Lambda([this, Item]() -> const FSlateBrush*
+									{
+										return ThumbnailCache.IsValid() ? ThumbnailCache->GetThumbnail(Item.Get()) : nullptr;
+									})
+						]
+				]
+				+ SHorizontalBox::Slot()
+				.FillWidth(1.f)
+				.VAlign(VAlign_Center)
+				[
+					SNew(STextBlock).Text(this, &SMyTwoColumnWidget::GetTextureRowLabel, Item)
+				]
+		];
+
+	if (Item.IsValid())
+	{
+		ThumbnailRowPackages.Add(&Row.Get(), Item->GetOutermost()->GetFName());
+	}
+
+	return Row;
+}
+
+FText SMyTwoColumnWidget::GetTextureRowLabel(FTextureItem Item) const
+{
+	if (!Item.IsValid())
+	{
+		return FText::FromString(TEXT("<invalid>"));
+	}
+
+	// Unassigned textures show what the content analysis would pick
+	if (UTexturePresetAsset* Suggested = GetSuggestedPreset(Item.Get()))
+	{
+		return FText::Format(
+			NSLOCTEXT("TextureManager", "RowSuggestion", "{0}  -> {1} ({2})"),
+			FText::FromString(Item->GetName()),
+			FText::FromString(Suggested->PresetName.IsNone() ? Suggested->GetName() : Suggested->PresetName.ToString()),
+			TextureAnalysisLibrary::ContentKindToText(TextureAnalysisLibrary::FindContentInfo(Item.Get()).Kind));
+	}
+
+	// Flag textures that pay for an alpha channel they don't use
+	const FTextureAlphaInfo Alpha = TextureAnalysisLibrary::FindAlphaUsage(Item.Get());
+	if (Alpha.IsRemovable() && TextureAnalysisLibrary::EstimateAlphaSavings(Item.Get()) > 0)
+	{
+		return FText::Format(
+			NSLOCTEXT("TextureManager", "RowUnusedAlpha", "{0}  [unused alpha]"),
+			FText::FromString(Item->GetName()));
+	}
+
+	return FText::FromString(Item->GetName());
+}
+
+void SMyTwoColumnWidget::OnTextureRowReleased(const TSharedRef<ITableRow>& Row)
+{
+	FName PackageName;
+	if (ThumbnailRowPackages.RemoveAndCopyValue(&Row.Get(), PackageName) && ThumbnailCache.IsValid())
+	{
+		ThumbnailCache->CancelRequest(PackageName);
+	}
+}
+
+TSharedRef<ITableRow> SMyTwoColumnWidget::GeneratePresetRow(FPresetItem Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	FText Label = FText::FromString(TEXT("<Preset>"));
+
+	if (Item.IsValid())
+	{
+		const UTexturePresetAsset* Preset = Item.Get();
+		if (Preset)
+		{
+			if (!Preset->PresetName.IsNone())
+			{
+				Label = FText::FromName(Preset->PresetName);
+			}
+			else
+			{
+				Label = FText::FromString(Preset->GetName());
+			}
+		}
+	}
+
+	return
+		SNew(STableRow<FPresetItem>, OwnerTable)
+		[
+			SNew(STextBlock).Text(Label)
+		];
+}
+
+TSharedRef<ITableRow> SMyTwoColumnWidget::GenerateTreeRow(FTextureTreeItem Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	FText Label = FText::FromString(TEXT("<invalid>"));
+
+	if (Item.IsValid())
+	{
+		if (Item->bIsGroup)
+		{
+			Label = (Item->ClusterIndex != INDEX_NONE)
+				? FText::Format(
+					NSLOCTEXT("TextureManager", "TreeClusterLabel", "{0}  ({1} copies, {2} wasted)"),
+					FText::FromString(Item->Label),
+					FText::AsNumber(Item->NumTextures),
+					FText::AsMemory(Item->WastedBytes))
+				: FText::Format(
+					NSLOCTEXT("TextureManager", "TreeGroupLabel", "{0}  ({1} textures, {2})"),
+					FText::FromString(Item->Label),
+					FText::AsNumber(Item->NumTextures),
+					FText::AsMemory(Item->MemoryBytes));
+		}
+		else
+		{
+			Label = FText::FromString(Item->Label);
+		}
+	}
+
+	if (!Item.IsValid() || Item->bIsGroup)
+	{
+		return
+			SNew(STableRow<FTextureTreeItem>, OwnerTable)
+			[
+				SNew(STextBlock).Text(Label)
+			];
+	}
+
+	const float ThumbnailSize = ThumbnailCache.IsValid() ? ThumbnailCache->GetThumbnailSize() * 0.5f : 32.f;
+	const FAssetData Asset = Item->Asset;
+
+	TSharedRef<STableRow<FTextureTreeItem>> Row =
+		SNew(STableRow<FTextureTreeItem>, OwnerTable)
+		[
+			SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(0.f, 1.f, 4.f, 1.f)
+				[
+					SNew(SBox)
+						.WidthOverride(ThumbnailSize)
+						.HeightOverride(ThumbnailSize)
+						[
+							SNew(SImage)
+								.Image_Lambda([this, Asset]() -> const FSlateBrush*
+									{
+										return ThumbnailCache.IsValid() ? ThumbnailCache->GetThumbnail(Asset) : nullptr;
+									})
+						]
+				]
+				+ SHorizontalBox::Slot()
+				.FillWidth(1.f)
+				.VAlign(VAlign_Center)
+				[
+					SNew(STextBlock).Text(Label)
+				]
+		];
+
+	ThumbnailRowPackages.Add(&Row.Get(), Asset.PackageName);
+
+	return Row;
+}
+
+// ---------- Grouped tree ----------
+
+void SMyTwoColumnWidget::OnGroupingChanged(ETextureGrouping NewGrouping)
+{
+	Grouping = NewGrouping;
+	if (Grouping == ETextureGrouping::Flat)
+	{
+		EnsureTextureItemsLoaded();
+	}
+	RebuildTextureTree();
+}
+
+int64 SMyTwoColumnWidget::GetAssetMemoryBytes(const FAssetData& Asset) const
+{
+	// Only ask textures that are already in memory; never load one just to size it
+	const UTexture2D* Texture = Cast<UTexture2D>(Asset.FastGetAsset(false));
+#if WITH_EDITORONLY_DATA
+	const FGuid SourceId = Texture ? Texture->Source.GetId() : FGuid();
+#else
+	const FGuid SourceId;
+#endif
+
+	// Typing in the search box rebuilds the tree; the textures did not change
+	const FCachedMemoryEstimate* Cached = MemoryEstimates.Find(Asset.PackageName);
+	if (Cached && Cached->SourceId == SourceId)
+	{
+		return Cached->Bytes;
+	}
+
+	const int64 Bytes = TextureMemoryEstimator::EstimateAsset(Asset).GetTotalBytes();
+	MemoryEstimates.Add(Asset.PackageName, { SourceId, Bytes });
+	return Bytes;
+}
+
+SMyTwoColumnWidget::FTextureTreeItem SMyTwoColumnWidget::MakeGroupNode(const FString& Label, TArray<FAssetData>&& Assets) const
+{
+	FTextureTreeItem Node = MakeShared<FTextureTreeNode>();
+	Node->Label = Label;
+	Node->bIsGroup = true;
+	Node->NumTextures = Assets.Num();
+
+	for (const FAssetData& Asset : Assets)
+	{
+		Node->MemoryBytes += GetAssetMemoryBytes(Asset);
+	}
+
+	Node->PendingAssets = MoveTemp(Assets);
+	return Node;
+}
+
+void SMyTwoColumnWidget::RebuildTextureTree()
+{
+	TEXTURE_MANAGER_SCOPE("RebuildTextureTree");
+	TextureTreeRoots.Reset();
+	DuplicateClusters.Reset();
+
+	if (Grouping == ETextureGrouping::Flat)
+	{
+		if (TextureTreeView.IsValid())
+		{
+			TextureTreeView->RequestTreeRefresh();
+		}
+		return;
+	}
+
+	// Respect the Files search box, the same way the flat list does
+	TArray<FAssetData> Assets;
+	Assets.Reserve(AllTextureAssets.Num());
+	for (const FAssetData& Asset : AllTextureAssets)
+	{
+		if (FilesSearchQuery.IsEmpty() || Asset.AssetName.ToString().Contains(FilesSearchQuery))
+		{
+			Assets.Add(Asset);
+		}
+	}
+
+	if (Grouping == ETextureGrouping::ByPreset)
+	{
+		// FilterPresetChoices: 0 = All, 1 = <NONE>, 2.. = real presets
+		TMap<FSoftObjectPath, int32> PresetIndexByTexture;
+		for (int32 Index = 2; Index < FilterPresetChoices.Num(); ++Index)
+		{
+			if (const UTexturePresetAsset* Preset = FilterPresetChoices[Index].Get())
+			{
+				for (const UTexture2D* Texture : Preset->Files)
+				{
+					if (Texture)
+					{
+						PresetIndexByTexture.Add(FSoftObjectPath(Texture), Index);
+					}
+				}
+			}
+		}
+
+		TArray<TArray<FAssetData>> Buckets;
+		Buckets.SetNum(FilterPresetChoices.Num());
+
+		for (const FAssetData& Asset : Assets)
+		{
+			const int32* Found = PresetIndexByTexture.Find(Asset.GetSoftObjectPath());
+			Buckets[Found ? *Found : 1].Add(Asset);
+		}
+
+		for (int32 Index = 1; Index < Buckets.Num(); ++Index)
+		{
+			if (Buckets[Index].Num() > 0 && FilterPresetLabels.IsValidIndex(Index))
+			{
+				TextureTreeRoots.Add(MakeGroupNode(*FilterPresetLabels[Index], MoveTemp(Buckets[Index])));
+			}
+		}
+	}
+	else if (Grouping == ETextureGrouping::Duplicates)
+	{
+		// Only textures that were hashed take part; see OnFindDuplicatesClicked
+		DuplicateClusters = TextureDuplicateFinder::FindClusters(Assets);
+
+		for (int32 Index = 0; Index < DuplicateClusters.Num(); ++Index)
+		{
+			const FTextureDuplicateCluster& Cluster = DuplicateClusters[Index];
+			const FString Label = FString::Printf(TEXT("%s%s"),
+				*Cluster.Assets[0].AssetName.ToString(),
+				!Cluster.bExact ? TEXT(" (similar)") : !Cluster.bSameBuildSettings ? TEXT(" (different settings)") : TEXT(""));
+
+			FTextureTreeItem Node = MakeGroupNode(Label, TArray<FAssetData>(Cluster.Assets));
+			Node->ClusterIndex = Index;
+			Node->WastedBytes = Cluster.WastedBytes;
+			TextureTreeRoots.Add(Node);
+		}
+	}
+	else // ByFolder
+	{
+		// One root per mount point (/Game, /TextureManager, ...); deeper folders
+		// are split off when a node is expanded
+		TMap<FString, TArray<FAssetData>> ByRoot;
+		for (const FAssetData& Asset : Assets)
+		{
+			const FString Path = Asset.PackagePath.ToString();
+			const int32 SecondSlash = Path.Find(TEXT("/"), ESearchCase::CaseSensitive, ESearchDir::FromStart, 1);
+			ByRoot.FindOrAdd(SecondSlash == INDEX_NONE ? Path : Path.Left(SecondSlash)).Add(Asset);
+		}
+
+		ByRoot.KeySort(TLess<FString>());
+		for (TPair<FString, TArray<FAssetData>>& Pair : ByRoot)
+		{
+			FTextureTreeItem Node = MakeGroupNode(Pair.Key, MoveTemp(Pair.Value));
+			Node->bFolderGroup = true;
+			Node->FolderPath = Pair.Key;
+			TextureTreeRoots.Add(Node);
+		}
+	}
+
+	if (TextureTreeView.IsValid())
+	{
+		TextureTreeView->RequestTreeRefresh();
+	}
+}
+
+void SMyTwoColumnWidget::MaterializeChildren(const FTextureTreeItem& Node) const
+{
+	TEXTURE_MANAGER_SCOPE("MaterializeChildren");
+	if (!Node.IsValid() || !Node->bIsGroup || Node->bChildrenMaterialized)
+	{
+		return;
+	}
+
+	Node->bChildrenMaterialized = true;
+
+	TArray<FAssetData> Leaves;
+
+	if (Node->bFolderGroup)
+	{
+		// Textures directly in this folder become leaves, the rest are grouped
+		// by the next path segment
+		TMap<FString, TArray<FAssetData>> SubFolders;
+		const FString Prefix = Node->FolderPath + TEXT("/");
+
+		for (FAssetData& Asset : Node->PendingAssets)
+		{
+			const FString Path = Asset.PackagePath.ToString();
+			if (Path == Node->FolderPath || !Path.StartsWith(Prefix))
+			{
+				Leaves.Add(MoveTemp(Asset));
+				continue;
+			}
+
+			FString Segment = Path.Mid(Prefix.Len());
+			int32 Slash = INDEX_NONE;
+			if (Segment.FindChar(TEXT('/'), Slash))
+			{
+				Segment.LeftInline(Slash);
+			}
+			SubFolders.FindOrAdd(Segment).Add(MoveTemp(Asset));
+		}
+
+		SubFolders.KeySort(TLess<FString>());
+		for (TPair<FString, TArray<FAssetData>>& Pair : SubFolders)
+		{
+			FTextureTreeItem Child = MakeGroupNode(Pair.Key, MoveTemp(Pair.Value));
+			Child->bFolderGroup = true;
+			Child->FolderPath = Prefix + Pair.Key;
+			Node->Children.Add(Child);
+		}
+	}
+	else
+	{
+		Leaves = MoveTemp(Node->PendingAssets);
+	}
+
+	Leaves.Sort([](const FAssetData& A, const FAssetData& B)
+		{
+			return A.AssetName.LexicalLess(B.AssetName);
+		});
+
+	for (FAssetData& Asset : Leaves)
+	{
+		FTextureTreeItem Leaf = MakeShared<FTextureTreeNode>();
+		Leaf->Label = Asset.AssetName.ToString();
+		Leaf->Asset = MoveTemp(Asset);
+		Leaf->NumTextures = 1;
+		Node->Children.Add(Leaf);
+	}
+
+	Node->PendingAssets.Empty();
+}
+
+void SMyTwoColumnWidget::OnGetTreeChildren(FTextureTreeItem Item, TArray<FTextureTreeItem>& OutChildren)
+{
+	if (!Item.IsValid() || !Item->bIsGroup)
+	{
+		return;
+	}
+
+	// Collapsed groups hand back a single shared placeholder so the expander
+	// arrow shows up without building any real rows
+	if (!Item->bChildrenMaterialized && TextureTreeView.IsValid() && !TextureTreeView->IsItemExpanded(Item))
+	{
+		if (Item->NumTextures > 0)
+		{
+			if (CollapsedPlaceholder.Num() == 0)
+			{
+				CollapsedPlaceholder.Add(MakeShared<FTextureTreeNode>());
+			}
+			OutChildren = CollapsedPlaceholder;
+		}
+		return;
+	}
+
+	MaterializeChildren(Item);
+	OutChildren = Item->Children;
+}
+
+void SMyTwoColumnWidget::OnTreeSelectionChanged(FTextureTreeItem Item, ESelectInfo::Type SelectInfo)
+{
+	if (!TextureTreeView.IsValid() || !TextureListView.IsValid())
+	{
+		return;
+	}
+
+	// The flat list stays the single source of truth for the selection, so the
+	// combo, Save and SaveFiles keep working unchanged in tree mode
+	TArray<FTextureTreeItem> SelectedNodes;
+	TextureTreeView->GetSelectedItems(SelectedNodes);
+
+	TArray<FTextureItem> Textures;
+	for (const FTextureTreeItem& Node : SelectedNodes)
+	{
+		if (Node.IsValid() && !Node->bIsGroup && Node->Asset.IsValid())
+		{
+			if (UTexture2D* Texture = Cast<UTexture2D>(Node->Asset.GetAsset()))
+			{
+				Textures.Add(Texture);
+			}
+		}
+	}
+
+	if (Textures.Num() == 0)
+	{
+		return;
+	}
+
+	TextureListView->ClearSelection();
+	for (int32 Index = 0; Index < Textures.Num() - 1; ++Index)
+	{
+		TextureListView->SetItemSelection(Textures[Index], true, ESelectInfo::Direct);
+	}
+
+	// The last one drives OnTextureSelected, exactly like a click in the list
+	TextureListView->SetItemSelection(Textures.Last(), true, ESelectInfo::OnMouseClick);
+}
+
+// ---------- Duplicates ----------
+
+EVisibility SMyTwoColumnWidget::GetDuplicatesVisibility() const
+{
+	return (ActiveTab == ENavigationTab::Files && Grouping == ETextureGrouping::Duplicates)
+		? EVisibility::Visible
+		: EVisibility::Collapsed;
+}
+
+FText SMyTwoColumnWidget::GetDuplicatesStatusText() const
+{
+	if (bDuplicateHashingRunning)
+	{
+		return NSLOCTEXT("TextureManager", "DuplicatesRunning", "Hashing textures...");
+	}
+
+	int64 WastedBytes = 0;
+	for (const FTextureDuplicateCluster& Cluster : DuplicateClusters)
+	{
+		WastedBytes += Cluster.WastedBytes;
+	}
+
+	return FText::Format(
+		NSLOCTEXT("TextureManager", "DuplicatesStatus", "{0} groups, {1} wasted"),
+		FText::AsNumber(DuplicateClusters.Num()),
+		FText::AsMemory(WastedBytes));
+}
+
+FReply SMyTwoColumnWidget::OnFindDuplicatesClicked()
+{
+	EnsureTextureItemsLoaded();
+
+	TArray<UTexture2D*> Textures;
+	for (const FTextureItem& Item : AllTextureItems)
+	{
+		if (Item.IsValid())
+		{
+			Textures.Add(Item.Get());
+		}
+	}
+
+	bDuplicateHashingRunning = true;
+
+	TWeakPtr<SMyTwoColumnWidget> WeakThis = SharedThis(this);
+	TextureDuplicateFinder::ComputeHashesAsync(Textures, [WeakThis]()
+		{
+			if (TSharedPtr<SMyTwoColumnWidget> This = WeakThis.Pin())
+			{
+				This->bDuplicateHashingRunning = false;
+				This->RebuildTextureTree();
+			}
+		});
+
+	return FReply::Handled();
+}
+
+FReply SMyTwoColumnWidget::OnConsolidateDuplicatesClicked()
+{
+	// Selected groups, or every interchangeable group when none is selected
+	TArray<int32> Selected;
+	if (TextureTreeView.IsValid())
+	{
+		for (const FTextureTreeItem& Item : TextureTreeView->GetSelectedItems())
+		{
+			if (Item.IsValid() && DuplicateClusters.IsValidIndex(Item->ClusterIndex))
+			{
+				Selected.AddUnique(Item->ClusterIndex);
+			}
+		}
+	}
+
+	TArray<int32> ClusterIndices;
+	for (int32 Index = 0; Index < DuplicateClusters.Num(); ++Index)
+	{
+		if (DuplicateClusters[Index].IsInterchangeable() && (Selected.Num() == 0 || Selected.Contains(Index)))
+		{
+			ClusterIndices.Add(Index);
+		}
+	}
+
+	int32 NumCopies = 0;
+	int64 WastedBytes = 0;
+	for (int32 Index : ClusterIndices)
+	{
+		NumCopies += DuplicateClusters[Index].Assets.Num() - 1;
+		WastedBytes += DuplicateClusters[Index].WastedBytes;
+	}
+
+	if (ClusterIndices.Num() > 0)
+	{
+		const FString Msg = FString::Printf(
+			TEXT("Replace %d identical textures in %d groups with their first texture and delete them (%s)?"),
+			NumCopies,
+			ClusterIndices.Num(),
+			*FText::AsMemory(WastedBytes).ToString());
+
+		if (FMessageDialog::Open(EAppMsgType::YesNo, FText::FromString(Msg)) != EAppReturnType::Yes)
+		{
+			ClusterIndices.Reset();
+		}
+	}
+
+	// Similar pixels or different build settings: never in bulk, each selected
+	// group is confirmed on its own
+	for (int32 Index : Selected)
+	{
+		const FTextureDuplicateCluster& Cluster = DuplicateClusters[Index];
+		if (Cluster.IsInterchangeable())
+		{
+			continue;
+		}
+
+		const FString Msg = FString::Printf(
+			TEXT("The %d textures of group '%s' %s.\n\nReplace them with '%s' anyway and delete the others (%s)?"),
+			Cluster.Assets.Num(),
+			*Cluster.Assets[0].AssetName.ToString(),
+			Cluster.bExact
+				? TEXT("have identical pixels but differ in compression, sRGB or texture group")
+				: TEXT("only look similar"),
+			*Cluster.Assets[0].AssetName.ToString(),
+			*FText::AsMemory(Cluster.WastedBytes).ToString());
+
+		const EAppReturnType::Type Response = FMessageDialog::Open(EAppMsgType::YesNoCancel, FText::FromString(Msg));
+		if (Response == EAppReturnType::Cancel)
+		{
+			return FReply::Handled();
+		}
+		if (Response == EAppReturnType::Yes)
+		{
+			ClusterIndices.Add(Index);
+		}
+	}
+
+	if (ClusterIndices.Num() == 0)
+	{
+		return FReply::Handled();
+	}
+
+	// Consolidation deletes assets; drop every reference this widget holds first
+	const TArray<FTextureDuplicateCluster> Clusters = DuplicateClusters;
+	SelectedTexture.Reset();
+	PreviewTexture = nullptr;
+	PreviewPreset = nullptr;
+	if (DetailsView.IsValid())
+	{
+		DetailsView->SetObject(nullptr);
+	}
+	// Preset copies list the textures in Files; they must not keep them alive
+	PreviewPool->Reset();
+	AllTextureItems.Reset();
+	bTextureItemsLoaded = false;
+	FilteredTextureItems.Reset();
+	TextureTreeRoots.Reset();
+
+	TArray<FTextureDuplicateCluster> ToConsolidate;
+	for (int32 Index : ClusterIndices)
+	{
+		ToConsolidate.Add(Clusters[Index]);
+	}
+	const int32 NumFailed = TextureDuplicateFinder::ConsolidateClusters(ToConsolidate);
+
+	if (NumFailed > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Consolidate: %d groups could not be fully consolidated"), NumFailed);
+	}
+
+	SaveDirtyTexturesAndPresets();
+	RefreshTextureList();
+	RefreshPresetList();
+
+	return FReply::Handled();
+}
+
+// ---------- Alpha analysis ----------
+
+FText SMyTwoColumnWidget::GetAlphaStatusText() const
+{
+	if (bAlphaAnalysisRunning)
+	{
+		return NSLOCTEXT("TextureManager", "AlphaRunning", "Analyzing alpha...");
+	}
+
+	const UTexture2D* Texture = SelectedTexture.Get();
+	if (!Texture)
+	{
+		return FText::GetEmpty();
+	}
+
+	const FTextureAlphaInfo Alpha = TextureAnalysisLibrary::FindAlphaUsage(Texture);
+	const FText UsageText = TextureAnalysisLibrary::AlphaUsageToText(Alpha);
+
+	const int64 Savings = TextureAnalysisLibrary::EstimateAlphaSavings(Texture);
+	if (!Alpha.IsRemovable() || Savings <= 0)
+	{
+		return UsageText;
+	}
+
+	if (const UTexturePresetAsset* Suggested = AlphaSuggestedPreset.Get())
+	{
+		return FText::Format(
+			NSLOCTEXT("TextureManager", "AlphaSuggestPreset", "{0}: '{1}' has no alpha and would save {2}"),
+			UsageText,
+			FText::FromString(!Suggested->PresetName.IsNone() ? Suggested->PresetName.ToString() : Suggested->GetName()),
+			FText::AsMemory(Savings));
+	}
+
+	return FText::Format(
+		NSLOCTEXT("TextureManager", "AlphaSuggestNone", "{0}: a preset without alpha would save {1}"),
+		UsageText,
+		FText::AsMemory(Savings));
+}
+
+EVisibility SMyTwoColumnWidget::GetAlphaSuggestionVisibility() const
+{
+	const UTexture2D* Texture = SelectedTexture.Get();
+	if (!Texture || !TextureAnalysisLibrary::FindAlphaUsage(Texture).IsRemovable())
+	{
+		return EVisibility::Collapsed;
+	}
+
+	const UTexturePresetAsset* Suggested = AlphaSuggestedPreset.Get();
+
+	return (Suggested && Suggested != SelectedPreset.Get() && TextureAnalysisLibrary::EstimateAlphaSavings(Texture) > 0)
+		? EVisibility::Visible
+		: EVisibility::Collapsed;
+}
+
+FReply SMyTwoColumnWidget::OnAnalyzeAlphaClicked()
+{
+	EnsureTextureItemsLoaded();
+
+	TArray<FTextureItem> Items;
+	if (TextureListView.IsValid())
+	{
+		TextureListView->GetSelectedItems(Items);
+	}
+
+	// Nothing selected: analyze whatever the list currently shows
+	if (Items.Num() == 0)
+	{
+		Items = FilteredTextureItems;
+	}
+
+	TArray<UTexture2D*> Textures;
+	for (const FTextureItem& Item : Items)
+	{
+		if (Item.IsValid())
+		{
+			Textures.Add(Item.Get());
+		}
+	}
+
+	bAlphaAnalysisRunning = true;
+
+	TWeakPtr<SMyTwoColumnWidget> WeakThis = SharedThis(this);
+	TextureAnalysisLibrary::AnalyzeAlphaUsageAsync(Textures, [WeakThis]()
+		{
+			if (TSharedPtr<SMyTwoColumnWidget> This = WeakThis.Pin())
+			{
+				This->bAlphaAnalysisRunning = false;
+				This->UpdateAlphaSuggestion();
+			}
+		});
+
+	return FReply::Handled();
+}
+
+void SMyTwoColumnWidget::UpdateAlphaSuggestion()
+{
+	const UTexture2D* Texture = SelectedTexture.Get();
+	AlphaSuggestedPreset = (Texture && TextureAnalysisLibrary::FindAlphaUsage(Texture).IsRemovable())
+		? TextureAnalysisLibrary::SuggestPresetWithoutAlpha(Texture, FilterPresetChoices)
+		: nullptr;
+}
+
+FReply SMyTwoColumnWidget::OnApplyAlphaSuggestionClicked()
+{
+	UTexturePresetAsset* Suggested = AlphaSuggestedPreset.Get();
+
+	const int32 Index = PresetChoices.IndexOfByKey(Suggested);
+	if (!Suggested || !PresetLabels.IsValidIndex(Index))
+	{
+		return FReply::Handled();
+	}
+
+	// Same path as picking the preset in the combo; Save commits it
+	CurrentPresetOption = PresetLabels[Index];
+	if (PresetComboBox.IsValid())
+	{
+		PresetComboBox->SetSelectedItem(CurrentPresetOption);
+	}
+	OnPresetComboChanged(CurrentPresetOption, ESelectInfo::OnMouseClick);
+
+	return FReply::Handled();
+}
+
+// ---------- Content suggestions ----------
+
+EVisibility SMyTwoColumnWidget::GetContentSuggestionVisibility() const
+{
+	return (ActiveTab == ENavigationTab::Files && CurrentFilterOption.IsValid() && CurrentFilterOption == NonePresetOption)
+		? EVisibility::Visible
+		: EVisibility::Collapsed;
+}
+
+FText SMyTwoColumnWidget::GetContentStatusText() const
+{
+	if (bContentAnalysisRunning)
+	{
+		return NSLOCTEXT("TextureManager", "ContentRunning", "Analyzing textures...");
+	}
+
+	return FText::Format(
+		NSLOCTEXT("TextureManager", "ContentStatus", "{0} of {1} unassigned textures have a suggested preset"),
+		FText::AsNumber(NumSuggestedTextures),
+		FText::AsNumber(FilteredTextureItems.Num()));
+}
+
+void SMyTwoColumnWidget::UpdateContentStatus()
+{
+	TEXTURE_MANAGER_SCOPE("UpdateContentStatus");
+	NumSuggestedTextures = 0;
+	for (const FTextureItem& Item : FilteredTextureItems)
+	{
+		NumSuggestedTextures += GetSuggestedPreset(Item.Get()) ? 1 : 0;
+	}
+
+	// Its candidates are the presets these suggestions are picked from
+	UpdateAlphaSuggestion();
+}
+
+UTexturePresetAsset* SMyTwoColumnWidget::GetSuggestedPreset(const UTexture2D* Texture) const
+{
+	if (!Texture || Texture->GetAssetUserDataOfClass(UTexturePresetUserData::StaticClass()))
+	{
+		return nullptr;
+	}
+
+	const FTextureContentInfo Info = TextureAnalysisLibrary::FindContentInfo(Texture);
+	if (Info.Kind == ETextureContentKind::Unknown)
+	{
+		return nullptr;
+	}
+
+	return TextureAnalysisLibrary::SuggestPresetForContent(Info, FilterPresetChoices);
+}
+
+FReply SMyTwoColumnWidget::OnSuggestPresetsClicked()
+{
+	EnsureTextureItemsLoaded();
+
+	TArray<UTexture2D*> Textures;
+	for (const FTextureItem& Item : FilteredTextureItems)
+	{
+		if (Item.IsValid())
+		{
+			Textures.Add(Item.Get());
+		}
+	}
+
+	bContentAnalysisRunning = true;
+
+	TWeakPtr<SMyTwoColumnWidget> WeakThis = SharedThis(this);
+	TextureAnalysisLibrary::AnalyzeContentAsync(Textures, [WeakThis]()
+		{
+			if (TSharedPtr<SMyTwoColumnWidget> This = WeakThis.Pin())
+			{
+				This->bContentAnalysisRunning = false;
+				This->UpdateContentStatus();
+			}
+		});
+
+	return FReply::Handled();
+}
+
+FReply SMyTwoColumnWidget::OnApplySuggestionsClicked()
+{
+	TArray<TPair<UTexture2D*, UTexturePresetAsset*>> Assignments;
+	for (const FTextureItem& Item : FilteredTextureItems)
+	{
+		if (UTexturePresetAsset* Suggested = GetSuggestedPreset(Item.Get()))
+		{
+			Assignments.Emplace(Item.Get(), Suggested);
+		}
+	}
+
+	if (Assignments.Num() == 0)
+	{
+		return FReply::Handled();
+	}
+
+	const FString Msg = FString::Printf(
+		TEXT("Assign the suggested presets to %d textures?"),
+		Assignments.Num());
+
+	if (FMessageDialog::Open(EAppMsgType::YesNo, FText::FromString(Msg)) != EAppReturnType::Yes)
+	{
+		return FReply::Handled();
+	}
+
+	const FGuid JournalBatch = TextureBulkJournal::BeginBatch(TEXT("Apply suggested presets"));
+	for (const TPair<UTexture2D*, UTexturePresetAsset*>& Assignment : Assignments)
+	{
+		Assignment.Key->Modify();
+		TexturePresetLibrary::AssignPresetToTexture(Assignment.Value, Assignment.Key);
+		TextureRebuildScheduler::Enqueue(Assignment.Value, Assignment.Key, JournalBatch);
+	}
+	bSaveWhenRebuildsDone = true;
+
+	SaveDirtyTexturesAndPresets();
+	RefreshPresetList();
+
+	return FReply::Handled();
+}
+
+// ---------- Settings clustering ----------
+
+FText SMyTwoColumnWidget::GetClusteringStatusText() const
+{
+	if (SettingsClusters.NumTextures == 0)
+	{
+		return FText::GetEmpty();
+	}
+
+	int32 NumNew = 0;
+	for (const FTextureSettingsCluster& Cluster : SettingsClusters.Clusters)
+	{
+		NumNew += Cluster.ExistingPreset.IsValid() ? 0 : 1;
+	}
+
+	return FText::Format(
+		NSLOCTEXT("TextureManager", "ClusteringStatus", "{0} textures in {1} settings groups: {2} presets ({3} new) cover {4}"),
+		FText::AsNumber(SettingsClusters.NumTextures),
+		FText::AsNumber(SettingsClusters.NumGroups),
+		FText::AsNumber(SettingsClusters.Clusters.Num()),
+		FText::AsNumber(NumNew),
+		FText::AsNumber(SettingsClusters.NumClustered));
+}
+
+FReply SMyTwoColumnWidget::OnClusterSettingsClicked()
+{
+	SettingsClusters = TexturePresetClustering::FindClusters(AllTextureAssets, FilterPresetChoices);
+
+	UE_LOG(LogTemp, Log, TEXT("Group By Settings: %d textures, %d groups, %d proposed presets in %.2f s"),
+		SettingsClusters.NumTextures,
+		SettingsClusters.NumGroups,
+		SettingsClusters.Clusters.Num(),
+		SettingsClusters.Seconds);
+
+	return FReply::Handled();
+}
+
+FReply SMyTwoColumnWidget::OnAssignClustersClicked()
+{
+	TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("TextureManager"));
+	if (!Plugin || SettingsClusters.Clusters.Num() == 0)
+	{
+		return FReply::Handled();
+	}
+
+	// Largest groups first; the full list can be thousands of lines
+	constexpr int32 MaxListed = 10;
+	FString List;
+	for (int32 Index = 0; Index < SettingsClusters.Clusters.Num() && Index < MaxListed; ++Index)
+	{
+		const FTextureSettingsCluster& Cluster = SettingsClusters.Clusters[Index];
+		List += FString::Printf(TEXT("  %s: %d textures%s\n"),
+			*Cluster.ProposedName.ToString(),
+			Cluster.Assets.Num(),
+			Cluster.ExistingPreset.IsValid() ? TEXT(" (existing)") : TEXT(""));
+	}
+	if (SettingsClusters.Clusters.Num() > MaxListed)
+	{
+		List += FString::Printf(TEXT("  ... and %d more\n"), SettingsClusters.Clusters.Num() - MaxListed);
+	}
+
+	const FString Msg = FString::Printf(
+		TEXT("Assign presets to %d textures?\n\n%s"),
+		SettingsClusters.NumClustered,
+		*List);
+
+	if (FMessageDialog::Open(EAppMsgType::YesNo, FText::FromString(Msg)) != EAppReturnType::Yes)
+	{
+		return FReply::Handled();
+	}
+
+	const FString DefaultPath = Plugin->GetMountedAssetPath() + "TexturePresets";
+
+	int32 NumSkipped = 0;
+	const int32 NumAssigned = TexturePresetClustering::AssignClusters(
+		SettingsClusters.Clusters, DefaultPath, FTextureClusteringOptions(), NumSkipped);
+
+	UE_LOG(LogTemp, Log, TEXT("Group By Settings: assigned %d textures, skipped %d whose settings did not match"),
+		NumAssigned, NumSkipped);
+
+	SettingsClusters = FTextureClusteringResult();
+
+	bSaveWhenRebuildsDone = true;
+	SaveDirtyTexturesAndPresets();
+	RefreshPresetList();
+
+	return FReply::Handled();
+}
+
+// ---------- Compression optimizer ----------
+
+FReply SMyTwoColumnWidget::OnOptimizeCompressionClicked()
+{
+	TArray<FTextureItem> Items;
+	if (TextureListView.IsValid())
+	{
+		TextureListView->GetSelectedItems(Items);
+	}
+	if (Items.Num() == 0 && SelectedTexture.IsValid())
+	{
+		Items.Add(SelectedTexture);
+	}
+
+	TArray<UTexture2D*> Textures;
+	for (const FTextureItem& Item : Items)
+	{
+		if (Item.IsValid())
+		{
+			Textures.Add(Item.Get());
+		}
+	}
+
+	if (Textures.Num() == 0)
+	{
+		return FReply::Handled();
+	}
+
+	// All linked to the same preset: the preset has to work for every texture
+	// using it, so optimize it as a whole. Otherwise each texture is measured
+	// with its own settings and a new preset takes just the searched fields.
+	UTexturePresetAsset* SharedPreset = nullptr;
+	for (int32 Index = 0; Index < Textures.Num(); ++Index)
+	{
+		const UTexturePresetUserData* UserData = Cast<UTexturePresetUserData>(
+			Textures[Index]->GetAssetUserDataOfClass(UTexturePresetUserData::StaticClass()));
+		UTexturePresetAsset* Preset = UserData ? UserData->AssignedPreset.Get() : nullptr;
+
+		if (Index == 0)
+		{
+			SharedPreset = Preset;
+		}
+		else if (Preset != SharedPreset)
+		{
+			SharedPreset = nullptr;
+			break;
+		}
+	}
+
+	FTexturePresetSettings BaseSettings;
+	if (SharedPreset)
+	{
+		BaseSettings = TexturePresetLibrary::ResolveSettings(SharedPreset);
+		Textures.Reset();
+		for (UTexture2D* Texture : SharedPreset->Files)
+		{
+			if (Texture)
+			{
+				Textures.AddUnique(Texture);
+			}
+		}
+	}
+
+	bOptimizerRunning = true;
+	OptimizerStatus = FText::Format(
+		NSLOCTEXT("TextureManager", "OptimizerRunning", "Optimizing {0} textures..."),
+		FText::AsNumber(Textures.Num()));
+
+	TWeakPtr<SMyTwoColumnWidget> WeakThis = SharedThis(this);
+	TWeakObjectPtr<UTexturePresetAsset> WeakPreset = SharedPreset;
+	TextureCompressionOptimizer::OptimizeAsync(Textures, SharedPreset ? &BaseSettings : nullptr, FTextureOptimizerOptions(),
+		[WeakThis, WeakPreset](const FTextureOptimizerResult& Result)
+		{
+			if (TSharedPtr<SMyTwoColumnWidget> This = WeakThis.Pin())
+			{
+				This->OnOptimizerComplete(Result, WeakPreset.Get());
+			}
+		});
+
+	return FReply::Handled();
+}
+
+void SMyTwoColumnWidget::OnOptimizerComplete(const FTextureOptimizerResult& Result, UTexturePresetAsset* Preset)
+{
+	bOptimizerRunning = false;
+
+	FString Unreadable;
+	for (const FTextureOptimizerTextureResult& TextureResult : Result.Textures)
+	{
+		if (!TextureResult.bAnalyzed && TextureResult.Texture.IsValid())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Optimize compression: could not read the source of %s, left it out"),
+				*TextureResult.Texture->GetPathName());
+		}
+	}
+	if (Result.NumUnreadable > 0)
+	{
+		Unreadable = FString::Printf(TEXT("\n\n%d textures were left out because their source could not be read (see the log)."), Result.NumUnreadable);
+	}
+
+	if (!Result.bFound)
+	{
+		OptimizerStatus = FText::FromString(Result.Message.ToString() + Unreadable);
+		return;
+	}
+
+	const FText CompressionText = StaticEnum<TextureCompressionSettings>()->GetDisplayNameTextByValue(Result.Settings.CompressionSettings);
+	const FText MaxSizeText = Result.Settings.MaxTextureSize > 0
+		? FText::AsNumber(Result.Settings.MaxTextureSize)
+		: NSLOCTEXT("TextureManager", "OptimizerFullSize", "full size");
+
+	OptimizerStatus = FText::Format(
+		NSLOCTEXT("TextureManager", "OptimizerStatus", "{0}, {1}, LOD bias {2}: {3} -> {4} (worst PSNR {5} dB, SSIM {6})"),
+		CompressionText,
+		MaxSizeText,
+		FText::AsNumber(Result.Settings.LODBias),
+		FText::AsMemory(Result.CurrentBytes),
+		FText::AsMemory(Result.OptimizedBytes),
+		FText::AsNumber(Result.WorstMetrics.PSNR, &FNumberFormattingOptions::DefaultNoGrouping()),
+		FText::AsNumber(Result.WorstMetrics.SSIM, &FNumberFormattingOptions::DefaultNoGrouping()));
+
+	const FString Target = Preset
+		? FString::Printf(TEXT("Update preset '%s'"), *(!Preset->PresetName.IsNone() ? Preset->PresetName.ToString() : Preset->GetName()))
+		: FString(TEXT("Create a new preset"));
+
+	const FString Msg = FString::Printf(
+		TEXT("%s\n\n%s with these settings for %d textures?%s"),
+		*OptimizerStatus.ToString(),
+		*Target,
+		Result.Textures.Num() - Result.NumUnreadable,
+		*Unreadable);
+
+	if (FMessageDialog::Open(EAppMsgType::YesNo, FText::FromString(Msg)) != EAppReturnType::Yes)
+	{
+		return;
+	}
+
+	UTexturePresetAsset* Written = nullptr;
+	if (Preset)
+	{
+		Written = TextureCompressionOptimizer::WriteToPreset(Result, Preset, FString(), NAME_None);
+	}
+	else
+	{
+		TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("TextureManager"));
+		const UTexture2D* First = Result.Textures.Num() > 0 ? Result.Textures[0].Texture.Get() : nullptr;
+		if (!Plugin || !First)
+		{
+			return;
+		}
+
+		const FString DefaultPath = Plugin->GetMountedAssetPath() + "TexturePresets";
+		const FString DefaultName = FString::Printf(TEXT("%s_Optimized"), *First->GetName());
+
+		FString ChosenName;
+		if (!PromptForPresetName(DefaultName, ChosenName, DefaultPath))
+		{
+			return;
+		}
+
+		Written = TextureCompressionOptimizer::WriteToPreset(Result, nullptr, DefaultPath, FName(*ChosenName));
+	}
 
-								// Presets Save
-								+ SWidgetSwitcher::Slot()
-								[
-									SNew(SButton)
-										.Text(NSLOCTEXT("TextureManager", "SaveButton", "Save"))
-										.OnClicked(this, &SMyTwoColumnWidget::OnPresetSaveButtonClicked)
-								]
-						]
-				]
+	if (!Written)
+	{
+		return;
+	}
 
-				// Single DetailsView (behavior controlled by ActiveTab + selection)
-				+ SVerticalBox::Slot()
-				.FillHeight(1.f)
-				.Padding(0.f, 4.f)
-				[
-					DetailsView.ToSharedRef()
-				]
-		];
+	bSaveWhenRebuildsDone = true;
+	SaveDirtyTexturesAndPresets();
+	RefreshPresetList();
 }
 
-// ---------- Row generators ----------
+// ---------- Memory estimate ----------
 
-TSharedRef<ITableRow> SMyTwoColumnWidget::GenerateTextureRow(FTextureItem Item, const TSharedRef<STableViewBase>& OwnerTable)
+void SMyTwoColumnWidget::RefreshPresetMemoryEstimate()
 {
-	FText Label = FText::FromString(
-		Item.IsValid() ? Item->GetName() : TEXT("<invalid>"));
+	TEXTURE_MANAGER_SCOPE("RefreshPresetMemoryEstimate");
+	UTexturePresetAsset* Preset = SelectedPreset.Get();
+	if (!Preset)
+	{
+		PresetMemoryCurrent = FTextureMemoryEstimate();
+		PresetMemoryPreview = FTextureMemoryEstimate();
+		return;
+	}
 
-	return
-		SNew(STableRow<FTextureItem>, OwnerTable)
-		[
-			SNew(STextBlock).Text(Label)
-		];
+	PresetMemoryCurrent = TextureMemoryEstimator::EstimatePreset(Preset, TexturePresetLibrary::ResolveSettings(Preset));
+	PresetMemoryPreview = PreviewPreset
+		? TextureMemoryEstimator::EstimatePreset(PreviewPreset, TexturePresetLibrary::ResolveSettings(PreviewPreset))
+		: PresetMemoryCurrent;
 }
 
-TSharedRef<ITableRow> SMyTwoColumnWidget::GeneratePresetRow(FPresetItem Item, const TSharedRef<STableViewBase>& OwnerTable)
+FText SMyTwoColumnWidget::GetRebuildStatusText() const
 {
-	FText Label = FText::FromString(TEXT("<Preset>"));
+	const FTextureRebuildSchedulerState State = TextureRebuildScheduler::GetState();
+	return FText::Format(
+		NSLOCTEXT("TextureManager", "RebuildStatus", "Rebuilding textures: {0} running ({1}), {2} queued, {3} done{4}"),
+		FText::AsNumber(State.NumBuilding),
+		FText::AsMemory(State.BuildingBytes),
+		FText::AsNumber(State.NumQueued),
+		FText::AsNumber(State.NumDone),
+		State.bPaused ? NSLOCTEXT("TextureManager", "RebuildPaused", " - paused") : FText::GetEmpty());
+}
 
-	if (Item.IsValid())
+void SMyTwoColumnWidget::GatherRebuildPriority(TSet<FName>& OutPackages)
+{
+	// Rows on screen
+	for (const TPair<const ITableRow*, FName>& Pair : ThumbnailRowPackages)
 	{
-		const UTexturePresetAsset* Preset = Item.Get();
-		if (Preset)
+		OutPackages.Add(Pair.Value);
+	}
+
+	if (TextureListView.IsValid())
+	{
+		for (const FTextureItem& Item : TextureListView->GetSelectedItems())
 		{
-			if (!Preset->PresetName.IsNone())
-			{
-				Label = FText::FromName(Preset->PresetName);
-			}
-			else
+			if (const UTexture2D* Texture = Item.Get())
 			{
-				Label = FText::FromString(Preset->GetName());
+				OutPackages.Add(Texture->GetOutermost()->GetFName());
 			}
 		}
 	}
+}
 
-	return
-		SNew(STableRow<FPresetItem>, OwnerTable)
-		[
-			SNew(STextBlock).Text(Label)
-		];
+void SMyTwoColumnWidget::OnRebuildsDrained()
+{
+	if (bSaveWhenRebuildsDone)
+	{
+		bSaveWhenRebuildsDone = false;
+		SaveDirtyTexturesAndPresets();
+	}
+
+	// Textures that got a preset no longer count as unassigned
+	UpdateContentStatus();
+}
+
+FText SMyTwoColumnWidget::GetPresetMemoryText() const
+{
+	const UTexturePresetAsset* Preset = SelectedPreset.Get();
+	if (!Preset)
+	{
+		return FText::GetEmpty();
+	}
+
+	const FText Summary = FText::Format(
+		NSLOCTEXT("TextureManager", "PresetMemory", "{0} textures: {1} resident, {2} streamed, {3} cooked"),
+		FText::AsNumber(Preset->Files.Num()),
+		FText::AsMemory(PresetMemoryCurrent.ResidentBytes),
+		FText::AsMemory(PresetMemoryCurrent.StreamedBytes),
+		FText::AsMemory(PresetMemoryCurrent.CookedBytes));
+
+	// What saving the edits in the details panel would do
+	const int64 Delta = PresetMemoryPreview.GetTotalBytes() - PresetMemoryCurrent.GetTotalBytes();
+	if (Delta == 0)
+	{
+		return Summary;
+	}
+
+	return FText::Format(
+		NSLOCTEXT("TextureManager", "PresetMemoryDelta", "{0}\nAfter save: {1}{2} ({3} resident, {4} streamed)"),
+		Summary,
+		FText::FromString(Delta > 0 ? TEXT("+") : TEXT("-")),
+		FText::AsMemory(FMath::Abs(Delta)),
+		FText::AsMemory(PresetMemoryPreview.ResidentBytes),
+		FText::AsMemory(PresetMemoryPreview.StreamedBytes));
 }
 
 // ---------- Tabs & refresh ----------
@@ -482,16 +2002,8 @@ void SMyTwoColumnWidget::OnTabChanged(ENavigationTab NewTab)
 	}
 	
 	if (ActiveTab == ENavigationTab::Files) {
-		if (SelectedPreset.Get()) {
-			auto Preset = SelectedPreset.Get();
-			if (Preset) {
-				for (auto Texture : Preset->Files) {
-					if (Texture) {
-						TexturePresetLibrary::ApplyToTexture(Preset, Texture);
-						Texture->PostEditChange();
-					}
-				}
-			}
+		if (UTexturePresetAsset* Preset = SelectedPreset.Get()) {
+			TexturePresetLibrary::ApplyToLinkedTextures({ Preset });
 		}
 	}
 	else {
@@ -500,14 +2012,8 @@ void SMyTwoColumnWidget::OnTabChanged(ENavigationTab NewTab)
 			UTexturePresetUserData* UserData =
 				Cast<UTexturePresetUserData>(
 					PTexture->GetAssetUserDataOfClass(UTexturePresetUserData::StaticClass()));
-			UTexturePresetAsset* Preset = UserData ? UserData->AssignedPreset : nullptr;
-			if (Preset) {
-				for (auto Texture : Preset->Files) {
-					if (Texture) {
-						TexturePresetLibrary::ApplyToTexture(Preset, Texture);
-						Texture->PostEditChange();
-					}
-				}
+			if (UTexturePresetAsset* Preset = UserData ? UserData->AssignedPreset : nullptr) {
+				TexturePresetLibrary::ApplyToLinkedTextures({ Preset });
 			}
 		}
 	}
@@ -522,6 +2028,8 @@ void SMyTwoColumnWidget::OnTabChanged(ENavigationTab NewTab)
 
 void SMyTwoColumnWidget::RefreshTextureList()
 {
+	TEXTURE_MANAGER_SCOPE("RefreshTextureList");
+	FTextureManagerOperationScope Operation(TEXT("RefreshTextureList"));
 //	//TextureItems.Reset();
 //	AllTextureItems.Reset();
 //	FilteredTextureItems.Reset();
@@ -556,53 +2064,58 @@ void SMyTwoColumnWidget::RefreshTextureList()
 	//TextureItems.Reset();
 	AllTextureItems.Reset();
 	FilteredTextureItems.Reset();
+	AllTextureAssets.Reset();
+	bTextureItemsLoaded = false;
 
-#if WITH_EDITOR
-	FAssetRegistryModule& AssetRegistryModule =
-		FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-	FARFilter Filter;
-	Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
-	Filter.bRecursivePaths = true;
-	Filter.bRecursiveClasses = true;
+	// Unloaded textures may have changed on disk since they were estimated
+	MemoryEstimates.Reset();
 
-	// 1) Project Content (/Game)
-	Filter.PackagePaths.Add(FName(TEXT("/Game")));
+#if WITH_EDITOR
+	// Project content (/Game) and the plugin's
+	AllTextureAssets = TextureManagerLists::QueryAssets(UTexture2D::StaticClass(), TextureManagerLists::GetContentRoots());
+	TRACE_COUNTER_SET(TextureManager_ListedTextures, AllTextureAssets.Num());
+#endif // WITH_EDITOR
 
-	// 2) Plugin Content
-	if (TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("TextureManager")))
+	// The grouped views never load a texture that isn't expanded
+	if (Grouping == ETextureGrouping::Flat)
+	{
+		EnsureTextureItemsLoaded();
+	}
+	else
 	{
-		const FString PluginRoot = Plugin->GetMountedAssetPath(); // e.g. "/TextureManager"
-		if (!PluginRoot.IsEmpty())
+		if (TextureListView.IsValid())
 		{
-			Filter.PackagePaths.Add(FName(*PluginRoot));
+			TextureListView->RequestListRefresh();
 		}
+		UpdateContentStatus();
 	}
 
-	TArray<FAssetData> Assets;
-	AssetRegistry.GetAssets(Filter, Assets);
+	RebuildTextureTree();
+}
 
-	for (const FAssetData& Data : Assets)
+void SMyTwoColumnWidget::EnsureTextureItemsLoaded()
+{
+	if (bTextureItemsLoaded)
 	{
-		if (UTexture2D* Texture = Cast<UTexture2D>(Data.GetAsset()))
-		{
-			FTextureItem Item = Texture;
-			//TextureItems.Add(Item);
-			AllTextureItems.Add(Item);
-			FilteredTextureItems.Add(Item);
-		}
+		return;
 	}
-#endif // WITH_EDITOR
+	bTextureItemsLoaded = true;
+
+	TEXTURE_MANAGER_SCOPE("LoadTextureItems");
+	AllTextureItems = TextureManagerLists::LoadTextures(AllTextureAssets);
+	FilteredTextureItems = TextureManagerLists::SearchTextures(AllTextureItems, FilesSearchQuery);
 
 	if (TextureListView.IsValid())
 	{
 		TextureListView->RequestListRefresh();
 	}
+	UpdateContentStatus();
 }
 
 void SMyTwoColumnWidget::RefreshPresetList()
 {
+	TEXTURE_MANAGER_SCOPE("RefreshPresetList");
+	FTextureManagerOperationScope Operation(TEXT("RefreshPresetList"));
 //	//PresetItems.Reset();
 //	AllPresetItems.Reset();
 //	FilteredPresetItems.Reset();
@@ -670,7 +2183,7 @@ void SMyTwoColumnWidget::RefreshPresetList()
 //	SelectPresetInCombo(SelectedPreset.Get());
 //	CurrentFilterOption = FilterPresetLabels[FilterIndex];
 		//PresetItems.Reset();
-	//SCOPE_CYCLE_COUNTER(STAT_TextureManager_RefreshPresetList);
+	SCOPE_CYCLE_COUNTER(STAT_TextureManager_RefreshPresetList);
 	AllPresetItems.Reset();
 	FilteredPresetItems.Reset();
 
@@ -692,55 +2205,23 @@ void SMyTwoColumnWidget::RefreshPresetList()
 	FilterPresetChoices.Add(nullptr);
 
 #if WITH_EDITOR
-	FAssetRegistryModule& AssetRegistryModule =
-		FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-	FARFilter Filter;
-	Filter.ClassPaths.Add(UTexturePresetAsset::StaticClass()->GetClassPathName());
-	Filter.bRecursivePaths = true;
-	Filter.bRecursiveClasses = true;
-
-	// 1) Project Content (/Game)
-	Filter.PackagePaths.Add(FName(TEXT("/Game")));
+	// Project content (/Game) and the plugin's; the list view shows them all
+	AllPresetItems = TextureManagerLists::LoadPresets(
+		TextureManagerLists::QueryAssets(UTexturePresetAsset::StaticClass(), TextureManagerLists::GetContentRoots()));
+	FilteredPresetItems = AllPresetItems;
 
-	// 2) Plugin Content (e.g. /Testing)
-	if (TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("TextureManager")))
-	{
-		const FString PluginRoot = Plugin->GetMountedAssetPath(); // e.g. "/Testing"
-		if (!PluginRoot.IsEmpty())
-		{
-			Filter.PackagePaths.Add(FName(*PluginRoot));
-		}
-	}
-
-	TArray<FAssetData> Assets;
-	AssetRegistry.GetAssets(Filter, Assets);
-
-	for (const FAssetData& Data : Assets)
+	// For combo boxes
+	for (const FPresetItem& Item : AllPresetItems)
 	{
-		if (UTexturePresetAsset* Preset = Cast<UTexturePresetAsset>(Data.GetAsset()))
-		{
-			FPresetItem Item = Preset;
-
-			// For list view
-			AllPresetItems.Add(Item);
-			FilteredPresetItems.Add(Item);
-
-			// For combo boxes
-			const FString LabelString = !Preset->PresetName.IsNone()
-				? Preset->PresetName.ToString()
-				: Preset->GetName();
-
-			TSharedPtr<FString> Label = MakeShared<FString>(LabelString);
+		TSharedPtr<FString> Label = MakeShared<FString>(TextureManagerLists::GetPresetLabel(Item.Get()));
 
-			PresetLabels.Add(Label);
-			PresetChoices.Add(Preset);
+		PresetLabels.Add(Label);
+		PresetChoices.Add(Item);
 
-			FilterPresetLabels.Add(Label);
-			FilterPresetChoices.Add(Preset);
-		}
+		FilterPresetLabels.Add(Label);
+		FilterPresetChoices.Add(Item);
 	}
+	TRACE_COUNTER_SET(TextureManager_ListedPresets, AllPresetItems.Num());
 #endif // WITH_EDITOR
 
 	//for (auto Preset : AllPresetItems)
@@ -774,6 +2255,15 @@ void SMyTwoColumnWidget::RefreshPresetList()
 	{
 		PresetFilterComboBox->SetSelectedItem(CurrentFilterOption);
 	}
+
+	// Suggestions are picked from FilterPresetChoices
+	UpdateContentStatus();
+
+	// Preset groups are built from FilterPresetChoices
+	if (Grouping == ETextureGrouping::ByPreset)
+	{
+		RebuildTextureTree();
+	}
 }
 
 bool SMyTwoColumnWidget::PromptForPresetName(const FString& DefaultName, FString& OutName, const FString& FixedPath)
@@ -894,25 +2384,21 @@ bool SMyTwoColumnWidget::PromptForPresetName(const FString& DefaultName, FString
 
 void SMyTwoColumnWidget::OnTextureSelected(FTextureItem Item, ESelectInfo::Type SelectInfo)
 {
+	TEXTURE_MANAGER_SCOPE("OnTextureSelected");
 	if (SelectedTexture.Get()) {
 		auto PTexture = SelectedTexture.Get();
 		UTexturePresetUserData* UserData =
 			Cast<UTexturePresetUserData>(
 				PTexture->GetAssetUserDataOfClass(UTexturePresetUserData::StaticClass()));
-		UTexturePresetAsset* Preset = UserData ? UserData->AssignedPreset : nullptr;
-		if (Preset) {
-			for (auto Texture : Preset->Files) {
-				if (Texture) {
-					TexturePresetLibrary::ApplyToTexture(Preset, Texture);
-					Texture->PostEditChange();
-				}
-			}
+		if (UTexturePresetAsset* Preset = UserData ? UserData->AssignedPreset : nullptr) {
+			TexturePresetLibrary::ApplyToLinkedTextures({ Preset });
 		}
 	}
 
 	SelectedTexture = Item;
 	bPendingPresetChange = false;
 	bPendingPropertyChange = false;
+	UpdateAlphaSuggestion();
 
 	TArray<FTextureItem> SelectedItems;
 
@@ -953,8 +2439,9 @@ void SMyTwoColumnWidget::OnTextureSelected(FTextureItem Item, ESelectInfo::Type
 	if (!Preset) {
 		bPendingPresetChange = true;
 	}
-	TexturePresetLibrary::ApplyToTexture(Preset, Texture);
-	Texture->PostEditChange();
+	else if (!Preset->bApplyAtCook) {
+		TextureRebuildScheduler::Enqueue(Preset, Texture);
+	}
 
 	ActiveTab = ENavigationTab::Files;
 	SyncSelectionToDetails();
@@ -962,16 +2449,9 @@ void SMyTwoColumnWidget::OnTextureSelected(FTextureItem Item, ESelectInfo::Type
 
 void SMyTwoColumnWidget::OnPresetSelected(FPresetItem Item, ESelectInfo::Type SelectInfo)
 {
-	if (SelectedPreset.Get()) {
-		auto Preset = SelectedPreset.Get();
-		if (Preset) {
-			for (auto Texture : Preset->Files) {
-				if (Texture) {
-					TexturePresetLibrary::ApplyToTexture(Preset, Texture);
-					Texture->PostEditChange();
-				}
-			}
-		}
+	TEXTURE_MANAGER_SCOPE("OnPresetSelected");
+	if (UTexturePresetAsset* Preset = SelectedPreset.Get()) {
+		TexturePresetLibrary::ApplyToLinkedTextures({ Preset });
 	}
 
 	SelectedPreset = Item;
@@ -980,8 +2460,9 @@ void SMyTwoColumnWidget::OnPresetSelected(FPresetItem Item, ESelectInfo::Type Se
 	{
 		if (SelectedPreset.IsValid())
 		{
-			PreviewPreset = ClonePresetTransient(SelectedPreset.Get());
-			DetailsView->SetObject(PreviewPreset);
+			PreviewPreset = PreviewPool->GetPreset(SelectedPreset.Get());
+			DetailsView->SetObject(PreviewPreset, true);
+			RefreshPresetMemoryEstimate();
 		}
 		else
 		{
@@ -994,6 +2475,7 @@ void SMyTwoColumnWidget::OnPresetSelected(FPresetItem Item, ESelectInfo::Type Se
 
 void SMyTwoColumnWidget::SyncSelectionToDetails()
 {
+	TEXTURE_MANAGER_SCOPE("SyncSelectionToDetails");
 	if (!DetailsView.IsValid())
 	{
 		return;
@@ -1014,8 +2496,8 @@ void SMyTwoColumnWidget::SyncSelectionToDetails()
 		//TexturePresetLibrary::ApplyToTexture(SelectedPreset.Get(), Texture);
 		if (Texture)
 		{
-			PreviewTexture = CloneTextureTransient(Texture);
-			DetailsView->SetObject(PreviewTexture);
+			PreviewTexture = PreviewPool->GetTexture(Texture);
+			DetailsView->SetObject(PreviewTexture, true);
 			//DetailsView->SetObject(Texture);
 		}
 		else
@@ -1027,8 +2509,9 @@ void SMyTwoColumnWidget::SyncSelectionToDetails()
 	{
 		if (SelectedPreset.IsValid())
 		{
-			PreviewPreset = ClonePresetTransient(SelectedPreset.Get());
-			DetailsView->SetObject(PreviewPreset);
+			PreviewPreset = PreviewPool->GetPreset(SelectedPreset.Get());
+			DetailsView->SetObject(PreviewPreset, true);
+			RefreshPresetMemoryEstimate();
 		}
 		else
 		{
@@ -1101,6 +2584,7 @@ void SMyTwoColumnWidget::ClearDetails()
 
 void SMyTwoColumnWidget::OnPresetComboChanged(TSharedPtr<FString> NewSelection,ESelectInfo::Type SelectInfo)
 {
+	TEXTURE_MANAGER_SCOPE("OnPresetComboChanged");
 	if (!NewSelection.IsValid())
 	{
 		return;
@@ -1166,24 +2650,19 @@ void SMyTwoColumnWidget::OnPresetComboChanged(TSharedPtr<FString> NewSelection,E
 		return;
 	}
 
-	// Real preset selected:
-	// 1) Attach preset to texture via user data
-	// 2) Apply all preset settings to the texture
-	 
-	//TexturePresetLibrary::AssignPresetToTexture(NewPreset, Texture);
-
-	//Texture->Modify();
-	//TexturePresetLibrary::AssignPresetToTexture(NewPreset, Texture);
-	for (auto tex : SelectedItems) {
-		if (tex.Get()) {
-			TexturePresetLibrary::ApplyToTexture(NewPreset, tex.Get());
-			tex->PostEditChange();
+	// Real preset selected: the scheduler applies it to the selected
+	// textures; their old values go to the journal, not the transaction buffer
+	if (!NewPreset->bApplyAtCook)
+	{
+		const FGuid JournalBatch = TextureBulkJournal::BeginBatch(TEXT("Apply ") + NewPreset->GetName());
+		for (const FTextureItem& Item : SelectedItems)
+		{
+			if (Item.IsValid())
+			{
+				TextureRebuildScheduler::Enqueue(NewPreset, Item.Get(), JournalBatch);
+			}
 		}
 	}
-	//TexturePresetLibrary::ApplyToTexture(NewPreset, Texture);
-	//Texture->PostEditChange();
-	//TexturePresetLibrary::ApplyToTexture(NewPreset, Texture);
-
 #endif
 
 	SelectedPreset = NewPreset;
@@ -1193,7 +2672,7 @@ void SMyTwoColumnWidget::OnPresetComboChanged(TSharedPtr<FString> NewSelection,E
 	if (ActiveTab == ENavigationTab::Files && DetailsView.IsValid())
 	{
 		DetailsView->SetObject(nullptr);
-		PreviewTexture = CloneTextureTransient(Texture);
+		PreviewTexture = PreviewPool->GetTexture(Texture);
 		DetailsView->SetObject(PreviewTexture);
 		//DetailsView->SetObject(Texture);
 	}
@@ -1208,6 +2687,8 @@ void SMyTwoColumnWidget::OnPresetComboChanged(TSharedPtr<FString> NewSelection,E
 //////////////////////////////////////////////////////////////////////////
 FReply SMyTwoColumnWidget::OnSaveButtonClicked()
 {
+	TEXTURE_MANAGER_SCOPE("OnSaveButtonClicked");
+	FTextureManagerOperationScope Operation(TEXT("SaveTexture"));
 	// Start timing at the **very beginning** of the function
 	const double StartSeconds = FPlatformTime::Seconds();
 	
@@ -1337,38 +2818,28 @@ FReply SMyTwoColumnWidget::OnSaveButtonClicked()
 				// No extra "name" window here; we keep the original preset name.
 				TexturePresetLibrary::UpdatePresetFromTexture(CurrentPreset, Texture);
 
-				// Re-apply to all linked textures so they pick up the new settings
-				for (UTexture2D* Other : LinkedTextures)
+				// Re-apply to all linked textures so they pick up the new settings,
+				// the selected one among them (it is a priority row, so it goes first)
+				LinkedTextures.AddUnique(SelectedTexture.Get());
+				const FGuid JournalBatch = TextureBulkJournal::BeginBatch(TEXT("Overwrite ") + CurrentPreset->GetName());
+				for (UTexture2D* Linked : LinkedTextures)
 				{
-					if (Other)
+					if (Linked)
 					{
-						Other->Modify();
-						TexturePresetLibrary::AssignPresetToTexture(CurrentPreset, Other);
-						TexturePresetLibrary::ApplyToTexture(CurrentPreset, Other);
-						Other->PostEditChange();
+						Linked->Modify();
+						TexturePresetLibrary::AssignPresetToTexture(CurrentPreset, Linked);
+						TextureRebuildScheduler::Enqueue(CurrentPreset, Linked, JournalBatch);
 					}
 				}
+				bSaveWhenRebuildsDone = true;
 
 				SelectedPreset = CurrentPreset;
-
-				SelectedTexture.Get()->Modify();
-				TexturePresetLibrary::AssignPresetToTexture(SelectedPreset.Get(), SelectedTexture.Get());
-				TexturePresetLibrary::ApplyToTexture(SelectedPreset.Get(), SelectedTexture.Get());
-				SelectedTexture.Get()->PostEditChange();
 				//SaveFiles(SelectedItems);
 			}
 			else if (Response == EAppReturnType::No)
 			{
-				if (SelectedPreset.Get()) {
-					auto Preset = SelectedPreset.Get();
-					if (Preset) {
-						for (auto newTexture : Preset->Files) {
-							if (newTexture) {
-								TexturePresetLibrary::ApplyToTexture(Preset, newTexture);
-								newTexture->PostEditChange();
-							}
-						}
-					}
+				if (UTexturePresetAsset* Preset = SelectedPreset.Get()) {
+					bSaveWhenRebuildsDone |= TexturePresetLibrary::ApplyToLinkedTextures({ Preset }) > 0;
 				}
 
 				// Create a brand-new preset only for this texture
@@ -1388,8 +2859,8 @@ FReply SMyTwoColumnWidget::OnSaveButtonClicked()
 						//SaveFiles(SelectedItems);
 						SelectedTexture.Get()->Modify();
 						TexturePresetLibrary::AssignPresetToTexture(SelectedPreset.Get(), SelectedTexture.Get());
-						TexturePresetLibrary::ApplyToTexture(SelectedPreset.Get(), SelectedTexture.Get());
-						SelectedTexture.Get()->PostEditChange();
+						TextureRebuildScheduler::Enqueue(SelectedPreset.Get(), SelectedTexture.Get());
+						bSaveWhenRebuildsDone = true;
 					}
 				}
 			}
@@ -1416,16 +2887,7 @@ FReply SMyTwoColumnWidget::OnSaveButtonClicked()
 	SET_FLOAT_STAT(STAT_TextureManager_OnSaveButtonClickedWallMs, DurationMs);
 	INC_DWORD_STAT(STAT_TextureManager_OnSaveButtonClickedCalls);
 
-	if (GEngine)
-	{
-		GEngine->AddOnScreenDebugMessage(
-			-1,
-			5.0f,
-			FColor::Yellow,
-			FString::Printf(TEXT("OnSaveButtonClicked wall time: %.2f ms"), DurationMs));
-	}
-
-	UE_LOG(LogTemp, Log, TEXT("OnSaveButtonClicked wall time: %.2f ms"), DurationMs);
+	UE_LOG(LogTemp, Verbose, TEXT("OnSaveButtonClicked wall time: %.2f ms"), DurationMs);
 
 
 	return FReply::Handled();
@@ -1435,6 +2897,8 @@ FReply SMyTwoColumnWidget::OnSaveButtonClicked()
 
 FReply SMyTwoColumnWidget::OnPresetSaveButtonClicked()
 {
+	TEXTURE_MANAGER_SCOPE("OnPresetSaveButtonClicked");
+	FTextureManagerOperationScope Operation(TEXT("SavePreset"));
 	const double StartSeconds = FPlatformTime::Seconds();
 	{
 		SCOPE_CYCLE_COUNTER(STAT_TextureManager_OnPresetSaveButtonClicked);
@@ -1444,12 +2908,57 @@ FReply SMyTwoColumnWidget::OnPresetSaveButtonClicked()
 		TArray<UTexture2D*> LinkedTextures = CurrentPreset->Files;
 		//TexturePresetLibrary::GetAllTexturesUsingPreset(CurrentPreset);
 
+		// Presets inheriting from this one change with it
+		const TArray<UTexturePresetAsset*> DerivedPresets =
+			TexturePresetLibrary::GetDerivedPresets(CurrentPreset, AllPresetItems);
+		int32 NumDerivedTextures = 0;
+		for (const UTexturePresetAsset* Derived : DerivedPresets)
+		{
+			NumDerivedTextures += Derived->Files.Num();
+		}
+
+		// What confirming costs: rebuilds (from past build times) and memory.
+		// Derived presets are estimated as if they took every applied field
+		// from the new settings, so their part is an upper bound.
+		FTextureRebuildEstimate Rebuild;
+		if (PreviewPreset && !PreviewPreset->bApplyAtCook)
+		{
+			Rebuild = TextureRebuildCostModel::EstimateApply(PreviewPreset, LinkedTextures);
+			for (const UTexturePresetAsset* Derived : DerivedPresets)
+			{
+				if (!Derived->bApplyAtCook)
+				{
+					const FTextureRebuildEstimate DerivedRebuild = TextureRebuildCostModel::EstimateApply(PreviewPreset, Derived->Files);
+					Rebuild.NumTextures += DerivedRebuild.NumTextures;
+					Rebuild.NumExtrapolated += DerivedRebuild.NumExtrapolated;
+					Rebuild.Seconds += DerivedRebuild.Seconds;
+				}
+			}
+		}
+
+		RefreshPresetMemoryEstimate();
+		const int64 MemoryDelta = PresetMemoryPreview.GetTotalBytes() - PresetMemoryCurrent.GetTotalBytes();
+
 		const FText Message = FText::Format(
 			NSLOCTEXT("TexturePreset", "OverwriteOrNew",
-				"This preset is currently used by {0} texture(s).\n\n"
+				"This preset is currently used by {0} texture(s), and {1} more through {2} derived preset(s).\n\n"
+				"Rebuild: {3} texture(s), about {4}{5}.\n"
+				"Memory: {6}{7}.\n\n"
 				"Yes = Save preset for all textures.\n"
 				"No = Do nothing."),
-			FText::AsNumber(LinkedTextures.Num()));
+			{
+				FText::AsNumber(LinkedTextures.Num()),
+				FText::AsNumber(NumDerivedTextures),
+				FText::AsNumber(DerivedPresets.Num()),
+				FText::AsNumber(Rebuild.NumTextures),
+				FText::AsTimespan(FTimespan::FromSeconds(FMath::CeilToDouble(Rebuild.Seconds))),
+				Rebuild.NumExtrapolated > 0
+					? FText::Format(NSLOCTEXT("TexturePreset", "RebuildExtrapolated", " ({0} without build history, guessed)"),
+						FText::AsNumber(Rebuild.NumExtrapolated))
+					: FText::GetEmpty(),
+				FText::FromString(MemoryDelta < 0 ? TEXT("-") : TEXT("+")),
+				FText::AsMemory(uint64(FMath::Abs(MemoryDelta)))
+			});
 
 		const EAppReturnType::Type Response =
 			FMessageDialog::Open(
@@ -1466,15 +2975,18 @@ FReply SMyTwoColumnWidget::OnPresetSaveButtonClicked()
 			{
 				if (Other)
 				{
-					Other->Modify();
 					TexturePresetLibrary::AssignPresetToTexture(CurrentPreset, Other);
-					TexturePresetLibrary::ApplyToTexture(CurrentPreset, Other);
-					Other->PostEditChange();
 				}
 			}
+
+			// One pass over this preset's textures and every derived preset's
+			TArray<UTexturePresetAsset*> AffectedPresets = { CurrentPreset };
+			AffectedPresets.Append(DerivedPresets);
+			bSaveWhenRebuildsDone |= TexturePresetLibrary::ApplyToLinkedTextures(AffectedPresets) > 0;
 		}
 	}
 	SaveDirtyTexturesAndPresets();
+	RefreshPresetMemoryEstimate();
 	
 	const double EndSeconds = FPlatformTime::Seconds();
 	const float DurationMs = static_cast<float>((EndSeconds - StartSeconds) * 1000.0);
@@ -1482,16 +2994,7 @@ FReply SMyTwoColumnWidget::OnPresetSaveButtonClicked()
 	SET_FLOAT_STAT(STAT_TextureManager_OnPresetSaveButtonClickedWallMs, DurationMs);
 	INC_DWORD_STAT(STAT_TextureManager_OnPresetSaveButtonClickedCalls);
 
-	if (GEngine)
-	{
-		GEngine->AddOnScreenDebugMessage(
-			-1,
-			5.0f,
-			FColor::Cyan,
-			FString::Printf(TEXT("OnPresetSaveButtonClicked wall time: %.2f ms"), DurationMs));
-	}
-
-	UE_LOG(LogTemp, Log, TEXT("OnPresetSaveButtonClicked wall time: %.2f ms"), DurationMs);
+	UE_LOG(LogTemp, Verbose, TEXT("OnPresetSaveButtonClicked wall time: %.2f ms"), DurationMs);
 
 
 	return FReply::Handled();
@@ -1527,10 +3030,75 @@ FReply SMyTwoColumnWidget::OnPresetNewButtonClicked()
 	return FReply::Handled();
 }
 
+FReply SMyTwoColumnWidget::OnMergePresetsClicked()
+{
+	TEXTURE_MANAGER_SCOPE("OnMergePresetsClicked");
+	TArray<TWeakObjectPtr<UTexturePresetAsset>> Presets;
+	for (const FPresetItem& Item : AllPresetItems)
+	{
+		Presets.Add(Item);
+	}
+
+	const TArray<FPresetMergeGroup> Groups = TexturePresetClustering::FindDuplicatePresets(Presets);
+	if (Groups.Num() == 0)
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, NSLOCTEXT("TextureManager", "NoDuplicatePresets", "No two presets have identical settings."));
+		return FReply::Handled();
+	}
+
+	FString List;
+	int32 NumDuplicates = 0;
+	for (const FPresetMergeGroup& Group : Groups)
+	{
+		const UTexturePresetAsset* Keeper = Group.Presets[0].Get();
+		List += FString::Printf(TEXT("  %s <- "), Keeper ? *Keeper->GetName() : TEXT("?"));
+		for (int32 Index = 1; Index < Group.Presets.Num(); ++Index)
+		{
+			const UTexturePresetAsset* Duplicate = Group.Presets[Index].Get();
+			List += FString::Printf(TEXT("%s%s"), Index > 1 ? TEXT(", ") : TEXT(""), Duplicate ? *Duplicate->GetName() : TEXT("?"));
+		}
+		List += TEXT("\n");
+		NumDuplicates += Group.Presets.Num() - 1;
+	}
+
+	const FString Msg = FString::Printf(
+		TEXT("Merge %d presets into %d and leave redirectors behind?\n\n%s"),
+		NumDuplicates,
+		Groups.Num(),
+		*List);
+
+	if (FMessageDialog::Open(EAppMsgType::YesNo, FText::FromString(Msg)) != EAppReturnType::Yes)
+	{
+		return FReply::Handled();
+	}
+
+	// The duplicates are consolidated away; don't keep them selected or previewed
+	SelectedPreset.Reset();
+	if (DetailsView.IsValid())
+	{
+		DetailsView->SetObject(nullptr);
+	}
+
+	const int32 NumMerged = TexturePresetClustering::MergePresets(Groups);
+	UE_LOG(LogTemp, Log, TEXT("Merge Duplicates: merged %d of %d presets"), NumMerged, NumDuplicates);
+
+	SaveDirtyTexturesAndPresets();
+	RefreshPresetList();
+	RefreshPresetMemoryEstimate();
+
+	return FReply::Handled();
+}
+
 // ---------- Property change watching ----------
 
 void SMyTwoColumnWidget::OnAnyPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
 {
+	// Any texture edit (a preset apply included) may change what it costs
+	if (const UTexture2D* Texture = Cast<UTexture2D>(Object))
+	{
+		MemoryEstimates.Remove(Texture->GetOutermost()->GetFName());
+	}
+
 	// Only care about changes on the currently selected texture
 	if (!SelectedTexture.IsValid())
 	{
@@ -1573,6 +3141,7 @@ void SMyTwoColumnWidget::ShutdownPropertyWatcher()
 
 void SMyTwoColumnWidget::AddImportedTexture(UTexture2D* NewTexture)
 {
+	TEXTURE_MANAGER_SCOPE("AddImportedTexture");
 	if (!NewTexture)
 	{
 		return;
@@ -1580,6 +3149,14 @@ void SMyTwoColumnWidget::AddImportedTexture(UTexture2D* NewTexture)
 
 	FTextureItem NewItem = NewTexture;
 
+	// Not loaded yet: it comes with the rest
+	if (!bTextureItemsLoaded)
+	{
+		AllTextureAssets.AddUnique(FAssetData(NewTexture));
+		RebuildTextureTree();
+		return;
+	}
+
 	// Avoid duplicates
 	for (const FTextureItem& Existing : AllTextureItems)
 	{
@@ -1592,11 +3169,15 @@ void SMyTwoColumnWidget::AddImportedTexture(UTexture2D* NewTexture)
 	//TextureItems.Add(NewItem);
 	AllTextureItems.Add(NewItem);
 	FilteredTextureItems.Add(NewItem);
+	AllTextureAssets.Add(FAssetData(NewTexture));
 
 	if (TextureListView.IsValid())
 	{
 		TextureListView->RequestListRefresh();
 	}
+	UpdateContentStatus();
+
+	RebuildTextureTree();
 }
 
 void SMyTwoColumnWidget::SetSelectedTexture(UTexture2D* NewTexture)
@@ -1627,10 +3208,12 @@ void SMyTwoColumnWidget::SetSelectedTexture(UTexture2D* NewTexture)
 		//TextureItems.Add(Item);
 		AllTextureItems.Add(Item);
 		FilteredTextureItems.Add(Item);
+		AllTextureAssets.AddUnique(FAssetData(NewTexture));
 		if (TextureListView.IsValid())
 		{
 			TextureListView->RequestListRefresh();
 		}
+		UpdateContentStatus();
 	}
 
 	// Drive the same path as a real user-click
@@ -1648,6 +3231,7 @@ void SMyTwoColumnWidget::SetSelectedTexture(UTexture2D* NewTexture)
 
 void SMyTwoColumnWidget::OnFilterComboChange(TSharedPtr<FString> NewSelection, ESelectInfo::Type)
 {
+	TEXTURE_MANAGER_SCOPE("FilterFiles");
 	if (!NewSelection.IsValid())
 	{
 		return;
@@ -1661,6 +3245,7 @@ void SMyTwoColumnWidget::OnFilterComboChange(TSharedPtr<FString> NewSelection, E
 	}
 
 	CurrentFilterOption = NewSelection;
+	EnsureTextureItemsLoaded();
 	FilteredTextureItems.Empty();
 
 	TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("TextureManager"));
@@ -1668,79 +3253,56 @@ void SMyTwoColumnWidget::OnFilterComboChange(TSharedPtr<FString> NewSelection, E
 		return;
 	const FString PluginRoot = Plugin->GetMountedAssetPath(); // e.g. "/Testing"
 
-	UTexturePresetAsset* FoundPreset =
-		TexturePresetLibrary::FindPresetByName(*CurrentFilterOption, PluginRoot);
-
-
-	for (const FTextureItem& Item : AllTextureItems)
+	if (NewSelection == AllPresetOption)
 	{
-		UTexturePresetUserData* UserData = Cast<UTexturePresetUserData>(
-			Item->GetAssetUserDataOfClass(UTexturePresetUserData::StaticClass()));
-
-		if (!Item.IsValid()) continue;
-
-		if (FoundPreset == nullptr && NewSelection == NonePresetOption && (UserData == nullptr)) {
-			FilteredTextureItems.Add(Item);
-		}
-		else if (FoundPreset != nullptr && (UserData != nullptr && UserData->AssignedPreset == FoundPreset))
-		{
-			FilteredTextureItems.Add(Item);
-		}
-		else if (FoundPreset == nullptr && NewSelection == AllPresetOption) {
-			FilteredTextureItems.Add(Item);
-		}
+		FilteredTextureItems = AllTextureItems;
+	}
+	else if (NewSelection == NonePresetOption)
+	{
+		FilteredTextureItems = TextureManagerLists::FilterByPreset(AllTextureItems, nullptr);
+	}
+	else if (UTexturePresetAsset* FoundPreset = TexturePresetLibrary::FindPresetByName(*CurrentFilterOption, PluginRoot))
+	{
+		FilteredTextureItems = TextureManagerLists::FilterByPreset(AllTextureItems, FoundPreset);
 	}
 
 	if (TextureListView.IsValid())
 		TextureListView->RequestListRefresh();
+
+	UpdateContentStatus();
 }
 
 void SMyTwoColumnWidget::OnFilesSearchChanged(const FText& InText)
 {
+	TEXTURE_MANAGER_SCOPE("SearchFiles");
 	FilesSearchQuery = InText.ToString();
-	FilteredTextureItems.Empty();
 
-	for (const FTextureItem& Item : AllTextureItems)
+	// Unloaded items get the query when they load
+	if (bTextureItemsLoaded)
 	{
-		UTexturePresetUserData* UserData = Cast<UTexturePresetUserData>(
-			Item->GetAssetUserDataOfClass(UTexturePresetUserData::StaticClass()));
+		FilteredTextureItems = TextureManagerLists::SearchTextures(AllTextureItems, FilesSearchQuery);
 
-		if (!Item.IsValid()) continue;
+		if (TextureListView.IsValid())
+			TextureListView->RequestListRefresh();
 
-		if (FilesSearchQuery.IsEmpty() || Item->GetName().Contains(FilesSearchQuery))
-		{
-			FilteredTextureItems.Add(Item);
-		}
+		UpdateContentStatus();
 	}
 
-	if (TextureListView.IsValid())
-		TextureListView->RequestListRefresh();
+	RebuildTextureTree();
 }
 
 void SMyTwoColumnWidget::OnPresetsSearchChanged(const FText& InText)
 {
+	TEXTURE_MANAGER_SCOPE("SearchPresets");
 	PresetsSearchQuery = InText.ToString();
-	FilteredPresetItems.Empty();
-
-	for (const FPresetItem& Item : AllPresetItems)
-	{
-		if (!Item.IsValid()) continue;
-
-		const FString Label = !Item->PresetName.IsNone()
-			? Item->PresetName.ToString()
-			: Item->GetName();
-
-		if (PresetsSearchQuery.IsEmpty() || Label.Contains(PresetsSearchQuery))
-		{
-			FilteredPresetItems.Add(Item);
-		}
-	}
+	FilteredPresetItems = TextureManagerLists::SearchPresets(AllPresetItems, PresetsSearchQuery);
 
 	if (PresetListView.IsValid())
 		PresetListView->RequestListRefresh();
 }
 
 void SMyTwoColumnWidget::SaveFiles(TArray<FTextureItem> SelectedItems) {
+	TEXTURE_MANAGER_SCOPE("SaveFiles");
 	SCOPE_CYCLE_COUNTER(STAT_TextureManager_OnSaveButtonClicked);
 	// If multiple, confirm with the user
 	if (SelectedItems.Num() > 1)
@@ -1767,104 +3329,66 @@ void SMyTwoColumnWidget::SaveFiles(TArray<FTextureItem> SelectedItems) {
 		}
 	}
 
-	// Apply preset to all selected textures
+	// Link the preset to all selected textures; the scheduler applies it
+	UTexturePresetAsset* Preset = SelectedPreset.Get();
+	const FGuid JournalBatch = Preset && !Preset->bApplyAtCook
+		? TextureBulkJournal::BeginBatch(TEXT("Apply ") + Preset->GetName())
+		: FGuid();
 	for (const FTextureItem& Item : SelectedItems)
 	{
 		if (Item.IsValid())
 		{
 			UTexture2D* NewTexture = Item.Get();
 			NewTexture->Modify();
-			TexturePresetLibrary::ApplyToTexture(SelectedPreset.Get(), NewTexture);
-			TexturePresetLibrary::AssignPresetToTexture(SelectedPreset.Get(), NewTexture);
-			NewTexture->PostEditChange();
-			//NewTexture->MarkPackageDirty();
+			TexturePresetLibrary::AssignPresetToTexture(Preset, NewTexture);
+			if (JournalBatch.IsValid())
+			{
+				TextureRebuildScheduler::Enqueue(Preset, NewTexture, JournalBatch);
+				bSaveWhenRebuildsDone = true;
+			}
 		}
 	}
 }
 
 void SMyTwoColumnWidget::OnDetailsPropertyChanged(const FPropertyChangedEvent& Event)
 {
+	TEXTURE_MANAGER_SCOPE("OnDetailsPropertyChanged");
 	bPendingPropertyChange = true;
+	// Textures still queued from the last edit keep their place and take
+	// the newest values, so typing into a field doesn't rebuild per keystroke
 	if (ActiveTab == ENavigationTab::Presets) {
-		auto Preset = PreviewPreset;
-		if (Preset) {
-			for (auto Texture : Preset->Files) {
-				if (Texture) {
-					TexturePresetLibrary::ApplyToTexture(Preset, Texture);
-					Texture->PostEditChange();
-				}
-			}
+		if (PreviewPreset) {
+			TexturePresetLibrary::ApplyToLinkedTextures({ PreviewPreset });
 		}
+		RefreshPresetMemoryEstimate();
 	}
 	else {
 		auto PTexture = PreviewTexture;
-		UTexturePresetAsset* Copy = ClonePresetTransient(SelectedPreset.Get());;
+		UTexturePresetAsset* Copy = PreviewPool->GetScratchPreset(SelectedPreset.Get());
 		TexturePresetLibrary::CaptureFromTexture(Copy, PTexture);
 		if (Copy) {
-			for (auto Texture : Copy->Files) {
-				if (Texture) {
-					TexturePresetLibrary::ApplyToTexture(Copy, Texture);
-					Texture->PostEditChange();
-				}
-			}
+			TexturePresetLibrary::ApplyToLinkedTextures({ Copy });
 		}
 	}
 }
 
 void SMyTwoColumnWidget::SaveDirtyTexturesAndPresets()
 {
+	TEXTURE_MANAGER_SCOPE("SaveDirtyTexturesAndPresets");
 #if WITH_EDITOR
-	TArray<UPackage*> PackagesToSave;
-
-	// 1) Gather dirty texture packages
-	for (const FTextureItem& Item : AllTextureItems)
-	{
-		if (!Item.IsValid())
-		{
-			continue;
-		}
-
-		if (UTexture2D* Texture = Item.Get())
-		{
-			if (UPackage* Package = Texture->GetOutermost())
-			{
-				if (Package->IsDirty())
-				{
-					PackagesToSave.AddUnique(Package);
-				}
-			}
-		}
-	}
-
-	// 2) Gather dirty preset packages
-	for (const FPresetItem& Item : AllPresetItems)
-	{
-		if (!Item.IsValid())
-		{
-			continue;
-		}
-
-		if (UTexturePresetAsset* Preset = Item.Get())
-		{
-			if (UPackage* Package = Preset->GetOutermost())
-			{
-				if (Package->IsDirty())
-				{
-					PackagesToSave.AddUnique(Package);
-				}
-			}
-		}
-	}
+	const TArray<UPackage*> PackagesToSave = TextureManagerLists::GatherDirtyPackages(AllTextureAssets, AllPresetItems);
 
 	if (PackagesToSave.Num() == 0)
 	{
 		return;
 	}
 
+	FTextureManagerPhaseScope Phase(ETextureManagerPhase::Save);
 	FEditorFileUtils::PromptForCheckoutAndSave(
 		PackagesToSave,
 		/*bCheckDirty=*/false,
 		/*bPromptToSave=*/false);
+	TextureManagerMetrics::AddPackagesSaved(PackagesToSave.Num());
 #endif // WITH_EDITOR
 }
 
@@ -1888,17 +3412,10 @@ bool SMyTwoColumnWidget::BindWindowCloseEventOnce(float DeltaTime)
 
 void SMyTwoColumnWidget::OnParentWindowClosed(const TSharedRef<SWindow>& Window)
 {
+	// The scheduler keeps running after the window is gone
 	if (ActiveTab == ENavigationTab::Presets) {
-		if (SelectedPreset.Get()) {
-			auto Preset = SelectedPreset.Get();
-			if (Preset) {
-				for (auto Texture : Preset->Files) {
-					if (Texture) {
-						TexturePresetLibrary::ApplyToTexture(Preset, Texture);
-						Texture->PostEditChange();
-					}
-				}
-			}
+		if (UTexturePresetAsset* Preset = SelectedPreset.Get()) {
+			TexturePresetLibrary::ApplyToLinkedTextures({ Preset });
 		}
 	}
 	else {
@@ -1907,14 +3424,8 @@ void SMyTwoColumnWidget::OnParentWindowClosed(const TSharedRef<SWindow>& Window)
 			UTexturePresetUserData* UserData =
 				Cast<UTexturePresetUserData>(
 					PTexture->GetAssetUserDataOfClass(UTexturePresetUserData::StaticClass()));
-			UTexturePresetAsset* Preset = UserData ? UserData->AssignedPreset : nullptr;
-			if (Preset) {
-				for (auto Texture : Preset->Files) {
-					if (Texture) {
-						TexturePresetLibrary::ApplyToTexture(Preset, Texture);
-						Texture->PostEditChange();
-					}
-				}
+			if (UTexturePresetAsset* Preset = UserData ? UserData->AssignedPreset : nullptr) {
+				TexturePresetLibrary::ApplyToLinkedTextures({ Preset });
 			}
 		}
 	}
@@ -0,0 +1,231 @@
+#include "STextureManagerMetrics.h"
+
+#include "Misc/Paths.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/SHeaderRow.h"
+
+#define LOCTEXT_NAMESPACE "TextureManagerMetrics"
+
+namespace
+{
+	const FName ColumnName(TEXT("Name"));
+	const FName ColumnCount(TEXT("Count"));
+	const FName ColumnMean(TEXT("Mean"));
+	const FName ColumnP50(TEXT("P50"));
+	const FName ColumnP95(TEXT("P95"));
+	const FName ColumnP99(TEXT("P99"));
+	const FName ColumnMax(TEXT("Max"));
+	const FName ColumnLoaded(TEXT("Loaded"));
+	const FName ColumnSaved(TEXT("Saved"));
+
+	FText FormatMs(double Seconds)
+	{
+		FNumberFormattingOptions Options;
+		Options.MinimumFractionalDigits = 2;
+		Options.MaximumFractionalDigits = 2;
+		return FText::Format(LOCTEXT("Ms", "{0} ms"), FText::AsNumber(Seconds * 1000.0, &Options));
+	}
+
+	class SMetricsRow : public SMultiColumnTableRow<TSharedPtr<FTextureManagerLatencySummary>>
+	{
+	public:
+		SLATE_BEGIN_ARGS(SMetricsRow) {}
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable, TSharedPtr<FTextureManagerLatencySummary> InItem)
+		{
+			Item = InItem;
+			SMultiColumnTableRow::Construct(FSuperRowType::FArguments(), OwnerTable);
+		}
+
+		virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& Column) override
+		{
+			// Per operation for operations, in total for the Load / Save phases
+			const int64 Count = Item->bOperation ? FMath::Max<int64>(Item->Count, 1) : 1;
+
+			FText Text;
+			if (Column == ColumnName)
+			{
+				Text = Item->bOperation
+					? FText::FromString(Item->Name)
+					: FText::Format(LOCTEXT("PhaseName", "[{0}]"), FText::FromString(Item->Name));
+			}
+			else if (Column == ColumnCount)
+			{
+				Text = FText::AsNumber(Item->Count);
+			}
+			else if (Item->Count == 0)
+			{
+				// No samples yet: leave the times empty rather than show zeros
+			}
+			else if (Column == ColumnMean)
+			{
+				Text = FormatMs(Item->TotalSeconds / double(Item->Count));
+			}
+			else if (Column == ColumnP50)
+			{
+				Text = FormatMs(Item->P50Seconds);
+			}
+			else if (Column == ColumnP95)
+			{
+				Text = FormatMs(Item->P95Seconds);
+			}
+			else if (Column == ColumnP99)
+			{
+				Text = FormatMs(Item->P99Seconds);
+			}
+			else if (Column == ColumnMax)
+			{
+				Text = FormatMs(Item->MaxSeconds);
+			}
+			else if (Column == ColumnLoaded && Item->BytesLoaded > 0)
+			{
+				Text = FText::AsMemory(Item->BytesLoaded / Count);
+			}
+			else if (Column == ColumnSaved && Item->PackagesSaved > 0)
+			{
+				Text = FText::AsNumber(double(Item->PackagesSaved) / double(Count));
+			}
+
+			return SNew(STextBlock).Text(Text);
+		}
+
+	private:
+		TSharedPtr<FTextureManagerLatencySummary> Item;
+	};
+}
+
+const FName STextureManagerMetrics::TabId(TEXT("TextureManagerMetrics"));
+
+void STextureManagerMetrics::Construct(const FArguments& InArgs)
+{
+	ChildSlot
+		[
+			SNew(SBorder)
+				.Padding(4.f)
+				[
+					SNew(SVerticalBox)
+
+						+ SVerticalBox::Slot()
+						.AutoHeight()
+						.Padding(0.f, 4.f)
+						[
+							SNew(SHorizontalBox)
+								+ SHorizontalBox::Slot()
+								.FillWidth(1.f)
+								.VAlign(VAlign_Center)
+								[
+									SNew(STextBlock)
+										.Text(LOCTEXT("Summary", "Since editor start. [Phases] time each step; operations time the whole action, with bytes loaded and packages saved per run."))
+										.AutoWrapText(true)
+								]
+								+ SHorizontalBox::Slot()
+								.AutoWidth()
+								.Padding(4.f, 0.f)
+								[
+									SNew(SButton)
+										.Text(LOCTEXT("Reset", "Reset"))
+										.OnClicked(this, &STextureManagerMetrics::OnResetClicked)
+								]
+								+ SHorizontalBox::Slot()
+								.AutoWidth()
+								[
+									SNew(SButton)
+										.Text(LOCTEXT("Export", "Export CSV"))
+										.OnClicked(this, &STextureManagerMetrics::OnExportClicked)
+								]
+						]
+
+						+ SVerticalBox::Slot()
+						.FillHeight(1.f)
+						[
+							SAssignNew(ListView, SListView<FSummaryItem>)
+								.ListItemsSource(&Items)
+								.OnGenerateRow(this, &STextureManagerMetrics::GenerateRow)
+								.SelectionMode(ESelectionMode::None)
+								.HeaderRow
+								(
+									SNew(SHeaderRow)
+									+ SHeaderRow::Column(ColumnName).DefaultLabel(LOCTEXT("ColName", "Name")).FillWidth(2.f)
+									+ SHeaderRow::Column(ColumnCount).DefaultLabel(LOCTEXT("ColCount", "Count")).FillWidth(0.7f)
+									+ SHeaderRow::Column(ColumnMean).DefaultLabel(LOCTEXT("ColMean", "Mean")).FillWidth(1.f)
+									+ SHeaderRow::Column(ColumnP50).DefaultLabel(LOCTEXT("ColP50", "p50")).FillWidth(1.f)
+									+ SHeaderRow::Column(ColumnP95).DefaultLabel(LOCTEXT("ColP95", "p95")).FillWidth(1.f)
+									+ SHeaderRow::Column(ColumnP99).DefaultLabel(LOCTEXT("ColP99", "p99")).FillWidth(1.f)
+									+ SHeaderRow::Column(ColumnMax).DefaultLabel(LOCTEXT("ColMax", "Max")).FillWidth(1.f)
+									+ SHeaderRow::Column(ColumnLoaded).DefaultLabel(LOCTEXT("ColLoaded", "Loaded / Run")).FillWidth(1.f)
+									+ SHeaderRow::Column(ColumnSaved).DefaultLabel(LOCTEXT("ColSaved", "Saved / Run")).FillWidth(0.8f)
+								)
+						]
+				]
+		];
+
+	Rebuild();
+	RegisterActiveTimer(1.f, FWidgetActiveTimerDelegate::CreateSP(this, &STextureManagerMetrics::OnRefreshTimer));
+}
+
+TSharedRef<SDockTab> STextureManagerMetrics::SpawnTab(const FSpawnTabArgs& Args)
+{
+	return SNew(SDockTab)
+		.TabRole(ETabRole::NomadTab)
+		[
+			SNew(STextureManagerMetrics)
+		];
+}
+
+void STextureManagerMetrics::Rebuild()
+{
+	ShownRevision = TextureManagerMetrics::GetRevision();
+
+	Items.Reset();
+	for (const FTextureManagerLatencySummary& Summary : TextureManagerMetrics::GetSummaries())
+	{
+		Items.Add(MakeShared<FTextureManagerLatencySummary>(Summary));
+	}
+
+	if (ListView.IsValid())
+	{
+		ListView->RequestListRefresh();
+	}
+}
+
+EActiveTimerReturnType STextureManagerMetrics::OnRefreshTimer(double CurrentTime, float DeltaTime)
+{
+	if (TextureManagerMetrics::GetRevision() != ShownRevision)
+	{
+		Rebuild();
+	}
+	return EActiveTimerReturnType::Continue;
+}
+
+FReply STextureManagerMetrics::OnResetClicked()
+{
+	TextureManagerMetrics::Reset();
+	Rebuild();
+	return FReply::Handled();
+}
+
+FReply STextureManagerMetrics::OnExportClicked()
+{
+	const FString CsvPath = FPaths::ProjectSavedDir() / TEXT("TextureManager") / TEXT("Metrics.csv");
+	if (TextureManagerMetrics::SaveCsv(CsvPath))
+	{
+		UE_LOG(LogTemp, Display, TEXT("Texture Manager metrics written to %s"), *FPaths::ConvertRelativePathToFull(CsvPath));
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Could not write %s"), *CsvPath);
+	}
+	return FReply::Handled();
+}
+
+TSharedRef<ITableRow> STextureManagerMetrics::GenerateRow(FSummaryItem Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SMetricsRow, OwnerTable, Item);
+}
+
+#undef LOCTEXT_NAMESPACE
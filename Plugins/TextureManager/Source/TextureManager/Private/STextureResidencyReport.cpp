@@ -0,0 +1,358 @@
+#include "STextureResidencyReport.h"
+
+#include "Framework/Application/SlateApplication.h"
+#include "Misc/Paths.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/SWindow.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SSegmentedControl.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Layout/SWidgetSwitcher.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/SHeaderRow.h"
+
+#define LOCTEXT_NAMESPACE "TextureResidencyReport"
+
+namespace
+{
+	const FName ColumnLabel(TEXT("Label"));
+	const FName ColumnPreset(TEXT("Preset"));
+	const FName ColumnSize(TEXT("Size"));
+	const FName ColumnTextures(TEXT("Textures"));
+	const FName ColumnPinned(TEXT("Pinned"));
+	const FName ColumnResident(TEXT("Resident"));
+	const FName ColumnPinnedExtra(TEXT("PinnedExtra"));
+	const FName ColumnStreamed(TEXT("Streamed"));
+
+	class SResidencyTotalRow : public SMultiColumnTableRow<TSharedPtr<FTextureResidencyTotal>>
+	{
+	public:
+		SLATE_BEGIN_ARGS(SResidencyTotalRow) {}
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable, TSharedPtr<FTextureResidencyTotal> InItem)
+		{
+			Item = InItem;
+			SMultiColumnTableRow::Construct(FSuperRowType::FArguments(), OwnerTable);
+		}
+
+		virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+		{
+			FText Text;
+			if (ColumnName == ColumnLabel)
+			{
+				Text = FText::FromString(Item->Label);
+			}
+			else if (ColumnName == ColumnTextures)
+			{
+				Text = FText::AsNumber(Item->NumTextures);
+			}
+			else if (ColumnName == ColumnPinned)
+			{
+				Text = FText::AsNumber(Item->NumPinned);
+			}
+			else if (ColumnName == ColumnResident)
+			{
+				Text = FText::AsMemory(Item->ResidentBytes);
+			}
+			else if (ColumnName == ColumnPinnedExtra)
+			{
+				Text = FText::AsMemory(Item->PinnedExtraBytes);
+			}
+			else if (ColumnName == ColumnStreamed)
+			{
+				Text = FText::AsMemory(Item->StreamedBytes);
+			}
+
+			return SNew(STextBlock).Text(Text);
+		}
+
+	private:
+		TSharedPtr<FTextureResidencyTotal> Item;
+	};
+
+	class SResidencyEntryRow : public SMultiColumnTableRow<TSharedPtr<FTextureResidencyEntry>>
+	{
+	public:
+		SLATE_BEGIN_ARGS(SResidencyEntryRow) {}
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable, TSharedPtr<FTextureResidencyEntry> InItem)
+		{
+			Item = InItem;
+			SMultiColumnTableRow::Construct(FSuperRowType::FArguments(), OwnerTable);
+		}
+
+		virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+		{
+			FText Text;
+			if (ColumnName == ColumnLabel)
+			{
+				Text = FText::FromString(Item->AssetName);
+			}
+			else if (ColumnName == ColumnPreset)
+			{
+				Text = Item->PresetName.IsNone() ? FText::FromString(TEXT("<NONE>")) : FText::FromName(Item->PresetName);
+			}
+			else if (ColumnName == ColumnSize)
+			{
+				Text = FText::FromString(FString::Printf(TEXT("%dx%d"), Item->Estimate.SizeX, Item->Estimate.SizeY));
+			}
+			else if (ColumnName == ColumnPinned)
+			{
+				Text = Item->bPinned ? LOCTEXT("Yes", "Yes") : FText::GetEmpty();
+			}
+			else if (ColumnName == ColumnResident)
+			{
+				Text = FText::AsMemory(Item->Estimate.ResidentBytes);
+			}
+			else if (ColumnName == ColumnPinnedExtra)
+			{
+				Text = FText::AsMemory(Item->PinnedExtraBytes);
+			}
+			else if (ColumnName == ColumnStreamed)
+			{
+				Text = FText::AsMemory(Item->Estimate.StreamedBytes);
+			}
+
+			return SNew(STextBlock).Text(Text);
+		}
+
+	private:
+		TSharedPtr<FTextureResidencyEntry> Item;
+	};
+}
+
+void STextureResidencyReport::Construct(const FArguments& InArgs)
+{
+	ChildSlot
+		[
+			SNew(SBorder)
+				.Padding(4.f)
+				[
+					SNew(SVerticalBox)
+
+						// Totals and pool
+						+ SVerticalBox::Slot()
+						.AutoHeight()
+						.Padding(0.f, 2.f)
+						[
+							SNew(STextBlock)
+								.Text(this, &STextureResidencyReport::GetSummaryText)
+								.AutoWrapText(true)
+						]
+
+						// Pool / LOD group findings
+						+ SVerticalBox::Slot()
+						.AutoHeight()
+						.Padding(0.f, 2.f)
+						[
+							SNew(STextBlock)
+								.Text(this, &STextureResidencyReport::GetWarningsText)
+								.ColorAndOpacity(FLinearColor(1.f, 0.6f, 0.2f))
+								.AutoWrapText(true)
+						]
+
+						+ SVerticalBox::Slot()
+						.AutoHeight()
+						.Padding(0.f, 4.f)
+						[
+							SNew(SHorizontalBox)
+								+ SHorizontalBox::Slot()
+								.FillWidth(1.f)
+								[
+									SNew(SSegmentedControl<EResidencyReportView>)
+										.Value_Lambda([this]() { return View; })
+										.OnValueChanged(this, &STextureResidencyReport::OnViewChanged)
+										+ SSegmentedControl<EResidencyReportView>::Slot(EResidencyReportView::ByPreset)
+										.Text(LOCTEXT("ByPreset", "By Preset"))
+										+ SSegmentedControl<EResidencyReportView>::Slot(EResidencyReportView::ByGroup)
+										.Text(LOCTEXT("ByGroup", "By Texture Group"))
+										+ SSegmentedControl<EResidencyReportView>::Slot(EResidencyReportView::Textures)
+										.Text(LOCTEXT("Textures", "Worst Offenders"))
+								]
+								+ SHorizontalBox::Slot()
+								.AutoWidth()
+								.Padding(4.f, 0.f)
+								[
+									SNew(SButton)
+										.Text(LOCTEXT("Refresh", "Refresh"))
+										.OnClicked(this, &STextureResidencyReport::OnRefreshClicked)
+								]
+								+ SHorizontalBox::Slot()
+								.AutoWidth()
+								[
+									SNew(SButton)
+										.Text(LOCTEXT("Export", "Export CSV"))
+										.OnClicked(this, &STextureResidencyReport::OnExportClicked)
+								]
+						]
+
+						+ SVerticalBox::Slot()
+						.FillHeight(1.f)
+						[
+							SNew(SWidgetSwitcher)
+								.WidgetIndex_Lambda([this]()
+									{
+										return (View == EResidencyReportView::Textures) ? 1 : 0;
+									})
+
+								+ SWidgetSwitcher::Slot()
+								[
+									SAssignNew(TotalsListView, SListView<FTotalItem>)
+										.ListItemsSource(&TotalItems)
+										.OnGenerateRow(this, &STextureResidencyReport::GenerateTotalRow)
+										.SelectionMode(ESelectionMode::None)
+										.HeaderRow
+										(
+											SNew(SHeaderRow)
+											+ SHeaderRow::Column(ColumnLabel).DefaultLabel(LOCTEXT("ColName", "Name")).FillWidth(2.f)
+											+ SHeaderRow::Column(ColumnTextures).DefaultLabel(LOCTEXT("ColTextures", "Textures")).FillWidth(0.6f)
+											+ SHeaderRow::Column(ColumnPinned).DefaultLabel(LOCTEXT("ColPinned", "Pinned")).FillWidth(0.6f)
+											+ SHeaderRow::Column(ColumnResident).DefaultLabel(LOCTEXT("ColResident", "Resident")).FillWidth(1.f)
+											+ SHeaderRow::Column(ColumnPinnedExtra).DefaultLabel(LOCTEXT("ColPinnedExtra", "Pinned Extra")).FillWidth(1.f)
+											+ SHeaderRow::Column(ColumnStreamed).DefaultLabel(LOCTEXT("ColStreamed", "Streamed")).FillWidth(1.f)
+										)
+								]
+
+								+ SWidgetSwitcher::Slot()
+								[
+									SAssignNew(EntriesListView, SListView<FEntryItem>)
+										.ListItemsSource(&EntryItems)
+										.OnGenerateRow(this, &STextureResidencyReport::GenerateEntryRow)
+										.SelectionMode(ESelectionMode::None)
+										.HeaderRow
+										(
+											SNew(SHeaderRow)
+											+ SHeaderRow::Column(ColumnLabel).DefaultLabel(LOCTEXT("ColTexture", "Texture")).FillWidth(2.f)
+											+ SHeaderRow::Column(ColumnPreset).DefaultLabel(LOCTEXT("ColPreset", "Preset")).FillWidth(1.2f)
+											+ SHeaderRow::Column(ColumnSize).DefaultLabel(LOCTEXT("ColSize", "Size")).FillWidth(0.8f)
+											+ SHeaderRow::Column(ColumnPinned).DefaultLabel(LOCTEXT("ColPinned", "Pinned")).FillWidth(0.5f)
+											+ SHeaderRow::Column(ColumnResident).DefaultLabel(LOCTEXT("ColResident", "Resident")).FillWidth(1.f)
+											+ SHeaderRow::Column(ColumnPinnedExtra).DefaultLabel(LOCTEXT("ColPinnedExtra", "Pinned Extra")).FillWidth(1.f)
+											+ SHeaderRow::Column(ColumnStreamed).DefaultLabel(LOCTEXT("ColStreamed", "Streamed")).FillWidth(1.f)
+										)
+								]
+						]
+				]
+		];
+
+	Rebuild();
+}
+
+void STextureResidencyReport::OpenWindow()
+{
+	TSharedRef<SWindow> Window = SNew(SWindow)
+		.Title(LOCTEXT("WindowTitle", "Texture Residency Report"))
+		.ClientSize(FVector2D(900.f, 600.f))
+		.SupportsMinimize(false)
+		[
+			SNew(STextureResidencyReport)
+		];
+
+	FSlateApplication::Get().AddWindow(Window);
+}
+
+void STextureResidencyReport::Rebuild()
+{
+	Report = TextureResidencyReport::Build();
+	OnViewChanged(View);
+}
+
+void STextureResidencyReport::OnViewChanged(EResidencyReportView NewView)
+{
+	View = NewView;
+
+	TotalItems.Reset();
+	EntryItems.Reset();
+
+	if (View == EResidencyReportView::Textures)
+	{
+		// Only textures that actually hold memory resident
+		for (const FTextureResidencyEntry& Entry : Report.Entries)
+		{
+			if (Entry.Estimate.ResidentBytes > 0)
+			{
+				EntryItems.Add(MakeShared<FTextureResidencyEntry>(Entry));
+			}
+		}
+	}
+	else
+	{
+		const TArray<FTextureResidencyTotal>& Totals =
+			(View == EResidencyReportView::ByPreset) ? Report.ByPreset : Report.ByGroup;
+
+		for (const FTextureResidencyTotal& Total : Totals)
+		{
+			TotalItems.Add(MakeShared<FTextureResidencyTotal>(Total));
+		}
+	}
+
+	if (TotalsListView.IsValid())
+	{
+		TotalsListView->RequestListRefresh();
+	}
+	if (EntriesListView.IsValid())
+	{
+		EntriesListView->RequestListRefresh();
+	}
+}
+
+FText STextureResidencyReport::GetSummaryText() const
+{
+	const FText Summary = FText::Format(
+		LOCTEXT("Summary", "{0} textures, {1} pinned: {2} always resident ({3} of it from pinning), {4} streamed"),
+		FText::AsNumber(Report.Total.NumTextures),
+		FText::AsNumber(Report.Total.NumPinned),
+		FText::AsMemory(Report.Total.ResidentBytes),
+		FText::AsMemory(Report.Total.PinnedExtraBytes),
+		FText::AsMemory(Report.Total.StreamedBytes));
+
+	if (Report.PoolSizeBytes <= 0)
+	{
+		return Summary;
+	}
+
+	return FText::Format(
+		LOCTEXT("SummaryPool", "{0}\nStreaming pool: {1} ({2} used by resident textures)"),
+		Summary,
+		FText::AsMemory(Report.PoolSizeBytes),
+		FText::AsPercent(double(Report.Total.ResidentBytes) / double(Report.PoolSizeBytes)));
+}
+
+FText STextureResidencyReport::GetWarningsText() const
+{
+	return FText::FromString(FString::Join(Report.Warnings, TEXT("\n")));
+}
+
+FReply STextureResidencyReport::OnRefreshClicked()
+{
+	Rebuild();
+	return FReply::Handled();
+}
+
+FReply STextureResidencyReport::OnExportClicked()
+{
+	const FString CsvPath = FPaths::ProjectSavedDir() / TEXT("TextureManager") / TEXT("ResidencyReport.csv");
+	if (TextureResidencyReport::SaveCsv(Report, CsvPath))
+	{
+		UE_LOG(LogTemp, Display, TEXT("Residency report written to %s"), *FPaths::ConvertRelativePathToFull(CsvPath));
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Could not write %s"), *CsvPath);
+	}
+	return FReply::Handled();
+}
+
+TSharedRef<ITableRow> STextureResidencyReport::GenerateTotalRow(FTotalItem Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SResidencyTotalRow, OwnerTable, Item);
+}
+
+TSharedRef<ITableRow> STextureResidencyReport::GenerateEntryRow(FEntryItem Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SResidencyEntryRow, OwnerTable, Item);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,55 @@
+#include "TextureManagerBenchmark.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Small enough for every CI run; the commandlet takes the large scenarios
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTextureManagerBenchmarkScenarioTest,
+	"TextureManager.Benchmark.Scenario",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FTextureManagerBenchmarkScenarioTest::RunTest(const FString& Parameters)
+{
+	FTextureManagerBenchmarkScenario Scenario;
+	Scenario.NumTextures = 1000;
+	Scenario.NumPresets = 10;
+
+	const TArray<FTextureManagerBenchmarkResult> Results = TextureManagerBenchmark::RunScenario(Scenario, 3, 1);
+	TestTrue(TEXT("Scenario produced results"), Results.Num() > 0);
+
+	for (const FTextureManagerBenchmarkResult& Result : Results)
+	{
+		TestEqual(*FString::Printf(TEXT("%s ran every iteration"), *Result.Name), Result.NumIterations, 3);
+		AddInfo(FString::Printf(TEXT("%s %s: median %.2f ms"), *Result.Scenario, *Result.Name, Result.MedianMs));
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTextureManagerBenchmarkMicroTest,
+	"TextureManager.Benchmark.Micro",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FTextureManagerBenchmarkMicroTest::RunTest(const FString& Parameters)
+{
+	const TArray<FTextureManagerBenchmarkResult> Results = TextureManagerBenchmark::RunMicro({ 100, 1000 }, 3);
+	TestTrue(TEXT("Microbenchmarks produced results"), Results.Num() > 0);
+
+	for (const FString& Line : TextureManagerBenchmark::DescribeScaling(Results))
+	{
+		AddInfo(Line);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTextureManagerPreviewPoolLeakTest,
+	"TextureManager.Benchmark.PreviewPoolLeak",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FTextureManagerPreviewPoolLeakTest::RunTest(const FString& Parameters)
+{
+	TestTrue(TEXT("Preview pool does not grow over 1000 selections"), TextureManagerBenchmark::CheckPreviewPoolLeak(1000));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
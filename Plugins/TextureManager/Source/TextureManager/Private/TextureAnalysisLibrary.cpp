@@ -0,0 +1,873 @@
+#include "TextureAnalysisLibrary.h"
+
+#include "TexturePresetAsset.h"
+#include "TexturePresetLibrary.h"
+#include "TextureMemoryEstimator.h"
+
+#include "Engine/Texture2D.h"
+#include "ImageCore.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Math/VectorRegister.h"
+#include "Tasks/Task.h"
+#include "UObject/StrongObjectPtr.h"
+
+#include <atomic>
+
+namespace
+{
+	// Pixels per ParallelFor work item
+	constexpr int64 AlphaChunkPixels = 64 * 1024;
+
+	// Game thread only; keyed by package, validated by source id
+	struct FCachedAlpha
+	{
+		FGuid SourceId;
+		FTextureAlphaInfo Info;
+	};
+	TMap<FName, FCachedAlpha> GAlphaCache;
+
+	struct FCachedContent
+	{
+		FGuid SourceId;
+		FTextureContentInfo Info;
+	};
+	TMap<FName, FCachedContent> GContentCache;
+
+	// Longest side of the copy the content statistics run on
+	constexpr int32 ContentSampleSize = 256;
+
+	// Rows of the downsampled image per ParallelFor work item
+	constexpr int32 ContentChunkRows = 16;
+
+	FName GetCacheKey(const UTexture2D* Texture)
+	{
+		return Texture->GetOutermost()->GetFName();
+	}
+
+	FGuid GetSourceId(const UTexture2D* Texture)
+	{
+#if WITH_EDITOR
+		return Texture->Source.GetId();
+#else
+		return FGuid();
+#endif
+	}
+
+	FTextureAlphaInfo ClassifyBGRA8(const uint8* Pixels, int64 NumPixels)
+	{
+		FTextureAlphaInfo Info;
+		Info.Usage = ETextureAlphaUsage::Constant;
+		Info.ConstantAlpha = Pixels[3];
+
+		const int32 NumChunks = int32((NumPixels + AlphaChunkPixels - 1) / AlphaChunkPixels);
+		std::atomic<bool> bVaries{ false };
+
+		ParallelFor(NumChunks, [&](int32 Chunk)
+			{
+				if (bVaries.load(std::memory_order_relaxed))
+				{
+					return;
+				}
+
+				const int64 Begin = Chunk * AlphaChunkPixels;
+				const int64 End = FMath::Min(Begin + AlphaChunkPixels, NumPixels);
+
+				// 4 pixels per register: keep only the alpha byte and compare
+				const VectorRegister4Int AlphaMask = VectorIntSet1(static_cast<int32>(0xFF000000u));
+				const VectorRegister4Int Expected = VectorIntSet1(static_cast<int32>(uint32(Info.ConstantAlpha) << 24));
+
+				int64 Index = Begin;
+				for (; Index + 16 <= End; Index += 16)
+				{
+					const uint8* Block = Pixels + Index * 4;
+
+					VectorRegister4Int Equal = VectorIntCompareEQ(VectorIntAnd(VectorIntLoad(Block), AlphaMask), Expected);
+					Equal = VectorIntAnd(Equal, VectorIntCompareEQ(VectorIntAnd(VectorIntLoad(Block + 16), AlphaMask), Expected));
+					Equal = VectorIntAnd(Equal, VectorIntCompareEQ(VectorIntAnd(VectorIntLoad(Block + 32), AlphaMask), Expected));
+					Equal = VectorIntAnd(Equal, VectorIntCompareEQ(VectorIntAnd(VectorIntLoad(Block + 48), AlphaMask), Expected));
+
+					if (VectorMaskBits(VectorCastIntToFloat(Equal)) != 0xF)
+					{
+						bVaries = true;
+						return;
+					}
+				}
+
+				for (; Index < End; ++Index)
+				{
+					if (Pixels[Index * 4 + 3] != Info.ConstantAlpha)
+					{
+						bVaries = true;
+						return;
+					}
+				}
+			});
+
+		if (bVaries)
+		{
+			Info.Usage = ETextureAlphaUsage::Used;
+		}
+		return Info;
+	}
+
+	FTextureAlphaInfo ClassifyRGBA32F(const float* Pixels, int64 NumPixels)
+	{
+		const float FirstAlpha = Pixels[3];
+
+		FTextureAlphaInfo Info;
+		Info.Usage = ETextureAlphaUsage::Constant;
+		Info.ConstantAlpha = uint8(FMath::RoundToInt(FMath::Clamp(FirstAlpha, 0.f, 1.f) * 255.f));
+
+		const int32 NumChunks = int32((NumPixels + AlphaChunkPixels - 1) / AlphaChunkPixels);
+		std::atomic<bool> bVaries{ false };
+
+		ParallelFor(NumChunks, [&](int32 Chunk)
+			{
+				if (bVaries.load(std::memory_order_relaxed))
+				{
+					return;
+				}
+
+				const int64 Begin = Chunk * AlphaChunkPixels;
+				const int64 End = FMath::Min(Begin + AlphaChunkPixels, NumPixels);
+
+				// One pixel per register; anything within half an 8 bit step counts as equal
+				const VectorRegister4Float Expected = VectorSetFloat1(FirstAlpha);
+				const VectorRegister4Float Tolerance = VectorSetFloat1(0.5f / 255.f);
+
+				int64 Index = Begin;
+				for (; Index + 4 <= End; Index += 4)
+				{
+					const float* Block = Pixels + Index * 4;
+
+					VectorRegister4Float Outside = VectorCompareGT(VectorAbs(VectorSubtract(VectorLoad(Block), Expected)), Tolerance);
+					Outside = VectorBitwiseOr(Outside, VectorCompareGT(VectorAbs(VectorSubtract(VectorLoad(Block + 4), Expected)), Tolerance));
+					Outside = VectorBitwiseOr(Outside, VectorCompareGT(VectorAbs(VectorSubtract(VectorLoad(Block + 8), Expected)), Tolerance));
+					Outside = VectorBitwiseOr(Outside, VectorCompareGT(VectorAbs(VectorSubtract(VectorLoad(Block + 12), Expected)), Tolerance));
+
+					// Bit 3 = alpha lane
+					if (VectorMaskBits(Outside) & 0x8)
+					{
+						bVaries = true;
+						return;
+					}
+				}
+
+				for (; Index < End; ++Index)
+				{
+					if (FMath::Abs(Pixels[Index * 4 + 3] - FirstAlpha) > 0.5f / 255.f)
+					{
+						bVaries = true;
+						return;
+					}
+				}
+			});
+
+		if (bVaries)
+		{
+			Info.Usage = ETextureAlphaUsage::Used;
+		}
+		return Info;
+	}
+
+	// Per-chunk sums, reduced after the ParallelFor
+	struct FContentStats
+	{
+		float Sum[4] = {};
+		float SumSq[4] = {};
+		float SumCross[4] = {};	// rg, gb, br
+		float Extreme[4] = {};	// per channel count of values near 0 or 1
+		float UnitLengthError = 0.f;
+		int64 BlueDominant = 0;
+		int64 Gray = 0;
+		int64 Num = 0;
+
+		void Add(const FContentStats& Other)
+		{
+			for (int32 Channel = 0; Channel < 4; ++Channel)
+			{
+				Sum[Channel] += Other.Sum[Channel];
+				SumSq[Channel] += Other.SumSq[Channel];
+				SumCross[Channel] += Other.SumCross[Channel];
+				Extreme[Channel] += Other.Extreme[Channel];
+			}
+			UnitLengthError += Other.UnitLengthError;
+			BlueDominant += Other.BlueDominant;
+			Gray += Other.Gray;
+			Num += Other.Num;
+		}
+	};
+
+	// One RGBA32F pixel per register
+	FContentStats AccumulateContent(const float* Pixels, int64 Begin, int64 End)
+	{
+		const VectorRegister4Float One = VectorOne();
+		const VectorRegister4Float Two = VectorSetFloat1(2.f);
+		const VectorRegister4Float Low = VectorSetFloat1(0.05f);
+		const VectorRegister4Float High = VectorSetFloat1(0.95f);
+		const VectorRegister4Float GrayTolerance = VectorSetFloat1(2.f / 255.f);
+
+		VectorRegister4Float Sum = VectorZero();
+		VectorRegister4Float SumSq = VectorZero();
+		VectorRegister4Float SumCross = VectorZero();
+		VectorRegister4Float Extreme = VectorZero();
+		VectorRegister4Float UnitLengthError = VectorZero();
+
+		FContentStats Stats;
+
+		for (int64 Index = Begin; Index < End; ++Index)
+		{
+			const VectorRegister4Float Color = VectorLoad(Pixels + Index * 4);
+			const VectorRegister4Float Rotated = VectorSwizzle(Color, 1, 2, 0, 3); // g b r a
+
+			Sum = VectorAdd(Sum, Color);
+			SumSq = VectorMultiplyAdd(Color, Color, SumSq);
+			SumCross = VectorMultiplyAdd(Color, Rotated, SumCross);
+
+			// All-ones compare mask AND 1.0f = 1.0f per matching lane
+			const VectorRegister4Float IsExtreme = VectorBitwiseOr(VectorCompareLE(Color, Low), VectorCompareGE(Color, High));
+			Extreme = VectorAdd(Extreme, VectorBitwiseAnd(IsExtreme, One));
+
+			// Decode as a tangent space normal: n = 2c - 1, error = | |n|^2 - 1 |
+			const VectorRegister4Float Normal = VectorSubtract(VectorMultiply(Color, Two), One);
+			UnitLengthError = VectorAdd(UnitLengthError, VectorAbs(VectorSubtract(VectorDot3(Normal, Normal), One)));
+
+			// b > r and b > g
+			Stats.BlueDominant += (VectorMaskBits(VectorCompareGT(VectorReplicate(Color, 2), Color)) & 0x3) == 0x3;
+
+			// |r-g|, |g-b|, |b-r| all within tolerance
+			Stats.Gray += (VectorMaskBits(VectorCompareGT(VectorAbs(VectorSubtract(Color, Rotated)), GrayTolerance)) & 0x7) == 0;
+		}
+
+		VectorStore(Sum, Stats.Sum);
+		VectorStore(SumSq, Stats.SumSq);
+		VectorStore(SumCross, Stats.SumCross);
+		VectorStore(Extreme, Stats.Extreme);
+		Stats.UnitLengthError = VectorGetComponent(UnitLengthError, 0);
+		Stats.Num = End - Begin;
+		return Stats;
+	}
+
+#if WITH_EDITOR
+	bool SourceFormatHasAlpha(ETextureSourceFormat Format)
+	{
+		switch (Format)
+		{
+		case TSF_G8:
+		case TSF_G16:
+		case TSF_R16F:
+		case TSF_R32F:
+		case TSF_BGRE8: // the fourth byte is a shared exponent
+			return false;
+		default:
+			return true;
+		}
+	}
+#endif
+
+	// Safe to call from a worker as long as the texture is kept alive
+	FTextureAlphaInfo ClassifySource(UTexture2D* Texture)
+	{
+#if WITH_EDITOR
+		if (!Texture || !Texture->Source.IsValid())
+		{
+			return FTextureAlphaInfo();
+		}
+
+		if (!SourceFormatHasAlpha(Texture->Source.GetFormat()))
+		{
+			FTextureAlphaInfo Info;
+			Info.Usage = ETextureAlphaUsage::Absent;
+			return Info;
+		}
+
+		FImage Image;
+		if (!Texture->Source.GetMipImage(Image, 0, 0, 0))
+		{
+			return FTextureAlphaInfo();
+		}
+
+		return TextureAnalysisLibrary::ClassifyAlpha(Image);
+#else
+		return FTextureAlphaInfo();
+#endif
+	}
+
+	// Decode once, classify alpha at full resolution and content on a small copy
+	FTextureContentInfo AnalyzeSource(UTexture2D* Texture)
+	{
+#if WITH_EDITOR
+		if (!Texture || !Texture->Source.IsValid())
+		{
+			return FTextureContentInfo();
+		}
+
+		FImage Image;
+		if (!Texture->Source.GetMipImage(Image, 0, 0, 0))
+		{
+			return FTextureContentInfo();
+		}
+
+		FTextureContentInfo Info = TextureAnalysisLibrary::ClassifyContent(Image);
+		if (SourceFormatHasAlpha(Texture->Source.GetFormat()))
+		{
+			Info.Alpha = TextureAnalysisLibrary::ClassifyAlpha(Image);
+		}
+		else
+		{
+			Info.Alpha.Usage = ETextureAlphaUsage::Absent;
+		}
+		return Info;
+#else
+		return FTextureContentInfo();
+#endif
+	}
+}
+
+namespace TextureAnalysisLibrary
+{
+	FTextureAlphaInfo ClassifyAlpha(const FImage& Image)
+	{
+		FTextureAlphaInfo Info;
+
+		const int64 NumPixels = Image.GetNumPixels();
+		if (NumPixels <= 0)
+		{
+			return Info;
+		}
+
+		switch (Image.Format)
+		{
+		case ERawImageFormat::G8:
+		case ERawImageFormat::G16:
+		case ERawImageFormat::R16F:
+		case ERawImageFormat::R32F:
+		case ERawImageFormat::BGRE8:
+			Info.Usage = ETextureAlphaUsage::Absent;
+			return Info;
+
+		case ERawImageFormat::BGRA8:
+			return ClassifyBGRA8(Image.RawData.GetData(), NumPixels);
+
+		case ERawImageFormat::RGBA32F:
+			return ClassifyRGBA32F(reinterpret_cast<const float*>(Image.RawData.GetData()), NumPixels);
+
+		default:
+		{
+			// RGBA16 / RGBA16F: widen to float rather than lose precision in 8 bit
+			FImage Converted;
+			Image.CopyTo(Converted, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+			return ClassifyRGBA32F(reinterpret_cast<const float*>(Converted.RawData.GetData()), NumPixels);
+		}
+		}
+	}
+
+	FTextureAlphaInfo FindAlphaUsage(const UTexture2D* Texture)
+	{
+		if (!Texture)
+		{
+			return FTextureAlphaInfo();
+		}
+
+		const FCachedAlpha* Cached = GAlphaCache.Find(GetCacheKey(Texture));
+		if (!Cached || Cached->SourceId != GetSourceId(Texture))
+		{
+			return FTextureAlphaInfo();
+		}
+
+		return Cached->Info;
+	}
+
+	FTextureAlphaInfo AnalyzeAlphaUsage(UTexture2D* Texture)
+	{
+		check(IsInGameThread());
+
+		if (!Texture)
+		{
+			return FTextureAlphaInfo();
+		}
+
+		FTextureAlphaInfo Info = FindAlphaUsage(Texture);
+		if (Info.Usage != ETextureAlphaUsage::Unknown)
+		{
+			return Info;
+		}
+
+		Info = ClassifySource(Texture);
+		if (Info.Usage != ETextureAlphaUsage::Unknown)
+		{
+			GAlphaCache.Add(GetCacheKey(Texture), { GetSourceId(Texture), Info });
+		}
+		return Info;
+	}
+
+	void AnalyzeAlphaUsageAsync(const TArray<UTexture2D*>& Textures, TFunction<void()> OnComplete)
+	{
+		check(IsInGameThread());
+
+		struct FJob
+		{
+			TArray<TStrongObjectPtr<UTexture2D>> Textures;
+			TArray<FGuid> SourceIds;
+			TArray<FTextureAlphaInfo> Results;
+		};
+
+		TSharedRef<FJob, ESPMode::ThreadSafe> Job = MakeShared<FJob, ESPMode::ThreadSafe>();
+
+		for (UTexture2D* Texture : Textures)
+		{
+			if (Texture && FindAlphaUsage(Texture).Usage == ETextureAlphaUsage::Unknown)
+			{
+				Job->Textures.Emplace(Texture);
+				Job->SourceIds.Add(GetSourceId(Texture));
+			}
+		}
+
+		if (Job->Textures.Num() == 0)
+		{
+			if (OnComplete)
+			{
+				OnComplete();
+			}
+			return;
+		}
+
+		Job->Results.SetNum(Job->Textures.Num());
+
+		UE::Tasks::Launch(UE_SOURCE_LOCATION,
+			[Job, OnComplete = MoveTemp(OnComplete)]() mutable
+			{
+				// Each classification already spreads over all cores
+				for (int32 Index = 0; Index < Job->Textures.Num(); ++Index)
+				{
+					Job->Results[Index] = ClassifySource(Job->Textures[Index].Get());
+				}
+
+				AsyncTask(ENamedThreads::GameThread, [Job, OnComplete = MoveTemp(OnComplete)]()
+					{
+						for (int32 Index = 0; Index < Job->Textures.Num(); ++Index)
+						{
+							const UTexture2D* Texture = Job->Textures[Index].Get();
+							if (Texture && Job->Results[Index].Usage != ETextureAlphaUsage::Unknown)
+							{
+								GAlphaCache.Add(GetCacheKey(Texture), { Job->SourceIds[Index], Job->Results[Index] });
+							}
+						}
+
+						// Strong references must be released on the game thread
+						Job->Textures.Empty();
+
+						if (OnComplete)
+						{
+							OnComplete();
+						}
+					});
+			},
+			UE::Tasks::ETaskPriority::BackgroundNormal);
+	}
+
+	FText AlphaUsageToText(const FTextureAlphaInfo& Info)
+	{
+		switch (Info.Usage)
+		{
+		case ETextureAlphaUsage::Absent:
+			return NSLOCTEXT("TextureManager", "AlphaAbsent", "No alpha channel");
+		case ETextureAlphaUsage::Constant:
+			return FText::Format(
+				NSLOCTEXT("TextureManager", "AlphaConstant", "Constant alpha ({0})"),
+				FText::AsNumber(Info.ConstantAlpha));
+		case ETextureAlphaUsage::Used:
+			return NSLOCTEXT("TextureManager", "AlphaUsed", "Alpha used");
+		default:
+			return NSLOCTEXT("TextureManager", "AlphaUnknown", "Alpha not analyzed");
+		}
+	}
+
+	int64 EstimateAlphaSavings(const UTexture2D* Texture)
+	{
+		if (!Texture || Texture->CompressionNoAlpha)
+		{
+			return 0;
+		}
+
+		// Default with alpha is BC3 (8 bpp) and BC7 is 8 bpp either way;
+		// both drop to BC1 (4 bpp) once alpha is gone
+		FTextureMemoryInputs Inputs = TextureMemoryEstimator::MakeInputs(Texture, TextureMemoryEstimator::GetTextureSettings(Texture));
+		if (!Inputs.bHasAlpha && Inputs.Settings.CompressionSettings != TC_BC7)
+		{
+			return 0;
+		}
+
+		const int64 Current = TextureMemoryEstimator::Estimate(Inputs).GetTotalBytes();
+
+		Inputs.bHasAlpha = false;
+		if (Inputs.Settings.CompressionSettings == TC_BC7)
+		{
+			Inputs.Settings.CompressionSettings = TC_Default;
+		}
+
+		return FMath::Max<int64>(Current - TextureMemoryEstimator::Estimate(Inputs).GetTotalBytes(), 0);
+	}
+
+	UTexturePresetAsset* SuggestPresetWithoutAlpha(
+		const UTexture2D* Texture,
+		const TArray<TWeakObjectPtr<UTexturePresetAsset>>& Presets)
+	{
+		if (!Texture)
+		{
+			return nullptr;
+		}
+
+		UTexturePresetAsset* Best = nullptr;
+		int32 BestScore = 0;
+
+		for (const TWeakObjectPtr<UTexturePresetAsset>& Item : Presets)
+		{
+			UTexturePresetAsset* Preset = Item.Get();
+			if (!Preset)
+			{
+				continue;
+			}
+
+			const FTexturePresetSettings Settings = TexturePresetLibrary::ResolveSettings(Preset);
+			if (Settings.bUseAlpha)
+			{
+				continue;
+			}
+
+			// Colour space has to match or the texture would look different
+			if (Settings.bSRGB != Texture->SRGB)
+			{
+				continue;
+			}
+
+			// Same compression, or the plain default that falls back to BC1
+			if (Settings.CompressionSettings != Texture->CompressionSettings
+				&& Settings.CompressionSettings != TC_Default)
+			{
+				continue;
+			}
+
+			int32 Score = 1;
+			Score += (Settings.TextureGroup == Texture->LODGroup) ? 4 : 0;
+			Score += (Settings.CompressionSettings == Texture->CompressionSettings) ? 2 : 0;
+			Score += (Settings.MipGenSettings == Texture->MipGenSettings) ? 1 : 0;
+
+			if (Score > BestScore)
+			{
+				BestScore = Score;
+				Best = Preset;
+			}
+		}
+
+		return Best;
+	}
+	FTextureContentInfo ClassifyContent(const FImage& Image)
+	{
+		FTextureContentInfo Info;
+
+		if (Image.GetNumPixels() <= 0)
+		{
+			return Info;
+		}
+
+		// Work on the stored codes, not on sRGB-decoded values: a normal map
+		// wrongly flagged as sRGB must still decode to unit vectors
+		FImageView Raw(Image);
+		if (ERawImageFormat::GetFormatNeedsGammaSpace(Raw.Format))
+		{
+			Raw.GammaSpace = EGammaSpace::Linear;
+		}
+
+		const float Scale = float(ContentSampleSize) / float(FMath::Max(Image.SizeX, Image.SizeY));
+		const int32 SampleX = FMath::Clamp(FMath::RoundToInt(Image.SizeX * Scale), 1, Image.SizeX);
+		const int32 SampleY = FMath::Clamp(FMath::RoundToInt(Image.SizeY * Scale), 1, Image.SizeY);
+
+		FImage Sample;
+		FImageCore::ResizeTo(Raw, Sample, SampleX, SampleY, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+
+		const float* Pixels = reinterpret_cast<const float*>(Sample.RawData.GetData());
+		const int32 NumChunks = FMath::DivideAndRoundUp(SampleY, ContentChunkRows);
+
+		TArray<FContentStats> ChunkStats;
+		ChunkStats.SetNum(NumChunks);
+
+		ParallelFor(NumChunks, [&](int32 Chunk)
+			{
+				const int64 Begin = int64(Chunk) * ContentChunkRows * SampleX;
+				const int64 End = FMath::Min<int64>(Begin + int64(ContentChunkRows) * SampleX, int64(SampleX) * SampleY);
+				ChunkStats[Chunk] = AccumulateContent(Pixels, Begin, End);
+			});
+
+		FContentStats Stats;
+		for (const FContentStats& Chunk : ChunkStats)
+		{
+			Stats.Add(Chunk);
+		}
+
+		const float Num = float(FMath::Max<int64>(Stats.Num, 1));
+
+		float Mean[3];
+		float Variance[3];
+		for (int32 Channel = 0; Channel < 3; ++Channel)
+		{
+			Mean[Channel] = Stats.Sum[Channel] / Num;
+			Variance[Channel] = FMath::Max(Stats.SumSq[Channel] / Num - Mean[Channel] * Mean[Channel], 0.f);
+		}
+
+		// Correlation of rg, gb, br; channels that barely vary don't count
+		constexpr float MinVariance = 1e-4f;
+		int32 NumVarying = 0;
+		for (int32 Channel = 0; Channel < 3; ++Channel)
+		{
+			NumVarying += Variance[Channel] > MinVariance;
+		}
+
+		float MaxCorrelation = 0.f;
+		for (int32 Pair = 0; Pair < 3; ++Pair)
+		{
+			const int32 A = Pair;
+			const int32 B = (Pair + 1) % 3;
+			if (Variance[A] > MinVariance && Variance[B] > MinVariance)
+			{
+				const float Covariance = Stats.SumCross[Pair] / Num - Mean[A] * Mean[B];
+				MaxCorrelation = FMath::Max(MaxCorrelation, FMath::Abs(Covariance) / FMath::Sqrt(Variance[A] * Variance[B]));
+			}
+		}
+
+		Info.MeanUnitLengthError = Stats.UnitLengthError / Num;
+		Info.BlueDominantFraction = float(Stats.BlueDominant) / Num;
+		Info.GrayscaleFraction = float(Stats.Gray) / Num;
+		Info.ExtremeFraction = (Stats.Extreme[0] + Stats.Extreme[1] + Stats.Extreme[2]) / (3.f * Num);
+		Info.MaxChannelCorrelation = MaxCorrelation;
+
+		if (Info.MeanUnitLengthError < 0.12f && Info.BlueDominantFraction > 0.85f && Mean[2] > 0.6f)
+		{
+			Info.Kind = ETextureContentKind::NormalMap;
+			Info.bSuggestSRGB = false;
+			Info.Confidence = FMath::Min(1.f - Info.MeanUnitLengthError / 0.12f, Info.BlueDominantFraction);
+		}
+		else if (Info.GrayscaleFraction > 0.98f)
+		{
+			const bool bMask = Info.ExtremeFraction > 0.6f;
+			Info.Kind = bMask ? ETextureContentKind::Mask : ETextureContentKind::Grayscale;
+			Info.bSuggestSRGB = !bMask;
+			Info.Confidence = bMask ? Info.ExtremeFraction : Info.GrayscaleFraction;
+		}
+		else if (NumVarying >= 2 && MaxCorrelation < 0.5f)
+		{
+			Info.Kind = ETextureContentKind::PackedORM;
+			Info.bSuggestSRGB = false;
+			Info.Confidence = 1.f - MaxCorrelation * 2.f;
+		}
+		else if (Info.ExtremeFraction > 0.7f)
+		{
+			Info.Kind = ETextureContentKind::Mask;
+			Info.bSuggestSRGB = false;
+			Info.Confidence = Info.ExtremeFraction;
+		}
+		else
+		{
+			Info.Kind = ETextureContentKind::Color;
+			Info.bSuggestSRGB = true;
+			Info.Confidence = MaxCorrelation;
+		}
+
+		return Info;
+	}
+
+	FTextureContentInfo FindContentInfo(const UTexture2D* Texture)
+	{
+		if (!Texture)
+		{
+			return FTextureContentInfo();
+		}
+
+		const FCachedContent* Cached = GContentCache.Find(GetCacheKey(Texture));
+		if (!Cached || Cached->SourceId != GetSourceId(Texture))
+		{
+			return FTextureContentInfo();
+		}
+
+		return Cached->Info;
+	}
+
+	void AnalyzeContentAsync(const TArray<UTexture2D*>& Textures, TFunction<void()> OnComplete)
+	{
+		check(IsInGameThread());
+
+		struct FJob
+		{
+			TArray<TStrongObjectPtr<UTexture2D>> Textures;
+			TArray<FGuid> SourceIds;
+			TArray<FTextureContentInfo> Results;
+		};
+
+		TSharedRef<FJob, ESPMode::ThreadSafe> Job = MakeShared<FJob, ESPMode::ThreadSafe>();
+
+		for (UTexture2D* Texture : Textures)
+		{
+			if (Texture && FindContentInfo(Texture).Kind == ETextureContentKind::Unknown)
+			{
+				Job->Textures.Emplace(Texture);
+				Job->SourceIds.Add(GetSourceId(Texture));
+			}
+		}
+
+		if (Job->Textures.Num() == 0)
+		{
+			if (OnComplete)
+			{
+				OnComplete();
+			}
+			return;
+		}
+
+		Job->Results.SetNum(Job->Textures.Num());
+
+		UE::Tasks::Launch(UE_SOURCE_LOCATION,
+			[Job, OnComplete = MoveTemp(OnComplete)]() mutable
+			{
+				// One texture per work item; the kernels inside split further
+				ParallelFor(Job->Textures.Num(), [&Job](int32 Index)
+					{
+						Job->Results[Index] = AnalyzeSource(Job->Textures[Index].Get());
+					},
+					EParallelForFlags::Unbalanced);
+
+				AsyncTask(ENamedThreads::GameThread, [Job, OnComplete = MoveTemp(OnComplete)]()
+					{
+						for (int32 Index = 0; Index < Job->Textures.Num(); ++Index)
+						{
+							const UTexture2D* Texture = Job->Textures[Index].Get();
+							const FTextureContentInfo& Info = Job->Results[Index];
+							if (!Texture || Info.Kind == ETextureContentKind::Unknown)
+							{
+								continue;
+							}
+
+							GContentCache.Add(GetCacheKey(Texture), { Job->SourceIds[Index], Info });
+							if (Info.Alpha.Usage != ETextureAlphaUsage::Unknown)
+							{
+								GAlphaCache.Add(GetCacheKey(Texture), { Job->SourceIds[Index], Info.Alpha });
+							}
+						}
+
+						// Strong references must be released on the game thread
+						Job->Textures.Empty();
+
+						if (OnComplete)
+						{
+							OnComplete();
+						}
+					});
+			},
+			UE::Tasks::ETaskPriority::BackgroundNormal);
+	}
+
+	FText ContentKindToText(ETextureContentKind Kind)
+	{
+		switch (Kind)
+		{
+		case ETextureContentKind::Color:
+			return NSLOCTEXT("TextureManager", "ContentColor", "Color");
+		case ETextureContentKind::NormalMap:
+			return NSLOCTEXT("TextureManager", "ContentNormal", "Normal map");
+		case ETextureContentKind::Grayscale:
+			return NSLOCTEXT("TextureManager", "ContentGrayscale", "Grayscale");
+		case ETextureContentKind::Mask:
+			return NSLOCTEXT("TextureManager", "ContentMask", "Mask");
+		case ETextureContentKind::PackedORM:
+			return NSLOCTEXT("TextureManager", "ContentORM", "Packed ORM");
+		default:
+			return NSLOCTEXT("TextureManager", "ContentUnknown", "Not analyzed");
+		}
+	}
+
+	UTexturePresetAsset* SuggestPresetForContent(
+		const FTextureContentInfo& Info,
+		const TArray<TWeakObjectPtr<UTexturePresetAsset>>& Presets)
+	{
+		if (Info.Kind == ETextureContentKind::Unknown)
+		{
+			return nullptr;
+		}
+
+		TextureCompressionSettings Wanted = TC_Default;
+		TextureGroup WantedGroup = TEXTUREGROUP_World;
+		switch (Info.Kind)
+		{
+		case ETextureContentKind::NormalMap:
+			Wanted = TC_Normalmap;
+			WantedGroup = TEXTUREGROUP_WorldNormalMap;
+			break;
+		case ETextureContentKind::Grayscale:
+			Wanted = TC_Grayscale;
+			break;
+		case ETextureContentKind::Mask:
+		case ETextureContentKind::PackedORM:
+			Wanted = TC_Masks;
+			WantedGroup = TEXTUREGROUP_WorldSpecular;
+			break;
+		default:
+			break;
+		}
+
+		UTexturePresetAsset* Best = nullptr;
+		int32 BestScore = 0;
+
+		for (const TWeakObjectPtr<UTexturePresetAsset>& Item : Presets)
+		{
+			UTexturePresetAsset* Preset = Item.Get();
+			if (!Preset)
+			{
+				continue;
+			}
+
+			const FTexturePresetSettings Settings = TexturePresetLibrary::ResolveSettings(Preset);
+
+			// Wrong colour space is never a good suggestion
+			if (Settings.bSRGB != Info.bSuggestSRGB)
+			{
+				continue;
+			}
+
+			int32 Score = 0;
+			if (Settings.CompressionSettings == Wanted)
+			{
+				Score += 8;
+			}
+			else if (Info.Kind == ETextureContentKind::Color && Settings.CompressionSettings == TC_BC7)
+			{
+				Score += 6;
+			}
+			else if (Info.Kind == ETextureContentKind::Mask
+				&& (Settings.CompressionSettings == TC_Grayscale || Settings.CompressionSettings == TC_Alpha))
+			{
+				Score += 4;
+			}
+			else
+			{
+				continue;
+			}
+
+			// A preset without alpha would only keep it on apply
+			if (!Settings.bUseAlpha && !Info.Alpha.IsRemovable())
+			{
+				continue;
+			}
+
+			Score += (Settings.TextureGroup == WantedGroup) ? 2 : 0;
+			Score += (Settings.bUseAlpha != Info.Alpha.IsRemovable()) ? 1 : 0;
+
+			if (Score > BestScore)
+			{
+				BestScore = Score;
+				Best = Preset;
+			}
+		}
+
+		return Best;
+	}
+}
@@ -0,0 +1,342 @@
+#include "TextureBulkJournal.h"
+
+#include "TextureManagerMetrics.h"
+#include "TextureManagerStats.h"
+#include "TexturePresetAsset.h"
+#include "TexturePresetLibrary.h"
+#include "TextureRebuildScheduler.h"
+
+#include "Engine/Texture2D.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "UObject/SoftObjectPath.h"
+
+#define LOCTEXT_NAMESPACE "TextureBulkJournal"
+
+namespace
+{
+	constexpr int32 JournalFileVersion = 1;
+
+	struct FOpenBatch
+	{
+		FString Label;
+		TUniquePtr<FArchive> Writer;
+		TSet<FSoftObjectPath> Recorded;
+	};
+
+	TMap<FGuid, FOpenBatch> GOpenBatches;
+
+	// Rolled back batches whose rebuilds are still queued; their files go
+	// once the scheduler drains, so a crash before that can roll back again
+	TMap<FGuid, FString> GPendingRollbacks;
+
+	// Empty: the default under Saved/
+	FString GJournalDir;
+
+	FString GetJournalDir()
+	{
+		return !GJournalDir.IsEmpty() ? GJournalDir : FPaths::ProjectSavedDir() / TEXT("TextureManager") / TEXT("Journal");
+	}
+
+	FString GetBatchPath(const FGuid& Batch)
+	{
+		return GetJournalDir() / Batch.ToString(EGuidFormats::Digits) + TEXT(".bin");
+	}
+
+	// Header: version, label, time, then the field names records index into
+	bool SerializeHeader(FArchive& Ar, FString& Label, FDateTime& Time, TArray<FString>& FieldNames)
+	{
+		int32 Version = JournalFileVersion;
+		Ar << Version;
+		if (Version != JournalFileVersion)
+		{
+			return false;
+		}
+		Ar << Label << Time << FieldNames;
+		return !Ar.IsError();
+	}
+
+	// One value of FTexturePresetSettings; names and objects as strings
+	void SerializeField(FArchive& Ar, const FProperty* Property, FTexturePresetSettings& Settings)
+	{
+		FObjectAndNameAsStringProxyArchive Proxy(Ar, false);
+		Property->SerializeItem(FStructuredArchiveFromArchive(Proxy).GetSlot(), Property->ContainerPtrToValuePtr<void>(&Settings));
+	}
+
+	FArchive* OpenWriter(const FGuid& Batch, FOpenBatch& Open)
+	{
+		if (!Open.Writer)
+		{
+			Open.Writer.Reset(IFileManager::Get().CreateFileWriter(*GetBatchPath(Batch)));
+			if (Open.Writer)
+			{
+				TArray<FString> FieldNames;
+				for (const FName Field : TexturePresetLibrary::GetApplicableFields())
+				{
+					FieldNames.Add(Field.ToString());
+				}
+				FDateTime Now = FDateTime::Now();
+				SerializeHeader(*Open.Writer, Open.Label, Now, FieldNames);
+			}
+		}
+		return Open.Writer.Get();
+	}
+
+	struct FJournalRecord
+	{
+		FSoftObjectPath Texture;
+		TArray<uint8> Payload;
+	};
+
+	bool ReadBatch(const FGuid& Batch, FString& OutLabel, FDateTime& OutTime, TArray<FString>& OutFieldNames, TArray<FJournalRecord>* OutRecords)
+	{
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*GetBatchPath(Batch)));
+		if (!Reader || !SerializeHeader(*Reader, OutLabel, OutTime, OutFieldNames))
+		{
+			return false;
+		}
+
+		// A record cut short by a crash ends the batch
+		while (OutRecords && !Reader->AtEnd())
+		{
+			FJournalRecord Record;
+			FString Path;
+			*Reader << Path << Record.Payload;
+			if (Reader->IsError())
+			{
+				break;
+			}
+			Record.Texture = FSoftObjectPath(Path);
+			OutRecords->Add(MoveTemp(Record));
+		}
+		return true;
+	}
+}
+
+namespace TextureBulkJournal
+{
+	FGuid BeginBatch(const FString& Label)
+	{
+		check(IsInGameThread());
+
+		const FGuid Batch = FGuid::NewGuid();
+		GOpenBatches.Add(Batch).Label = Label;
+		return Batch;
+	}
+
+	void Record(const FGuid& Batch, const UTexture2D* Texture, const TArray<FName>& Fields)
+	{
+		TEXTURE_MANAGER_SCOPE("JournalRecord");
+		FOpenBatch* Open = GOpenBatches.Find(Batch);
+		if (!Open || !Texture || Fields.IsEmpty())
+		{
+			return;
+		}
+
+		// The first values are the ones to go back to
+		bool bAlreadyRecorded = false;
+		const FSoftObjectPath TexturePath(Texture);
+		Open->Recorded.Add(TexturePath, &bAlreadyRecorded);
+		if (bAlreadyRecorded)
+		{
+			return;
+		}
+
+		FArchive* Writer = OpenWriter(Batch, *Open);
+		if (!Writer)
+		{
+			return;
+		}
+
+		// Field index into the header table, then the value
+		const TArray<FName> AllFields = TexturePresetLibrary::GetApplicableFields();
+		FTexturePresetSettings Current = TexturePresetLibrary::CaptureSettings(Texture);
+
+		TArray<uint8> Payload;
+		FMemoryWriter PayloadWriter(Payload);
+		for (const FName Field : Fields)
+		{
+			const FProperty* Property = FTexturePresetSettings::StaticStruct()->FindPropertyByName(Field);
+			uint8 FieldIndex = uint8(AllFields.IndexOfByKey(Field));
+			if (!Property || FieldIndex == uint8(INDEX_NONE))
+			{
+				continue;
+			}
+			PayloadWriter << FieldIndex;
+			SerializeField(PayloadWriter, Property, Current);
+		}
+
+		FString Path = TexturePath.ToString();
+		*Writer << Path << Payload;
+
+		// On disk before the texture changes, or a crash loses the old values
+		Writer->Flush();
+	}
+
+	void CloseBatches()
+	{
+		for (TPair<FGuid, FOpenBatch>& Pair : GOpenBatches)
+		{
+			if (Pair.Value.Writer)
+			{
+				Pair.Value.Writer->Close();
+			}
+		}
+		GOpenBatches.Reset();
+	}
+
+	void FinishRollbacks()
+	{
+		for (const TPair<FGuid, FString>& Pair : GPendingRollbacks)
+		{
+			IFileManager::Get().Delete(*Pair.Value);
+		}
+		GPendingRollbacks.Reset();
+	}
+
+	TArray<FTextureJournalBatch> ListBatches()
+	{
+		TArray<FString> Files;
+		IFileManager::Get().FindFiles(Files, *(GetJournalDir() / TEXT("*.bin")), true, false);
+
+		TArray<FTextureJournalBatch> Batches;
+		for (const FString& File : Files)
+		{
+			FTextureJournalBatch Batch;
+			if (!FGuid::Parse(FPaths::GetBaseFilename(File), Batch.Id))
+			{
+				continue;
+			}
+
+			// Still being written, or rolled back already
+			if (GOpenBatches.Contains(Batch.Id) || GPendingRollbacks.Contains(Batch.Id))
+			{
+				continue;
+			}
+
+			TArray<FString> FieldNames;
+			TArray<FJournalRecord> Records;
+			if (ReadBatch(Batch.Id, Batch.Label, Batch.Time, FieldNames, &Records))
+			{
+				Batch.NumTextures = Records.Num();
+				Batches.Add(MoveTemp(Batch));
+			}
+		}
+
+		Batches.Sort([](const FTextureJournalBatch& A, const FTextureJournalBatch& B)
+			{
+				return A.Time > B.Time;
+			});
+		return Batches;
+	}
+
+	int32 Rollback(const FGuid& Batch)
+	{
+		TEXTURE_MANAGER_SCOPE("JournalRollback");
+		FTextureManagerOperationScope Operation(TEXT("Rollback"));
+		FString Label;
+		FDateTime Time;
+		TArray<FString> FieldNames;
+		TArray<FJournalRecord> Records;
+		if (GOpenBatches.Contains(Batch) || GPendingRollbacks.Contains(Batch) || !ReadBatch(Batch, Label, Time, FieldNames, &Records))
+		{
+			return 0;
+		}
+
+		// Field names of the file -> current binding bits
+		const TArray<FName> AllFields = TexturePresetLibrary::GetApplicableFields();
+		TArray<int32> FieldBits;
+		TArray<const FProperty*> FieldProperties;
+		for (const FString& Name : FieldNames)
+		{
+			FieldBits.Add(AllFields.IndexOfByKey(FName(*Name)));
+			FieldProperties.Add(FTexturePresetSettings::StaticStruct()->FindPropertyByName(FName(*Name)));
+		}
+
+		FScopedSlowTask SlowTask(float(Records.Num()),
+			FText::Format(LOCTEXT("RollingBack", "Rolling back \"{0}\"..."), FText::FromString(Label)));
+		SlowTask.MakeDialogDelayed(0.5f);
+
+		int32 NumQueued = 0;
+		for (const FJournalRecord& Record : Records)
+		{
+			SlowTask.EnterProgressFrame(1);
+
+			UTexture2D* Texture = Cast<UTexture2D>(Record.Texture.TryLoad());
+			if (!Texture)
+			{
+				continue;
+			}
+
+			FTexturePresetSettings Settings = TexturePresetLibrary::CaptureSettings(Texture);
+			uint64 FieldMask = 0;
+
+			FMemoryReader PayloadReader(Record.Payload);
+			while (!PayloadReader.AtEnd() && !PayloadReader.IsError())
+			{
+				uint8 FieldIndex = 0;
+				PayloadReader << FieldIndex;
+				if (!FieldProperties.IsValidIndex(FieldIndex) || !FieldProperties[FieldIndex])
+				{
+					// Unknown field: its size is unknown too, so the rest is lost
+					break;
+				}
+
+				SerializeField(PayloadReader, FieldProperties[FieldIndex], Settings);
+				if (FieldBits[FieldIndex] != INDEX_NONE)
+				{
+					FieldMask |= uint64(1) << FieldBits[FieldIndex];
+				}
+			}
+
+			// Rebuilt when the scheduler gets to it, like the batch itself was
+			if (!TexturePresetLibrary::DiffSettings(Settings, FieldMask, Texture).IsEmpty())
+			{
+				TextureRebuildScheduler::EnqueueSettings(Settings, FieldMask, Texture);
+				++NumQueued;
+			}
+		}
+
+		// Kept until the queued rebuilds are done (FinishRollbacks)
+		if (NumQueued > 0)
+		{
+			GPendingRollbacks.Add(Batch, GetBatchPath(Batch));
+		}
+		else
+		{
+			IFileManager::Get().Delete(*GetBatchPath(Batch));
+		}
+
+		// Nobody ticks the scheduler in a commandlet
+		if (IsRunningCommandlet())
+		{
+			TextureRebuildScheduler::Flush();
+		}
+		UE_LOG(LogTemp, Log, TEXT("Rolled back \"%s\": %d of %d textures queued for rebuild"), *Label, NumQueued, Records.Num());
+		return NumQueued;
+	}
+
+	void Prune(int32 MaxBatches)
+	{
+		const TArray<FTextureJournalBatch> Batches = ListBatches();
+		for (int32 Index = MaxBatches; Index < Batches.Num(); ++Index)
+		{
+			IFileManager::Get().Delete(*GetBatchPath(Batches[Index].Id));
+		}
+	}
+
+	void SetDirectory(const FString& Dir)
+	{
+		check(IsInGameThread());
+
+		// A batch being written stays in the directory it started in
+		CloseBatches();
+		GJournalDir = Dir;
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
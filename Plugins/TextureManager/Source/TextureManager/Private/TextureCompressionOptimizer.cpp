@@ -0,0 +1,927 @@
+#include "TextureCompressionOptimizer.h"
+
+#include "TexturePresetAsset.h"
+#include "TexturePresetLibrary.h"
+#include "TextureMemoryEstimator.h"
+#include "TextureBulkJournal.h"
+#include "TextureRebuildScheduler.h"
+
+#include "Engine/Texture2D.h"
+#include "Algo/AllOf.h"
+#include "ImageCore.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Math/VectorRegister.h"
+#include "Tasks/Task.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace
+{
+	// Rows of 4x4 blocks per ParallelFor work item
+	constexpr int32 BlockRowsPerChunk = 4;
+
+	// Side of the SSIM windows
+	constexpr int32 SSIMWindow = 8;
+
+	// Reported when the error is zero
+	constexpr float MaxPSNR = 100.f;
+
+	// SSIM stabilizers for values in 0..1
+	constexpr float SSIMC1 = 0.01f * 0.01f;
+	constexpr float SSIMC2 = 0.03f * 0.03f;
+
+	float Quantize(float Value, float Steps)
+	{
+		return FMath::RoundToFloat(FMath::Clamp(Value, 0.f, 1.f) * Steps) / Steps;
+	}
+
+	// 4x4 block, one RGBA pixel per register; edge blocks repeat the last row / column
+	struct FBlock
+	{
+		VectorRegister4Float Pixels[16];
+
+		void Load(const float* Image, int32 SizeX, int32 SizeY, int32 BlockX, int32 BlockY)
+		{
+			for (int32 Y = 0; Y < 4; ++Y)
+			{
+				const int32 SrcY = FMath::Min(BlockY * 4 + Y, SizeY - 1);
+				for (int32 X = 0; X < 4; ++X)
+				{
+					const int32 SrcX = FMath::Min(BlockX * 4 + X, SizeX - 1);
+					Pixels[Y * 4 + X] = VectorLoad(Image + (int64(SrcY) * SizeX + SrcX) * 4);
+				}
+			}
+		}
+
+		void Store(float* Image, int32 SizeX, int32 SizeY, int32 BlockX, int32 BlockY) const
+		{
+			for (int32 Y = 0; Y < 4 && BlockY * 4 + Y < SizeY; ++Y)
+			{
+				for (int32 X = 0; X < 4 && BlockX * 4 + X < SizeX; ++X)
+				{
+					VectorStore(Pixels[Y * 4 + X], Image + (int64(BlockY * 4 + Y) * SizeX + BlockX * 4 + X) * 4);
+				}
+			}
+		}
+	};
+
+	// BC1 colour, 4 colour mode: endpoints at the extremes along the principal
+	// axis, quantized to 565, every pixel snapped to the nearest of 4 palette entries.
+	// Leaves the alpha lane alone.
+	void EncodeBC1(FBlock& Block)
+	{
+		const VectorRegister4Float RGBMask = MakeVectorRegisterFloatMask(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0);
+
+		VectorRegister4Float Mean = VectorZero();
+		for (int32 Index = 0; Index < 16; ++Index)
+		{
+			Mean = VectorAdd(Mean, Block.Pixels[Index]);
+		}
+		Mean = VectorBitwiseAnd(VectorMultiply(Mean, VectorSetFloat1(1.f / 16.f)), RGBMask);
+
+		// Covariance: diagonal and rg / gb / br
+		VectorRegister4Float Diagonal = VectorZero();
+		VectorRegister4Float Cross = VectorZero();
+		for (int32 Index = 0; Index < 16; ++Index)
+		{
+			const VectorRegister4Float Delta = VectorBitwiseAnd(VectorSubtract(Block.Pixels[Index], Mean), RGBMask);
+			Diagonal = VectorMultiplyAdd(Delta, Delta, Diagonal);
+			Cross = VectorMultiplyAdd(Delta, VectorSwizzle(Delta, 1, 2, 0, 3), Cross);
+		}
+
+		float D[4];
+		float C[4];
+		VectorStore(Diagonal, D);
+		VectorStore(Cross, C);
+
+		// Power iteration for the principal axis
+		FVector3f Axis(1.f, 1.f, 1.f);
+		for (int32 Iteration = 0; Iteration < 4; ++Iteration)
+		{
+			const FVector3f Next(
+				D[0] * Axis.X + C[0] * Axis.Y + C[2] * Axis.Z,
+				C[0] * Axis.X + D[1] * Axis.Y + C[1] * Axis.Z,
+				C[2] * Axis.X + C[1] * Axis.Y + D[2] * Axis.Z);
+
+			const float Length = Next.Size();
+			if (Length < UE_SMALL_NUMBER)
+			{
+				break;
+			}
+			Axis = Next / Length;
+		}
+
+		const VectorRegister4Float AxisRegister = MakeVectorRegisterFloat(Axis.X, Axis.Y, Axis.Z, 0.f);
+
+		float MinT = UE_BIG_NUMBER;
+		float MaxT = -UE_BIG_NUMBER;
+		for (int32 Index = 0; Index < 16; ++Index)
+		{
+			const float T = VectorGetComponent(VectorDot3(VectorSubtract(Block.Pixels[Index], Mean), AxisRegister), 0);
+			MinT = FMath::Min(MinT, T);
+			MaxT = FMath::Max(MaxT, T);
+		}
+
+		float High[4];
+		float Low[4];
+		VectorStore(VectorMultiplyAdd(AxisRegister, VectorSetFloat1(MaxT), Mean), High);
+		VectorStore(VectorMultiplyAdd(AxisRegister, VectorSetFloat1(MinT), Mean), Low);
+
+		const VectorRegister4Float Endpoint0 = MakeVectorRegisterFloat(Quantize(High[0], 31.f), Quantize(High[1], 63.f), Quantize(High[2], 31.f), 0.f);
+		const VectorRegister4Float Endpoint1 = MakeVectorRegisterFloat(Quantize(Low[0], 31.f), Quantize(Low[1], 63.f), Quantize(Low[2], 31.f), 0.f);
+
+		// The palette is evenly spaced on the segment, so the nearest entry is the
+		// projection rounded to thirds
+		const VectorRegister4Float Segment = VectorSubtract(Endpoint0, Endpoint1);
+		const float SegmentLengthSq = VectorGetComponent(VectorDot3(Segment, Segment), 0);
+
+		for (int32 Index = 0; Index < 16; ++Index)
+		{
+			VectorRegister4Float& Pixel = Block.Pixels[Index];
+
+			float T = 0.f;
+			if (SegmentLengthSq > UE_SMALL_NUMBER)
+			{
+				T = VectorGetComponent(VectorDot3(VectorSubtract(Pixel, Endpoint1), Segment), 0) / SegmentLengthSq;
+				T = FMath::RoundToFloat(FMath::Clamp(T, 0.f, 1.f) * 3.f) / 3.f;
+			}
+
+			const VectorRegister4Float Decoded = VectorMultiplyAdd(Segment, VectorSetFloat1(T), Endpoint1);
+			Pixel = VectorSelect(RGBMask, Decoded, Pixel);
+		}
+	}
+
+	// BC4 on one channel: 8 bit endpoints at min / max, 8 evenly spaced entries
+	void EncodeBC4(FBlock& Block, int32 Channel)
+	{
+		float Values[16];
+		float Min = 1.f;
+		float Max = 0.f;
+		for (int32 Index = 0; Index < 16; ++Index)
+		{
+			Values[Index] = FMath::Clamp(VectorGetComponentDynamic(Block.Pixels[Index], Channel), 0.f, 1.f);
+			Min = FMath::Min(Min, Values[Index]);
+			Max = FMath::Max(Max, Values[Index]);
+		}
+
+		const float Endpoint0 = Quantize(Max, 255.f);
+		const float Endpoint1 = Quantize(Min, 255.f);
+		const float Range = Endpoint0 - Endpoint1;
+
+		for (int32 Index = 0; Index < 16; ++Index)
+		{
+			float T = 0.f;
+			if (Range > 0.f)
+			{
+				T = FMath::RoundToFloat(FMath::Clamp((Values[Index] - Endpoint1) / Range, 0.f, 1.f) * 7.f) / 7.f;
+			}
+
+			float Pixel[4];
+			VectorStore(Block.Pixels[Index], Pixel);
+			Pixel[Channel] = Endpoint1 + T * Range;
+			Block.Pixels[Index] = VectorLoad(Pixel);
+		}
+	}
+
+	// Uncompressed 8 bit per channel
+	void EncodeUNorm8(FBlock& Block, int32 NumChannels)
+	{
+		const VectorRegister4Float Steps = VectorSetFloat1(255.f);
+		const VectorRegister4Float InvSteps = VectorSetFloat1(1.f / 255.f);
+		const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+
+		for (VectorRegister4Float& Pixel : Block.Pixels)
+		{
+			const VectorRegister4Float Clamped = VectorMin(VectorMax(Pixel, VectorZero()), VectorOne());
+			const VectorRegister4Float Quantized = VectorMultiply(VectorFloor(VectorMultiplyAdd(Clamped, Steps, Half)), InvSteps);
+
+			if (NumChannels == 1)
+			{
+				// Single channel formats replicate red
+				Pixel = VectorSelect(
+					MakeVectorRegisterFloatMask(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0),
+					VectorReplicate(Quantized, 0),
+					Pixel);
+			}
+			else
+			{
+				Pixel = Quantized;
+			}
+		}
+	}
+
+	void SetOpaque(FBlock& Block)
+	{
+		const VectorRegister4Float AlphaMask = MakeVectorRegisterFloatMask(0, 0, 0, 0xFFFFFFFF);
+		for (VectorRegister4Float& Pixel : Block.Pixels)
+		{
+			Pixel = VectorSelect(AlphaMask, VectorOne(), Pixel);
+		}
+	}
+
+	// Channels the format stores, 1.0 per lane
+	VectorRegister4Float GetChannelWeights(TextureCompressionSettings Compression, bool bHasAlpha)
+	{
+		switch (Compression)
+		{
+		case TC_Grayscale:
+			return MakeVectorRegisterFloat(1.f, 0.f, 0.f, 0.f);
+		case TC_Normalmap:
+			// Blue is reconstructed by the shader
+			return MakeVectorRegisterFloat(1.f, 1.f, 0.f, 0.f);
+		default:
+			return MakeVectorRegisterFloat(1.f, 1.f, 1.f, bHasAlpha ? 1.f : 0.f);
+		}
+	}
+
+	// Compression settings that sample the same way in a material, so
+	// switching between them never breaks a material's sampler type
+	TArray<TextureCompressionSettings> GetCompatibleCompressions(TextureCompressionSettings Current)
+	{
+		switch (Current)
+		{
+		case TC_Default:
+		case TC_BC7:
+		case TC_VectorDisplacementmap:
+			return { TC_Default, TC_VectorDisplacementmap };
+		case TC_Normalmap:
+			return { TC_Normalmap };
+		case TC_Masks:
+			return { TC_Masks };
+		case TC_Grayscale:
+			return { TC_Grayscale };
+		default:
+			return {};
+		}
+	}
+
+	// Source mip 0 as raw codes (no sRGB decode, like the cooker's block encoders
+	// see them), at most MaxSize on the longest side
+	bool LoadReference(UTexture2D* Texture, int32 MaxSize, FImage& OutReference)
+	{
+#if WITH_EDITOR
+		if (!Texture || !Texture->Source.IsValid())
+		{
+			return false;
+		}
+
+		FImage Image;
+		if (!Texture->Source.GetMipImage(Image, 0, 0, 0) || Image.GetNumPixels() <= 0)
+		{
+			return false;
+		}
+
+		FImageView Raw(Image);
+		if (ERawImageFormat::GetFormatNeedsGammaSpace(Raw.Format))
+		{
+			Raw.GammaSpace = EGammaSpace::Linear;
+		}
+
+		const float Scale = FMath::Min(1.f, float(MaxSize) / float(FMath::Max(Image.SizeX, Image.SizeY)));
+		const int32 SizeX = FMath::Max(FMath::RoundToInt(Image.SizeX * Scale), 1);
+		const int32 SizeY = FMath::Max(FMath::RoundToInt(Image.SizeY * Scale), 1);
+
+		if (SizeX == Image.SizeX && SizeY == Image.SizeY)
+		{
+			OutReference.Init(SizeX, SizeY, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+			FImageCore::CopyImage(Raw, OutReference);
+		}
+		else
+		{
+			FImageCore::ResizeTo(Raw, OutReference, SizeX, SizeY, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+		}
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	// Shrink the reference to the size the candidate keeps (scaled like the
+	// reference was), compress, and scale back up for the comparison
+	FTextureQualityMetrics EvaluateCandidate(
+		const FImage& Reference,
+		float ReferenceScale,
+		TextureCompressionSettings Compression,
+		bool bHasAlpha,
+		int32 SizeX,
+		int32 SizeY)
+	{
+		const int32 EncodedX = FMath::Clamp(FMath::RoundToInt(SizeX * ReferenceScale), 1, Reference.SizeX);
+		const int32 EncodedY = FMath::Clamp(FMath::RoundToInt(SizeY * ReferenceScale), 1, Reference.SizeY);
+		const bool bResized = EncodedX != Reference.SizeX || EncodedY != Reference.SizeY;
+
+		FImage Encoded;
+		if (bResized)
+		{
+			FImageCore::ResizeTo(Reference, Encoded, EncodedX, EncodedY, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+		}
+		else
+		{
+			Encoded = Reference;
+		}
+
+		TextureCompressionOptimizer::EncodeDecode(Encoded, Compression, bHasAlpha);
+
+		if (!bResized)
+		{
+			return TextureCompressionOptimizer::Measure(Reference, Encoded, Compression, bHasAlpha);
+		}
+
+		FImage Restored;
+		FImageCore::ResizeTo(Encoded, Restored, Reference.SizeX, Reference.SizeY, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+		return TextureCompressionOptimizer::Measure(Reference, Restored, Compression, bHasAlpha);
+	}
+
+	struct FCandidate
+	{
+		TextureCompressionSettings Compression = TC_Default;
+		int32 MaxTextureSize = 0;
+		int32 LODBias = 0;
+	};
+
+	// One (texture, compression, resulting size) combination; candidates that
+	// end up at the same size share it
+	struct FEvaluation
+	{
+		int32 TextureIndex = 0;
+		TextureCompressionSettings Compression = TC_Default;
+		int32 SizeX = 0;
+		int32 SizeY = 0;
+		FTextureQualityMetrics Metrics;
+	};
+
+	struct FOptimizerTexture
+	{
+		TStrongObjectPtr<UTexture2D> Texture;
+
+		// BaseSettings resolved for this texture
+		FTextureMemoryInputs Inputs;
+
+		int64 CurrentBytes = 0;
+
+		// Filled on the worker
+		FImage Reference;
+		bool bLoaded = false;
+	};
+}
+
+namespace TextureCompressionOptimizer
+{
+	bool CanSimulate(TextureCompressionSettings Compression)
+	{
+		switch (Compression)
+		{
+		case TC_Default:
+		case TC_Masks:
+		case TC_Normalmap:
+		case TC_Grayscale:
+		case TC_VectorDisplacementmap:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	void EncodeDecode(FImage& Image, TextureCompressionSettings Compression, bool bHasAlpha)
+	{
+		check(Image.Format == ERawImageFormat::RGBA32F);
+
+		const int32 SizeX = Image.SizeX;
+		const int32 SizeY = Image.SizeY;
+		const int32 BlocksX = FMath::DivideAndRoundUp(SizeX, 4);
+		const int32 BlocksY = FMath::DivideAndRoundUp(SizeY, 4);
+		const int32 NumChunks = FMath::DivideAndRoundUp(BlocksY, BlockRowsPerChunk);
+
+		float* Pixels = reinterpret_cast<float*>(Image.RawData.GetData());
+
+		ParallelFor(NumChunks, [&](int32 Chunk)
+			{
+				const int32 EndY = FMath::Min((Chunk + 1) * BlockRowsPerChunk, BlocksY);
+				for (int32 BlockY = Chunk * BlockRowsPerChunk; BlockY < EndY; ++BlockY)
+				{
+					for (int32 BlockX = 0; BlockX < BlocksX; ++BlockX)
+					{
+						FBlock Block;
+						Block.Load(Pixels, SizeX, SizeY, BlockX, BlockY);
+
+						switch (Compression)
+						{
+						case TC_Default:
+						case TC_Masks:
+							// BC3 = BC1 colour + BC4 alpha
+							EncodeBC1(Block);
+							if (bHasAlpha)
+							{
+								EncodeBC4(Block, 3);
+							}
+							else
+							{
+								SetOpaque(Block);
+							}
+							break;
+						case TC_Normalmap:
+							// BC5 = BC4 red + BC4 green
+							EncodeBC4(Block, 0);
+							EncodeBC4(Block, 1);
+							SetOpaque(Block);
+							break;
+						case TC_Grayscale:
+							EncodeUNorm8(Block, 1);
+							SetOpaque(Block);
+							break;
+						default:
+							EncodeUNorm8(Block, 4);
+							if (!bHasAlpha)
+							{
+								SetOpaque(Block);
+							}
+							break;
+						}
+
+						Block.Store(Pixels, SizeX, SizeY, BlockX, BlockY);
+					}
+				}
+			});
+	}
+
+	FTextureQualityMetrics Measure(const FImage& Reference, const FImage& Test, TextureCompressionSettings Compression, bool bHasAlpha)
+	{
+		FTextureQualityMetrics Metrics;
+
+		if (Reference.Format != ERawImageFormat::RGBA32F || Test.Format != ERawImageFormat::RGBA32F
+			|| Reference.SizeX != Test.SizeX || Reference.SizeY != Test.SizeY || Reference.GetNumPixels() <= 0)
+		{
+			return Metrics;
+		}
+
+		const int32 SizeX = Reference.SizeX;
+		const int32 SizeY = Reference.SizeY;
+		const int32 WindowsX = FMath::DivideAndRoundUp(SizeX, SSIMWindow);
+		const int32 WindowsY = FMath::DivideAndRoundUp(SizeY, SSIMWindow);
+
+		const float* RefPixels = reinterpret_cast<const float*>(Reference.RawData.GetData());
+		const float* TestPixels = reinterpret_cast<const float*>(Test.RawData.GetData());
+
+		// Per window row: squared error and SSIM sums, one channel per lane
+		TArray<VectorRegister4Float> RowError;
+		TArray<VectorRegister4Float> RowSSIM;
+		RowError.SetNumUninitialized(WindowsY);
+		RowSSIM.SetNumUninitialized(WindowsY);
+
+		ParallelFor(WindowsY, [&](int32 WindowY)
+			{
+				const VectorRegister4Float C1 = VectorSetFloat1(SSIMC1);
+				const VectorRegister4Float C2 = VectorSetFloat1(SSIMC2);
+				const VectorRegister4Float Two = VectorSetFloat1(2.f);
+
+				VectorRegister4Float Error = VectorZero();
+				VectorRegister4Float SSIM = VectorZero();
+
+				const int32 BeginY = WindowY * SSIMWindow;
+				const int32 EndY = FMath::Min(BeginY + SSIMWindow, SizeY);
+
+				for (int32 WindowX = 0; WindowX < WindowsX; ++WindowX)
+				{
+					const int32 BeginX = WindowX * SSIMWindow;
+					const int32 EndX = FMath::Min(BeginX + SSIMWindow, SizeX);
+
+					VectorRegister4Float SumX = VectorZero();
+					VectorRegister4Float SumY = VectorZero();
+					VectorRegister4Float SumXX = VectorZero();
+					VectorRegister4Float SumYY = VectorZero();
+					VectorRegister4Float SumXY = VectorZero();
+
+					for (int32 Y = BeginY; Y < EndY; ++Y)
+					{
+						for (int32 X = BeginX; X < EndX; ++X)
+						{
+							const int64 Offset = (int64(Y) * SizeX + X) * 4;
+							const VectorRegister4Float A = VectorLoad(RefPixels + Offset);
+							const VectorRegister4Float B = VectorLoad(TestPixels + Offset);
+							const VectorRegister4Float Delta = VectorSubtract(A, B);
+
+							Error = VectorMultiplyAdd(Delta, Delta, Error);
+							SumX = VectorAdd(SumX, A);
+							SumY = VectorAdd(SumY, B);
+							SumXX = VectorMultiplyAdd(A, A, SumXX);
+							SumYY = VectorMultiplyAdd(B, B, SumYY);
+							SumXY = VectorMultiplyAdd(A, B, SumXY);
+						}
+					}
+
+					const VectorRegister4Float InvN = VectorSetFloat1(1.f / float((EndX - BeginX) * (EndY - BeginY)));
+					const VectorRegister4Float MeanX = VectorMultiply(SumX, InvN);
+					const VectorRegister4Float MeanY = VectorMultiply(SumY, InvN);
+					const VectorRegister4Float VarX = VectorSubtract(VectorMultiply(SumXX, InvN), VectorMultiply(MeanX, MeanX));
+					const VectorRegister4Float VarY = VectorSubtract(VectorMultiply(SumYY, InvN), VectorMultiply(MeanY, MeanY));
+					const VectorRegister4Float CovXY = VectorSubtract(VectorMultiply(SumXY, InvN), VectorMultiply(MeanX, MeanY));
+
+					// ((2 mx my + C1)(2 cov + C2)) / ((mx^2 + my^2 + C1)(vx + vy + C2))
+					const VectorRegister4Float Numerator = VectorMultiply(
+						VectorMultiplyAdd(Two, VectorMultiply(MeanX, MeanY), C1),
+						VectorMultiplyAdd(Two, CovXY, C2));
+					const VectorRegister4Float Denominator = VectorMultiply(
+						VectorAdd(VectorMultiplyAdd(MeanX, MeanX, VectorMultiply(MeanY, MeanY)), C1),
+						VectorAdd(VectorAdd(VarX, VarY), C2));
+
+					SSIM = VectorAdd(SSIM, VectorDivide(Numerator, Denominator));
+				}
+
+				RowError[WindowY] = Error;
+				RowSSIM[WindowY] = SSIM;
+			});
+
+		VectorRegister4Float Error = VectorZero();
+		VectorRegister4Float SSIM = VectorZero();
+		for (int32 WindowY = 0; WindowY < WindowsY; ++WindowY)
+		{
+			Error = VectorAdd(Error, RowError[WindowY]);
+			SSIM = VectorAdd(SSIM, RowSSIM[WindowY]);
+		}
+
+		const VectorRegister4Float Weights = GetChannelWeights(Compression, bHasAlpha);
+		const float NumChannels = VectorGetComponent(VectorDot4(Weights, VectorOne()), 0);
+
+		const double MSE = double(VectorGetComponent(VectorDot4(Error, Weights), 0))
+			/ (double(Reference.GetNumPixels()) * NumChannels);
+
+		Metrics.PSNR = (MSE > 1e-10)
+			? FMath::Min(float(10.0 * FMath::LogX(10.0, 1.0 / MSE)), MaxPSNR)
+			: MaxPSNR;
+		Metrics.SSIM = VectorGetComponent(VectorDot4(SSIM, Weights), 0) / (NumChannels * float(WindowsX * WindowsY));
+
+		return Metrics;
+	}
+
+	void OptimizeAsync(
+		const TArray<UTexture2D*>& Textures,
+		const FTexturePresetSettings* BaseSettings,
+		const FTextureOptimizerOptions& Options,
+		TFunction<void(const FTextureOptimizerResult&)> OnComplete)
+	{
+		check(IsInGameThread());
+
+		struct FJob
+		{
+			TArray<FOptimizerTexture> Textures;
+			FTexturePresetSettings BaseSettings;
+			FTextureOptimizerOptions Options;
+			FTextureOptimizerResult Result;
+		};
+
+		TSharedRef<FJob, ESPMode::ThreadSafe> Job = MakeShared<FJob, ESPMode::ThreadSafe>();
+		Job->Options = Options;
+
+		// Everything that touches UObjects is resolved here
+		for (UTexture2D* Texture : Textures)
+		{
+			if (!Texture)
+			{
+				continue;
+			}
+
+			const FTexturePresetSettings Settings = BaseSettings ? *BaseSettings : TextureMemoryEstimator::GetTextureSettings(Texture);
+			if (Job->Textures.Num() == 0)
+			{
+				// Without a preset the first texture's values are only the starting candidate
+				Job->BaseSettings = Settings;
+			}
+
+			FOptimizerTexture& Entry = Job->Textures.AddDefaulted_GetRef();
+			Entry.Texture.Reset(Texture);
+			Entry.Inputs = TextureMemoryEstimator::MakeInputs(Texture, Settings);
+			Entry.CurrentBytes = TextureMemoryEstimator::EstimateTexture(Texture).GetTotalBytes();
+
+			FTextureOptimizerTextureResult& TextureResult = Job->Result.Textures.AddDefaulted_GetRef();
+			TextureResult.Texture = Texture;
+			TextureResult.CurrentBytes = Entry.CurrentBytes;
+			Job->Result.CurrentBytes += Entry.CurrentBytes;
+		}
+
+		Job->Result.Settings = Job->BaseSettings;
+		const TArray<TextureCompressionSettings> Compressions = GetCompatibleCompressions(Job->BaseSettings.CompressionSettings);
+
+		// Every texture has to take the compression that is picked
+		const bool bOneSamplerType = Algo::AllOf(Job->Textures, [&Compressions](const FOptimizerTexture& Entry)
+			{
+				return GetCompatibleCompressions(Entry.Inputs.Settings.CompressionSettings) == Compressions;
+			});
+
+		if (Job->Textures.Num() == 0 || Compressions.Num() == 0 || !bOneSamplerType)
+		{
+			Job->Result.Message = Job->Textures.Num() == 0
+				? NSLOCTEXT("TextureManager", "OptimizerNoTextures", "No textures to optimize.")
+				: Compressions.Num() == 0
+				? NSLOCTEXT("TextureManager", "OptimizerUnsupported", "This compression setting can't be simulated on the CPU.")
+				: NSLOCTEXT("TextureManager", "OptimizerMixedSamplers", "The textures sample differently (e.g. color and normal maps); optimize one kind at a time.");
+			if (OnComplete)
+			{
+				OnComplete(Job->Result);
+			}
+			return;
+		}
+
+		UE::Tasks::Launch(UE_SOURCE_LOCATION,
+			[Job, Compressions, OnComplete = MoveTemp(OnComplete)]() mutable
+			{
+				FTextureOptimizerResult& Result = Job->Result;
+				const FTextureOptimizerOptions& Options = Job->Options;
+
+				// Decode every source once, one texture per work item
+				ParallelFor(Job->Textures.Num(), [&Job, &Options](int32 Index)
+					{
+						FOptimizerTexture& Entry = Job->Textures[Index];
+						Entry.bLoaded = LoadReference(Entry.Texture.Get(), Options.AnalysisSize, Entry.Reference);
+					},
+					EParallelForFlags::Unbalanced);
+
+				// A source that can't be read leaves its texture out of the
+				// search instead of failing every candidate
+				int32 NumLoaded = 0;
+				Result.CurrentBytes = 0;
+				for (int32 Index = 0; Index < Job->Textures.Num(); ++Index)
+				{
+					const FOptimizerTexture& Entry = Job->Textures[Index];
+					Result.Textures[Index].bAnalyzed = Entry.bLoaded;
+					if (Entry.bLoaded)
+					{
+						Result.CurrentBytes += Entry.CurrentBytes;
+						++NumLoaded;
+					}
+					else
+					{
+						++Result.NumUnreadable;
+					}
+				}
+
+				int32 LargestSource = 0;
+				for (const FOptimizerTexture& Entry : Job->Textures)
+				{
+					LargestSource = FMath::Max(LargestSource, FMath::Max(Entry.Inputs.SourceSizeX, Entry.Inputs.SourceSizeY));
+				}
+
+				// Candidates, current settings first so ties keep them
+				TArray<FCandidate> Candidates;
+				auto AddCandidate = [&Candidates](TextureCompressionSettings Compression, int32 MaxTextureSize, int32 LODBias)
+					{
+						for (const FCandidate& Existing : Candidates)
+						{
+							if (Existing.Compression == Compression && Existing.MaxTextureSize == MaxTextureSize && Existing.LODBias == LODBias)
+							{
+								return;
+							}
+						}
+						Candidates.Add({ Compression, MaxTextureSize, LODBias });
+					};
+
+				if (CanSimulate(Job->BaseSettings.CompressionSettings))
+				{
+					AddCandidate(Job->BaseSettings.CompressionSettings, Job->BaseSettings.MaxTextureSize, Job->BaseSettings.LODBias);
+				}
+				for (TextureCompressionSettings Compression : Compressions)
+				{
+					for (int32 MaxTextureSize : Options.MaxTextureSizes)
+					{
+						// A cap above every source changes nothing
+						if (MaxTextureSize > 0 && MaxTextureSize >= LargestSource)
+						{
+							continue;
+						}
+						for (int32 LODBias : Options.LODBiases)
+						{
+							AddCandidate(Compression, MaxTextureSize, LODBias);
+						}
+					}
+				}
+
+				// Estimate every (candidate, texture); candidates that end at the same
+				// size with the same compression share one evaluation
+				const int32 NumTextures = Job->Textures.Num();
+				TArray<int32> EvaluationIndices;
+				TArray<FTextureMemoryEstimate> Estimates;
+				EvaluationIndices.SetNumUninitialized(Candidates.Num() * NumTextures);
+				Estimates.SetNum(Candidates.Num() * NumTextures);
+
+				TArray<FEvaluation> Evaluations;
+				TArray<TMap<uint64, int32>> EvaluationsByKey;
+				EvaluationsByKey.SetNum(NumTextures);
+
+				for (int32 CandidateIndex = 0; CandidateIndex < Candidates.Num(); ++CandidateIndex)
+				{
+					const FCandidate& Candidate = Candidates[CandidateIndex];
+					for (int32 TextureIndex = 0; TextureIndex < NumTextures; ++TextureIndex)
+					{
+						FTextureMemoryInputs Inputs = Job->Textures[TextureIndex].Inputs;
+						Inputs.Settings.CompressionSettings = Candidate.Compression;
+						Inputs.Settings.MaxTextureSize = Candidate.MaxTextureSize;
+						Inputs.Settings.LODBias = Candidate.LODBias;
+
+						const int32 Slot = CandidateIndex * NumTextures + TextureIndex;
+						Estimates[Slot] = TextureMemoryEstimator::Estimate(Inputs);
+						EvaluationIndices[Slot] = INDEX_NONE;
+
+						if (!Job->Textures[TextureIndex].bLoaded)
+						{
+							continue;
+						}
+
+						const uint64 Key = uint64(Candidate.Compression)
+							| (uint64(Estimates[Slot].SizeX) << 8)
+							| (uint64(Estimates[Slot].SizeY) << 36);
+
+						if (const int32* Existing = EvaluationsByKey[TextureIndex].Find(Key))
+						{
+							EvaluationIndices[Slot] = *Existing;
+						}
+						else
+						{
+							FEvaluation& Evaluation = Evaluations.AddDefaulted_GetRef();
+							Evaluation.TextureIndex = TextureIndex;
+							Evaluation.Compression = Candidate.Compression;
+							Evaluation.SizeX = Estimates[Slot].SizeX;
+							Evaluation.SizeY = Estimates[Slot].SizeY;
+							EvaluationIndices[Slot] = Evaluations.Num() - 1;
+							EvaluationsByKey[TextureIndex].Add(Key, EvaluationIndices[Slot]);
+						}
+					}
+				}
+
+				// Compress and measure every pair across all cores
+				ParallelFor(Evaluations.Num(), [&Job, &Evaluations](int32 Index)
+					{
+						FEvaluation& Evaluation = Evaluations[Index];
+						const FOptimizerTexture& Entry = Job->Textures[Evaluation.TextureIndex];
+
+						Evaluation.Metrics = EvaluateCandidate(
+							Entry.Reference,
+							float(Entry.Reference.SizeX) / float(FMath::Max(Entry.Inputs.SourceSizeX, 1)),
+							Evaluation.Compression,
+							Entry.Inputs.bHasAlpha,
+							Evaluation.SizeX,
+							Evaluation.SizeY);
+					},
+					EParallelForFlags::Unbalanced);
+
+				Result.NumCandidates = Candidates.Num();
+				Result.NumEvaluations = Evaluations.Num();
+
+				// Smallest candidate every texture accepts; cooked size breaks ties
+				int32 BestCandidate = INDEX_NONE;
+				int64 BestBytes = 0;
+				int64 BestCookedBytes = 0;
+
+				for (int32 CandidateIndex = 0; CandidateIndex < Candidates.Num(); ++CandidateIndex)
+				{
+					int64 Bytes = 0;
+					int64 CookedBytes = 0;
+					bool bAccepted = true;
+
+					for (int32 TextureIndex = 0; TextureIndex < NumTextures && bAccepted; ++TextureIndex)
+					{
+						if (!Job->Textures[TextureIndex].bLoaded)
+						{
+							continue;
+						}
+
+						const int32 Slot = CandidateIndex * NumTextures + TextureIndex;
+						if (EvaluationIndices[Slot] == INDEX_NONE)
+						{
+							bAccepted = false;
+							break;
+						}
+
+						const FTextureQualityMetrics& Metrics = Evaluations[EvaluationIndices[Slot]].Metrics;
+						bAccepted = Metrics.PSNR >= Options.MinPSNR && Metrics.SSIM >= Options.MinSSIM;
+						Bytes += Estimates[Slot].GetTotalBytes();
+						CookedBytes += Estimates[Slot].CookedBytes;
+					}
+
+					if (bAccepted && (BestCandidate == INDEX_NONE || Bytes < BestBytes || (Bytes == BestBytes && CookedBytes < BestCookedBytes)))
+					{
+						BestCandidate = CandidateIndex;
+						BestBytes = Bytes;
+						BestCookedBytes = CookedBytes;
+					}
+				}
+
+				if (NumLoaded == 0)
+				{
+					Result.Message = NSLOCTEXT("TextureManager", "OptimizerUnreadable", "None of the texture sources could be read.");
+				}
+				else if (BestCandidate == INDEX_NONE)
+				{
+					Result.Message = NSLOCTEXT("TextureManager", "OptimizerNoCandidate", "No combination meets the quality thresholds for every texture.");
+				}
+				else if (BestBytes >= Result.CurrentBytes)
+				{
+					Result.Message = NSLOCTEXT("TextureManager", "OptimizerNoSavings", "The current settings are already the smallest that meet the quality thresholds.");
+				}
+				else
+				{
+					const FCandidate& Candidate = Candidates[BestCandidate];
+					Result.bFound = true;
+					Result.Settings.CompressionSettings = Candidate.Compression;
+					Result.Settings.MaxTextureSize = Candidate.MaxTextureSize;
+					Result.Settings.LODBias = Candidate.LODBias;
+					Result.OptimizedBytes = BestBytes;
+					Result.WorstMetrics.PSNR = MaxPSNR;
+					Result.WorstMetrics.SSIM = 1.f;
+
+					for (int32 TextureIndex = 0; TextureIndex < NumTextures; ++TextureIndex)
+					{
+						if (!Job->Textures[TextureIndex].bLoaded)
+						{
+							continue;
+						}
+
+						const int32 Slot = BestCandidate * NumTextures + TextureIndex;
+						FTextureOptimizerTextureResult& TextureResult = Result.Textures[TextureIndex];
+						TextureResult.Metrics = Evaluations[EvaluationIndices[Slot]].Metrics;
+						TextureResult.OptimizedBytes = Estimates[Slot].GetTotalBytes();
+
+						Result.WorstMetrics.PSNR = FMath::Min(Result.WorstMetrics.PSNR, TextureResult.Metrics.PSNR);
+						Result.WorstMetrics.SSIM = FMath::Min(Result.WorstMetrics.SSIM, TextureResult.Metrics.SSIM);
+					}
+				}
+
+				// The decoded references are the bulk of the job's memory
+				for (FOptimizerTexture& Entry : Job->Textures)
+				{
+					Entry.Reference = FImage();
+				}
+
+				AsyncTask(ENamedThreads::GameThread, [Job, OnComplete = MoveTemp(OnComplete)]()
+					{
+						// Strong references must be released on the game thread
+						Job->Textures.Empty();
+
+						if (OnComplete)
+						{
+							OnComplete(Job->Result);
+						}
+					});
+			},
+			UE::Tasks::ETaskPriority::BackgroundNormal);
+	}
+
+	UTexturePresetAsset* WriteToPreset(
+		const FTextureOptimizerResult& Result,
+		UTexturePresetAsset* Preset,
+		const FString& PackagePath,
+		FName PresetName)
+	{
+		check(IsInGameThread());
+
+		if (!Result.bFound)
+		{
+			return nullptr;
+		}
+
+		if (!Preset)
+		{
+			Preset = TexturePresetLibrary::CreatePresetAsset(PackagePath, PresetName);
+			if (!Preset)
+			{
+				return nullptr;
+			}
+
+			// A new preset carries only what the search chose; each texture
+			// keeps the rest of its own settings
+			Preset->AppliedFields = {
+				GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, CompressionSettings),
+				GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, MaxTextureSize),
+				GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, LODBias) };
+		}
+
+		Preset->Modify();
+		Preset->Settings = Result.Settings;
+		if (Preset->ParentPreset)
+		{
+			// Only what the search chose, the rest keeps following the parent
+			Preset->OverriddenFields.AddUnique(GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, CompressionSettings));
+			Preset->OverriddenFields.AddUnique(GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, MaxTextureSize));
+			Preset->OverriddenFields.AddUnique(GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, LODBias));
+		}
+		Preset->NotifySettingsChanged();
+		Preset->MarkPackageDirty();
+
+		const FGuid JournalBatch = TextureBulkJournal::BeginBatch(TEXT("Optimize ") + Preset->GetName());
+		for (const FTextureOptimizerTextureResult& TextureResult : Result.Textures)
+		{
+			// Not measured, so not known to survive the new settings
+			if (!TextureResult.bAnalyzed)
+			{
+				continue;
+			}
+
+			if (UTexture2D* Texture = TextureResult.Texture.Get())
+			{
+				Texture->Modify();
+				TexturePresetLibrary::AssignPresetToTexture(Preset, Texture);
+				TextureRebuildScheduler::Enqueue(Preset, Texture, JournalBatch);
+			}
+		}
+
+		return Preset;
+	}
+}
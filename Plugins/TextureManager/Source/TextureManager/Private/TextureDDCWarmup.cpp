@@ -0,0 +1,279 @@
+#include "TextureDDCWarmup.h"
+
+#include "TextureFolderPresets.h"
+#include "TextureManagerSettings.h"
+#include "TexturePresetAsset.h"
+#include "TexturePresetCook.h"
+#include "TexturePresetLibrary.h"
+
+#include "Algo/AllOf.h"
+#include "AssetCompilingManager.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "DerivedDataCacheInterface.h"
+#include "DerivedDataCacheUsageStats.h"
+#include "Engine/Texture2D.h"
+#include "Interfaces/ITargetPlatform.h"
+#include "Interfaces/ITargetPlatformManagerModule.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace
+{
+	struct FTextureCacheCounts
+	{
+		int64 Loads = 0;
+		int64 Builds = 0;
+	};
+
+	FTextureCacheCounts GetTextureCacheCounts()
+	{
+		TArray<FDerivedDataCacheResourceStat> Stats;
+		GetDerivedDataCacheRef().GatherResourceStats(Stats);
+
+		// One row per texture kind ("Texture", "Texture (Streaming)", ...)
+		FTextureCacheCounts Counts;
+		for (const FDerivedDataCacheResourceStat& Stat : Stats)
+		{
+			if (Stat.AssetType.StartsWith(TEXT("Texture")))
+			{
+				Counts.Loads += Stat.LoadCount;
+				Counts.Builds += Stat.BuildCount;
+			}
+		}
+		return Counts;
+	}
+
+	// Textures loaded between garbage collections; everything else Run loads
+	// would stay loaded until the end
+	constexpr int32 TexturesPerGarbageCollection = 256;
+
+	// A texture builds one platform at a time: the cook-time preset is applied
+	// per platform, and applying drops the cooked data of the previous one.
+	// As for a multi-platform cook, all platforms build at once (PlatformIndex
+	// stays 0 until they are all done).
+	struct FInFlightTexture
+	{
+		TStrongObjectPtr<UTexture2D> Texture;
+		int32 PlatformIndex = 0;
+	};
+
+	// The settings and DDC key a cook of just this platform uses
+	void BeginPlatform(UTexture2D* Texture, const ITargetPlatform* Platform)
+	{
+		TexturePresetCook::ApplyForCook(Texture, FName(*Platform->IniPlatformName()));
+		Texture->BeginCacheForCookedPlatformData(Platform);
+	}
+
+	// The settings and DDC key a cook of all the platforms together uses
+	void BeginAllPlatforms(UTexture2D* Texture, const TArray<const ITargetPlatform*>& Platforms)
+	{
+		TexturePresetCook::ApplyForCook(Texture, NAME_None);
+		for (const ITargetPlatform* Platform : Platforms)
+		{
+			Texture->BeginCacheForCookedPlatformData(Platform);
+		}
+	}
+}
+
+namespace TextureDDCWarmup
+{
+	TArray<FSoftObjectPath> GetAffectedTextures(const TArray<UTexturePresetAsset*>& Presets)
+	{
+		TArray<FAssetData> PresetAssets;
+		IAssetRegistry::GetChecked().GetAssetsByClass(UTexturePresetAsset::StaticClass()->GetClassPathName(), PresetAssets, true);
+
+		TArray<TWeakObjectPtr<UTexturePresetAsset>> AllPresets;
+		for (const FAssetData& Asset : PresetAssets)
+		{
+			AllPresets.Add(Cast<UTexturePresetAsset>(Asset.GetAsset()));
+		}
+
+		TSet<UTexturePresetAsset*> Affected;
+		for (UTexturePresetAsset* Preset : Presets)
+		{
+			if (Preset)
+			{
+				Affected.Add(Preset);
+				Affected.Append(TexturePresetLibrary::GetDerivedPresets(Preset, AllPresets));
+			}
+		}
+
+		TSet<FSoftObjectPath> Textures;
+		for (const UTexturePresetAsset* Preset : Affected)
+		{
+			for (UTexture2D* Texture : Preset->Files)
+			{
+				if (Texture)
+				{
+					Textures.Add(FSoftObjectPath(Texture));
+				}
+			}
+		}
+
+		// Folder members that were never linked (cook-time presets only relink on save)
+		for (const FTextureFolderPreset& Entry : GetDefault<UTextureManagerSettings>()->FolderPresets)
+		{
+			if (!Affected.Contains(Entry.Preset.Get()))
+			{
+				continue;
+			}
+			for (const FAssetData& Asset : TextureFolderPresets::GetFolderMembers(Entry.Folder.Path))
+			{
+				UTexture2D* Texture = Cast<UTexture2D>(Asset.GetAsset());
+				if (Texture && Affected.Contains(TextureFolderPresets::GetEffectivePreset(Texture)))
+				{
+					Textures.Add(Asset.GetSoftObjectPath());
+				}
+			}
+		}
+
+		return Textures.Array();
+	}
+
+	TArray<const ITargetPlatform*> GetWarmupPlatforms()
+	{
+		ITargetPlatformManagerModule& PlatformManager = GetTargetPlatformManagerRef();
+
+		TArray<const ITargetPlatform*> Platforms;
+		for (const FString& Name : GetDefault<UTextureManagerSettings>()->WarmupPlatforms)
+		{
+			if (const ITargetPlatform* Platform = PlatformManager.FindTargetPlatform(Name))
+			{
+				Platforms.AddUnique(Platform);
+			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("DDC warm-up: unknown target platform %s"), *Name);
+			}
+		}
+
+		if (Platforms.IsEmpty())
+		{
+			for (const ITargetPlatform* Platform : PlatformManager.GetActiveTargetPlatforms())
+			{
+				Platforms.Add(Platform);
+			}
+		}
+		return Platforms;
+	}
+
+	FTextureDDCWarmupStats Run(
+		const TArray<FSoftObjectPath>& Textures,
+		const TArray<const ITargetPlatform*>& Platforms,
+		int32 MaxInFlight,
+		bool bMultiPlatformCook)
+	{
+		FTextureDDCWarmupStats Stats;
+		Stats.NumPlatforms = Platforms.Num();
+		if (Textures.IsEmpty() || Platforms.IsEmpty())
+		{
+			return Stats;
+		}
+
+		const double StartSeconds = FPlatformTime::Seconds();
+		const FTextureCacheCounts CountsBefore = GetTextureCacheCounts();
+		MaxInFlight = FMath::Max(MaxInFlight, 1);
+
+		TArray<FInFlightTexture> InFlight;
+		double LastProgressSeconds = StartSeconds;
+
+		// Release what finished; returns once below Limit
+		auto WaitBelow = [&](int32 Limit)
+		{
+			while (InFlight.Num() >= Limit && InFlight.Num() > 0)
+			{
+				FAssetCompilingManager::Get().ProcessAsyncTasks(true);
+
+				for (int32 Index = InFlight.Num() - 1; Index >= 0; --Index)
+				{
+					FInFlightTexture& Entry = InFlight[Index];
+					UTexture2D* Texture = Entry.Texture.Get();
+					if (bMultiPlatformCook)
+					{
+						const bool bAllLoaded = Algo::AllOf(Platforms, [Texture](const ITargetPlatform* Platform)
+							{
+								return Texture->IsCachedCookedPlatformDataLoaded(Platform);
+							});
+						if (!bAllLoaded)
+						{
+							continue;
+						}
+
+						Texture->ClearAllCachedCookedPlatformData();
+						++Stats.NumTextures;
+						InFlight.RemoveAtSwap(Index);
+						continue;
+					}
+
+					const ITargetPlatform* Platform = Platforms[Entry.PlatformIndex];
+					if (!Texture->IsCachedCookedPlatformDataLoaded(Platform))
+					{
+						continue;
+					}
+
+					Texture->ClearCachedCookedPlatformData(Platform);
+					if (++Entry.PlatformIndex < Platforms.Num())
+					{
+						BeginPlatform(Texture, Platforms[Entry.PlatformIndex]);
+						continue;
+					}
+
+					++Stats.NumTextures;
+					InFlight.RemoveAtSwap(Index);
+				}
+
+				if (InFlight.Num() >= Limit)
+				{
+					FPlatformProcess::Sleep(0.005f);
+				}
+
+				const double Now = FPlatformTime::Seconds();
+				if (Now - LastProgressSeconds > 10.0)
+				{
+					LastProgressSeconds = Now;
+					UE_LOG(LogTemp, Display, TEXT("DDC warm-up: %d / %d textures"), Stats.NumTextures, Textures.Num());
+				}
+			}
+		};
+
+		int32 NumLoaded = 0;
+		for (const FSoftObjectPath& Path : Textures)
+		{
+			// In-flight textures are held; everything else loaded so far may go
+			if (NumLoaded > 0 && NumLoaded % TexturesPerGarbageCollection == 0)
+			{
+				CollectGarbage(RF_NoFlags);
+			}
+
+			UTexture2D* Texture = Cast<UTexture2D>(Path.TryLoad());
+			++NumLoaded;
+
+			// Nothing to build from (e.g. source stripped); the cook would fail on it too
+			if (!Texture || !Texture->Source.IsValid())
+			{
+				UE_LOG(LogTemp, Warning, TEXT("DDC warm-up: %s has no source data"), *Path.ToString());
+				++Stats.NumSkipped;
+				continue;
+			}
+
+			WaitBelow(MaxInFlight);
+
+			if (bMultiPlatformCook)
+			{
+				BeginAllPlatforms(Texture, Platforms);
+			}
+			else
+			{
+				BeginPlatform(Texture, Platforms[0]);
+			}
+			InFlight.Add({ TStrongObjectPtr<UTexture2D>(Texture), 0 });
+		}
+		WaitBelow(1);
+
+		const FTextureCacheCounts CountsAfter = GetTextureCacheCounts();
+		Stats.CacheHits = CountsAfter.Loads - CountsBefore.Loads;
+		Stats.CacheMisses = CountsAfter.Builds - CountsBefore.Builds;
+		Stats.Seconds = FPlatformTime::Seconds() - StartSeconds;
+		return Stats;
+	}
+}
@@ -0,0 +1,125 @@
+#include "TextureDDCWarmupCommandlet.h"
+
+#include "TextureDDCWarmup.h"
+#include "TextureManagerSettings.h"
+#include "TexturePresetAsset.h"
+
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Texture2D.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	// Package names of the preset assets in a list of changed files
+	TSet<FName> ReadChangedPackages(const FString& ListPath)
+	{
+		TSet<FName> Packages;
+
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *ListPath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Could not read %s"), *ListPath);
+			return Packages;
+		}
+
+		for (FString& Line : Lines)
+		{
+			Line.TrimStartAndEndInline();
+			if (!Line.EndsWith(FPackageName::GetAssetPackageExtension()))
+			{
+				continue;
+			}
+
+			// Paths from version control are relative to the repository root
+			FString Filename = FPaths::IsRelative(Line) ? FPaths::ConvertRelativePathToFull(FPaths::RootDir(), Line) : Line;
+			FString PackageName;
+			if (!FPackageName::TryConvertFilenameToLongPackageName(Filename, PackageName))
+			{
+				Filename = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), Line);
+				if (!FPackageName::TryConvertFilenameToLongPackageName(Filename, PackageName))
+				{
+					continue;
+				}
+			}
+			Packages.Add(FName(*PackageName));
+		}
+		return Packages;
+	}
+}
+
+UTextureDDCWarmupCommandlet::UTextureDDCWarmupCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UTextureDDCWarmupCommandlet::Main(const FString& Params)
+{
+	IAssetRegistry::GetChecked().SearchAllAssets(true);
+
+	FString PresetList;
+	FParse::Value(*Params, TEXT("presets="), PresetList, false);
+	TArray<FString> PresetNames;
+	PresetList.ParseIntoArray(PresetNames, TEXT(","));
+
+	FString ChangedList;
+	TSet<FName> ChangedPackages;
+	if (FParse::Value(*Params, TEXT("changed="), ChangedList))
+	{
+		ChangedPackages = ReadChangedPackages(ChangedList);
+	}
+
+	const bool bAll = FParse::Param(*Params, TEXT("all"));
+
+	// The cook to warm up for builds all its platforms in one go
+	const bool bMultiPlatformCook = FParse::Param(*Params, TEXT("multiplatform"));
+
+	int32 MaxInFlight = GetDefault<UTextureManagerSettings>()->WarmupMaxInFlight;
+	FParse::Value(*Params, TEXT("maxinflight="), MaxInFlight);
+
+	TArray<FAssetData> PresetAssets;
+	IAssetRegistry::GetChecked().GetAssetsByClass(UTexturePresetAsset::StaticClass()->GetClassPathName(), PresetAssets, true);
+
+	TArray<UTexturePresetAsset*> Presets;
+	for (const FAssetData& Asset : PresetAssets)
+	{
+		if (bAll || PresetNames.Contains(Asset.AssetName.ToString()) || ChangedPackages.Contains(Asset.PackageName))
+		{
+			if (UTexturePresetAsset* Preset = Cast<UTexturePresetAsset>(Asset.GetAsset()))
+			{
+				Presets.Add(Preset);
+			}
+		}
+	}
+
+	if (Presets.IsEmpty())
+	{
+		UE_LOG(LogTemp, Display, TEXT("DDC warm-up: no preset changed, nothing to do"));
+		return 0;
+	}
+
+	const TArray<const ITargetPlatform*> Platforms = TextureDDCWarmup::GetWarmupPlatforms();
+	if (Platforms.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("DDC warm-up: no target platform"));
+		return 1;
+	}
+
+	const TArray<FSoftObjectPath> Textures = TextureDDCWarmup::GetAffectedTextures(Presets);
+	UE_LOG(LogTemp, Display, TEXT("DDC warm-up: %d presets, %d textures, %d platforms%s, %d at a time"),
+		Presets.Num(), Textures.Num(), Platforms.Num(), bMultiPlatformCook ? TEXT(" (one cook)") : TEXT(""), MaxInFlight);
+
+	const FTextureDDCWarmupStats Stats = TextureDDCWarmup::Run(Textures, Platforms, MaxInFlight, bMultiPlatformCook);
+
+	const int64 NumRequests = Stats.CacheHits + Stats.CacheMisses;
+	UE_LOG(LogTemp, Display, TEXT("DDC warm-up: %d textures in %.1f s, %lld cache hits, %lld misses (%.0f%% hit), %d skipped"),
+		Stats.NumTextures, Stats.Seconds, Stats.CacheHits, Stats.CacheMisses,
+		NumRequests > 0 ? 100.0 * double(Stats.CacheHits) / double(NumRequests) : 100.0,
+		Stats.NumSkipped);
+
+	return Stats.NumSkipped > 0 ? 2 : 0;
+}
@@ -0,0 +1,650 @@
+#include "TextureDuplicateFinder.h"
+
+#include "TextureManagerMetrics.h"
+#include "TextureMemoryEstimator.h"
+#include "TexturePresetLibrary.h"
+
+#include "Engine/Texture2D.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "FileHelpers.h"
+#include "Hash/Blake3.h"
+#include "ImageCore.h"
+#include "Math/VectorRegister.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ObjectTools.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Tasks/Task.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace
+{
+	// Luminance grid the perceptual hash is taken from, and the low frequency
+	// corner of its DCT that ends up in the hash
+	constexpr int32 GridSize = 32;
+	constexpr int32 DctSize = 8;
+
+	constexpr int32 CacheFileVersion = 1;
+
+	// Game thread only
+	TMap<FIoHash, FTextureContentHash> GHashesByPackageHash;
+
+	struct FDirtyHash
+	{
+		FGuid SourceId;
+		FTextureContentHash Hash;
+	};
+	TMap<FName, FDirtyHash> GDirtyHashes;
+
+	bool GCacheLoaded = false;
+
+	FString GetCacheFilePath()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("TextureManager") / TEXT("ContentHashes.bin");
+	}
+
+	void SerializeCache(FArchive& Ar)
+	{
+		int32 Version = CacheFileVersion;
+		Ar << Version;
+		if (Version != CacheFileVersion)
+		{
+			return;
+		}
+
+		int32 Num = GHashesByPackageHash.Num();
+		Ar << Num;
+
+		if (Ar.IsLoading())
+		{
+			GHashesByPackageHash.Reserve(Num);
+			for (int32 Index = 0; Index < Num && !Ar.IsError(); ++Index)
+			{
+				FIoHash PackageHash;
+				FTextureContentHash Hash;
+				Ar << PackageHash << Hash.Exact << Hash.Perceptual;
+				GHashesByPackageHash.Add(PackageHash, Hash);
+			}
+		}
+		else
+		{
+			for (TPair<FIoHash, FTextureContentHash>& Pair : GHashesByPackageHash)
+			{
+				Ar << Pair.Key << Pair.Value.Exact << Pair.Value.Perceptual;
+			}
+		}
+	}
+
+	void LoadCache()
+	{
+		if (GCacheLoaded)
+		{
+			return;
+		}
+		GCacheLoaded = true;
+
+		TArray<uint8> Bytes;
+		if (FFileHelper::LoadFileToArray(Bytes, *GetCacheFilePath(), FILEREAD_Silent))
+		{
+			FMemoryReader Reader(Bytes);
+			SerializeCache(Reader);
+			if (Reader.IsError())
+			{
+				GHashesByPackageHash.Reset();
+			}
+		}
+	}
+
+	void SaveCache()
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		SerializeCache(Writer);
+		FFileHelper::SaveArrayToFile(Bytes, *GetCacheFilePath());
+	}
+
+	// Zero for packages with unsaved changes: the saved hash doesn't describe them
+	FIoHash GetPackageHash(FName PackageName, const UTexture2D* Texture)
+	{
+		if (Texture && Texture->GetOutermost()->IsDirty())
+		{
+			return FIoHash::Zero;
+		}
+
+		if (TOptional<FAssetPackageData> PackageData = IAssetRegistry::GetChecked().GetAssetPackageDataCopy(PackageName))
+		{
+			return PackageData->GetPackageSavedHash();
+		}
+		return FIoHash::Zero;
+	}
+
+	FGuid GetSourceId(const UTexture2D* Texture)
+	{
+#if WITH_EDITOR
+		return Texture->Source.GetId();
+#else
+		return FGuid();
+#endif
+	}
+
+	// cos((2x + 1) u pi / 2N), orthonormal scale; rows padded to whole vectors
+	struct FDctTable
+	{
+		alignas(16) float Rows[DctSize][GridSize];
+
+		FDctTable()
+		{
+			for (int32 U = 0; U < DctSize; ++U)
+			{
+				const float Scale = (U == 0) ? FMath::Sqrt(1.f / GridSize) : FMath::Sqrt(2.f / GridSize);
+				for (int32 X = 0; X < GridSize; ++X)
+				{
+					Rows[U][X] = Scale * FMath::Cos((2.f * X + 1.f) * U * PI / (2.f * GridSize));
+				}
+			}
+		}
+	};
+
+	const FDctTable& GetDctTable()
+	{
+		static const FDctTable Table;
+		return Table;
+	}
+
+	// Box filter straight from BGRA8, one pixel per register
+	void DownsampleBGRA8(const FImage& Image, float* OutLuma)
+	{
+		const uint8* Pixels = Image.RawData.GetData();
+		const int64 Stride = int64(Image.SizeX) * 4;
+
+		// Rec. 601 weights in B, G, R order
+		const VectorRegister4Float Weights = MakeVectorRegisterFloat(0.114f / 255.f, 0.587f / 255.f, 0.299f / 255.f, 0.f);
+
+		ParallelFor(GridSize, [&](int32 CellY)
+			{
+				const int32 Y0 = CellY * Image.SizeY / GridSize;
+				const int32 Y1 = FMath::Max((CellY + 1) * Image.SizeY / GridSize, Y0 + 1);
+
+				for (int32 CellX = 0; CellX < GridSize; ++CellX)
+				{
+					const int32 X0 = CellX * Image.SizeX / GridSize;
+					const int32 X1 = FMath::Max((CellX + 1) * Image.SizeX / GridSize, X0 + 1);
+
+					VectorRegister4Float Sum = VectorZero();
+					for (int32 Y = Y0; Y < Y1; ++Y)
+					{
+						const uint8* Row = Pixels + Y * Stride;
+						for (int32 X = X0; X < X1; ++X)
+						{
+							Sum = VectorAdd(Sum, VectorLoadByte4(Row + X * 4));
+						}
+					}
+
+					const float Count = float((Y1 - Y0) * (X1 - X0));
+					OutLuma[CellY * GridSize + CellX] = VectorGetComponent(VectorDot3(Sum, Weights), 0) / Count;
+				}
+			});
+	}
+
+	// Everything else: let ImageCore resize, then take luminance
+	void DownsampleGeneric(const FImage& Image, float* OutLuma)
+	{
+		FImage Small;
+		Image.ResizeTo(Small, GridSize, GridSize, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+
+		const float* Pixels = reinterpret_cast<const float*>(Small.RawData.GetData());
+		const VectorRegister4Float Weights = MakeVectorRegisterFloat(0.299f, 0.587f, 0.114f, 0.f);
+
+		for (int32 Index = 0; Index < GridSize * GridSize; ++Index)
+		{
+			OutLuma[Index] = VectorGetComponent(VectorDot3(VectorLoad(Pixels + Index * 4), Weights), 0);
+		}
+	}
+
+	float HorizontalSum(VectorRegister4Float Vector)
+	{
+		alignas(16) float Lanes[4];
+		VectorStoreAligned(Vector, Lanes);
+		return Lanes[0] + Lanes[1] + Lanes[2] + Lanes[3];
+	}
+
+	// Low frequency 8x8 corner of the 32x32 DCT-II: C * L * C^T
+	void LowFrequencyDct(const float* Luma, float* OutCoefficients)
+	{
+		const FDctTable& Table = GetDctTable();
+
+		// 1) Rows: Temp[y][v] = sum_x L[y][x] * C[v][x]
+		alignas(16) float Temp[GridSize][DctSize];
+		for (int32 Y = 0; Y < GridSize; ++Y)
+		{
+			const float* Row = Luma + Y * GridSize;
+			for (int32 V = 0; V < DctSize; ++V)
+			{
+				VectorRegister4Float Acc = VectorZero();
+				for (int32 X = 0; X < GridSize; X += 4)
+				{
+					Acc = VectorMultiplyAdd(VectorLoad(Row + X), VectorLoadAligned(&Table.Rows[V][X]), Acc);
+				}
+				Temp[Y][V] = HorizontalSum(Acc);
+			}
+		}
+
+		// 2) Columns: Out[u][v] = sum_y C[u][y] * Temp[y][v], eight v at a time
+		for (int32 U = 0; U < DctSize; ++U)
+		{
+			VectorRegister4Float Low = VectorZero();
+			VectorRegister4Float High = VectorZero();
+			for (int32 Y = 0; Y < GridSize; ++Y)
+			{
+				const VectorRegister4Float Weight = VectorSetFloat1(Table.Rows[U][Y]);
+				Low = VectorMultiplyAdd(Weight, VectorLoadAligned(&Temp[Y][0]), Low);
+				High = VectorMultiplyAdd(Weight, VectorLoadAligned(&Temp[Y][4]), High);
+			}
+			VectorStore(Low, OutCoefficients + U * DctSize);
+			VectorStore(High, OutCoefficients + U * DctSize + 4);
+		}
+	}
+
+	FTextureContentHash HashSource(UTexture2D* Texture)
+	{
+#if WITH_EDITOR
+		if (!Texture || !Texture->Source.IsValid())
+		{
+			return FTextureContentHash();
+		}
+
+		FImage Image;
+		if (!Texture->Source.GetMipImage(Image, 0, 0, 0))
+		{
+			return FTextureContentHash();
+		}
+
+		return TextureDuplicateFinder::ComputeHash(Image);
+#else
+		return FTextureContentHash();
+#endif
+	}
+
+	FTextureContentHash FindCachedHash(FName PackageName, const UTexture2D* Texture)
+	{
+		check(IsInGameThread());
+		LoadCache();
+
+		const FIoHash PackageHash = GetPackageHash(PackageName, Texture);
+		if (!PackageHash.IsZero())
+		{
+			const FTextureContentHash* Found = GHashesByPackageHash.Find(PackageHash);
+			return Found ? *Found : FTextureContentHash();
+		}
+
+		const FDirtyHash* Dirty = Texture ? GDirtyHashes.Find(PackageName) : nullptr;
+		return (Dirty && Dirty->SourceId == GetSourceId(Texture)) ? Dirty->Hash : FTextureContentHash();
+	}
+
+	// Union-find over cluster candidates
+	int32 FindRoot(TArray<int32>& Parents, int32 Index)
+	{
+		while (Parents[Index] != Index)
+		{
+			Parents[Index] = Parents[Parents[Index]];
+			Index = Parents[Index];
+		}
+		return Index;
+	}
+
+	// Copies that differ in these build to different data and are not interchangeable
+	bool HaveSameBuildSettings(const TArray<FAssetData>& Assets)
+	{
+		static const FName Tags[] = { FName(TEXT("CompressionSettings")), FName(TEXT("SRGB")), FName(TEXT("LODGroup")) };
+		for (const FName Tag : Tags)
+		{
+			const FString KeeperValue = Assets[0].GetTagValueRef<FString>(Tag);
+			for (int32 Index = 1; Index < Assets.Num(); ++Index)
+			{
+				if (Assets[Index].GetTagValueRef<FString>(Tag) != KeeperValue)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+#if WITH_EDITOR
+	// Preset packages that lost a copy are added to PackagesToSave, not saved
+	bool ConsolidateOne(const FTextureDuplicateCluster& Cluster, TArray<UPackage*>& PackagesToSave)
+	{
+		if (Cluster.Assets.Num() < 2)
+		{
+			return true;
+		}
+
+		UTexture2D* Keeper = Cast<UTexture2D>(Cluster.Assets[0].GetAsset());
+		if (!Keeper)
+		{
+			return false;
+		}
+
+		TArray<UObject*> Copies;
+		for (int32 Index = 1; Index < Cluster.Assets.Num(); ++Index)
+		{
+			if (UTexture2D* Copy = Cast<UTexture2D>(Cluster.Assets[Index].GetAsset()))
+			{
+				// Keep the preset Files lists consistent; the copy is about to go away
+				TexturePresetLibrary::RemovePresetFromTexture(Copy, &PackagesToSave);
+				Copies.Add(Copy);
+			}
+		}
+
+		if (Copies.Num() == 0)
+		{
+			return false;
+		}
+
+		const ObjectTools::FConsolidationResults Results = ObjectTools::ConsolidateObjects(Keeper, Copies, false);
+		return Results.FailedConsolidationObjs.Num() == 0 && Results.InvalidConsolidationObjs.Num() == 0;
+	}
+#endif
+}
+
+namespace TextureDuplicateFinder
+{
+	FTextureContentHash ComputeHash(const FImage& Image)
+	{
+		FTextureContentHash Hash;
+		if (Image.SizeX <= 0 || Image.SizeY <= 0 || Image.RawData.Num() == 0)
+		{
+			return Hash;
+		}
+
+		// Exact: anything that changes the stored pixels changes this
+		FBlake3 Hasher;
+		const int32 Header[3] = { Image.SizeX, Image.SizeY, int32(Image.Format) };
+		Hasher.Update(Header, sizeof(Header));
+		Hasher.Update(Image.RawData.GetData(), Image.RawData.Num());
+		Hash.Exact = FIoHash(Hasher.Finalize());
+
+		// Perceptual: sign of the low frequencies against their median
+		alignas(16) float Luma[GridSize * GridSize];
+		if (Image.Format == ERawImageFormat::BGRA8)
+		{
+			DownsampleBGRA8(Image, Luma);
+		}
+		else
+		{
+			DownsampleGeneric(Image, Luma);
+		}
+
+		alignas(16) float Coefficients[DctSize * DctSize];
+		LowFrequencyDct(Luma, Coefficients);
+
+		// The DC term only carries overall brightness; leave it out of the median
+		TArray<float, TInlineAllocator<DctSize * DctSize>> Sorted(Coefficients + 1, DctSize * DctSize - 1);
+		Sorted.Sort();
+		const float Median = Sorted[Sorted.Num() / 2];
+
+		for (int32 Index = 1; Index < DctSize * DctSize; ++Index)
+		{
+			if (Coefficients[Index] > Median)
+			{
+				Hash.Perceptual |= uint64(1) << Index;
+			}
+		}
+
+		return Hash;
+	}
+
+	FTextureContentHash FindHash(const FAssetData& Asset)
+	{
+		return FindCachedHash(Asset.PackageName, Cast<UTexture2D>(Asset.FastGetAsset(false)));
+	}
+
+	void ComputeHashesAsync(const TArray<UTexture2D*>& Textures, TFunction<void()> OnComplete)
+	{
+		check(IsInGameThread());
+		LoadCache();
+
+		struct FJob
+		{
+			TArray<TStrongObjectPtr<UTexture2D>> Textures;
+			TArray<FName> PackageNames;
+			TArray<FIoHash> PackageHashes;
+			TArray<FGuid> SourceIds;
+			TArray<FTextureContentHash> Results;
+		};
+
+		TSharedRef<FJob, ESPMode::ThreadSafe> Job = MakeShared<FJob, ESPMode::ThreadSafe>();
+
+		for (UTexture2D* Texture : Textures)
+		{
+			if (!Texture)
+			{
+				continue;
+			}
+
+			const FName PackageName = Texture->GetOutermost()->GetFName();
+			if (FindCachedHash(PackageName, Texture).IsValid())
+			{
+				continue;
+			}
+
+			Job->Textures.Emplace(Texture);
+			Job->PackageNames.Add(PackageName);
+			Job->PackageHashes.Add(GetPackageHash(PackageName, Texture));
+			Job->SourceIds.Add(GetSourceId(Texture));
+		}
+
+		if (Job->Textures.Num() == 0)
+		{
+			if (OnComplete)
+			{
+				OnComplete();
+			}
+			return;
+		}
+
+		Job->Results.SetNum(Job->Textures.Num());
+
+		UE::Tasks::Launch(UE_SOURCE_LOCATION,
+			[Job, OnComplete = MoveTemp(OnComplete)]() mutable
+			{
+				ParallelFor(Job->Textures.Num(), [&Job](int32 Index)
+					{
+						Job->Results[Index] = HashSource(Job->Textures[Index].Get());
+					},
+					EParallelForFlags::Unbalanced);
+
+				AsyncTask(ENamedThreads::GameThread, [Job, OnComplete = MoveTemp(OnComplete)]()
+					{
+						bool bAddedSaved = false;
+						for (int32 Index = 0; Index < Job->Textures.Num(); ++Index)
+						{
+							const FTextureContentHash& Hash = Job->Results[Index];
+							if (!Hash.IsValid())
+							{
+								continue;
+							}
+
+							if (!Job->PackageHashes[Index].IsZero())
+							{
+								GHashesByPackageHash.Add(Job->PackageHashes[Index], Hash);
+								bAddedSaved = true;
+							}
+							else
+							{
+								GDirtyHashes.Add(Job->PackageNames[Index], { Job->SourceIds[Index], Hash });
+							}
+						}
+
+						if (bAddedSaved)
+						{
+							SaveCache();
+						}
+
+						// Strong references must be released on the game thread
+						Job->Textures.Empty();
+
+						if (OnComplete)
+						{
+							OnComplete();
+						}
+					});
+			},
+			UE::Tasks::ETaskPriority::BackgroundNormal);
+	}
+
+	TArray<FTextureDuplicateCluster> FindClusters(const TArray<FAssetData>& Assets, int32 MaxHammingDistance)
+	{
+		check(IsInGameThread());
+
+		TArray<FAssetData> Hashed;
+		TArray<FTextureContentHash> Hashes;
+		for (const FAssetData& Asset : Assets)
+		{
+			const FTextureContentHash Hash = FindHash(Asset);
+			if (Hash.IsValid())
+			{
+				Hashed.Add(Asset);
+				Hashes.Add(Hash);
+			}
+		}
+
+		const int32 Num = Hashed.Num();
+		TArray<int32> Parents;
+		Parents.SetNum(Num);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Parents[Index] = Index;
+		}
+
+		// 1) Identical pixels
+		TMap<FIoHash, int32> FirstByExact;
+		TArray<int32> Representatives;
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			if (const int32* First = FirstByExact.Find(Hashes[Index].Exact))
+			{
+				Parents[Index] = *First;
+			}
+			else
+			{
+				FirstByExact.Add(Hashes[Index].Exact, Index);
+				Representatives.Add(Index);
+			}
+		}
+
+		// 2) Near duplicates between distinct images; all pairs, rows split across cores
+		if (MaxHammingDistance > 0)
+		{
+			TArray<TArray<int32>> Matches;
+			Matches.SetNum(Representatives.Num());
+
+			ParallelFor(Representatives.Num(), [&](int32 A)
+				{
+					const uint64 HashA = Hashes[Representatives[A]].Perceptual;
+					for (int32 B = A + 1; B < Representatives.Num(); ++B)
+					{
+						if (FMath::CountBits(HashA ^ Hashes[Representatives[B]].Perceptual) <= uint64(MaxHammingDistance))
+						{
+							Matches[A].Add(B);
+						}
+					}
+				});
+
+			for (int32 A = 0; A < Matches.Num(); ++A)
+			{
+				for (int32 B : Matches[A])
+				{
+					const int32 RootA = FindRoot(Parents, Representatives[A]);
+					const int32 RootB = FindRoot(Parents, Representatives[B]);
+					if (RootA != RootB)
+					{
+						Parents[RootB] = RootA;
+					}
+				}
+			}
+		}
+
+		// 3) Collect, pick keepers, size the waste
+		TMap<int32, TArray<int32>> Members;
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Members.FindOrAdd(FindRoot(Parents, Index)).Add(Index);
+		}
+
+		TArray<FTextureDuplicateCluster> Clusters;
+		for (TPair<int32, TArray<int32>>& Pair : Members)
+		{
+			if (Pair.Value.Num() < 2)
+			{
+				continue;
+			}
+
+			TArray<TPair<int64, int32>> Sized;
+			for (int32 Index : Pair.Value)
+			{
+				Sized.Emplace(TextureMemoryEstimator::EstimateAsset(Hashed[Index]).GetTotalBytes(), Index);
+			}
+
+			Sized.Sort([&Hashed](const TPair<int64, int32>& A, const TPair<int64, int32>& B)
+				{
+					if (A.Key != B.Key)
+					{
+						return A.Key > B.Key;
+					}
+					return Hashed[A.Value].PackageName.ToString().Len() < Hashed[B.Value].PackageName.ToString().Len();
+				});
+
+			FTextureDuplicateCluster& Cluster = Clusters.AddDefaulted_GetRef();
+			Cluster.bExact = true;
+			for (int32 Rank = 0; Rank < Sized.Num(); ++Rank)
+			{
+				const int32 Index = Sized[Rank].Value;
+				Cluster.Assets.Add(Hashed[Index]);
+				Cluster.bExact &= (Hashes[Index].Exact == Hashes[Sized[0].Value].Exact);
+				if (Rank > 0)
+				{
+					Cluster.WastedBytes += Sized[Rank].Key;
+				}
+			}
+			Cluster.bSameBuildSettings = HaveSameBuildSettings(Cluster.Assets);
+		}
+
+		Clusters.Sort([](const FTextureDuplicateCluster& A, const FTextureDuplicateCluster& B)
+			{
+				return A.WastedBytes > B.WastedBytes;
+			});
+
+		return Clusters;
+	}
+
+	bool ConsolidateCluster(const FTextureDuplicateCluster& Cluster)
+	{
+		return ConsolidateClusters({ Cluster }) == 0;
+	}
+
+	int32 ConsolidateClusters(const TArray<FTextureDuplicateCluster>& Clusters)
+	{
+#if WITH_EDITOR
+		TArray<UPackage*> PackagesToSave;
+		int32 NumFailed = 0;
+		for (const FTextureDuplicateCluster& Cluster : Clusters)
+		{
+			NumFailed += ConsolidateOne(Cluster, PackagesToSave) ? 0 : 1;
+		}
+
+		// The presets that listed the copies, all in one go
+		if (PackagesToSave.Num() > 0)
+		{
+			FEditorFileUtils::PromptForCheckoutAndSave(PackagesToSave, /*bCheckDirty=*/false, /*bPromptToSave=*/false);
+			TextureManagerMetrics::AddPackagesSaved(PackagesToSave.Num());
+		}
+		return NumFailed;
+#else
+		return Clusters.Num();
+#endif
+	}
+}
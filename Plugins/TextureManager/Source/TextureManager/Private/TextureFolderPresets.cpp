@@ -0,0 +1,433 @@
+#include "TextureFolderPresets.h"
+
+#include "TextureBulkJournal.h"
+#include "TextureManagerMetrics.h"
+#include "TextureManagerSettings.h"
+#include "TextureManagerStats.h"
+#include "TexturePresetAsset.h"
+#include "TexturePresetLibrary.h"
+#include "TexturePresetUserData.h"
+#include "TextureRebuildScheduler.h"
+
+#include "Engine/Texture2D.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopedSlowTask.h"
+
+#define LOCTEXT_NAMESPACE "TextureFolderPresets"
+
+namespace
+{
+	// "/Game/Props/" -> "/Game/Props"
+	FString NormalizeFolder(FString Folder)
+	{
+		Folder.TrimStartAndEndInline();
+		while (Folder.Len() > 1 && Folder.EndsWith(TEXT("/")))
+		{
+			Folder.LeftChopInline(1);
+		}
+		return Folder;
+	}
+
+	// One node per path segment, the root being the empty path
+	class FFolderPresetTrie
+	{
+	public:
+		struct FNode
+		{
+			TMap<FName, int32> Children;
+
+			// Only set on nodes that have a preset
+			FString Folder;
+			FSoftObjectPath Preset;
+		};
+
+		FFolderPresetTrie()
+		{
+			Nodes.AddDefaulted();
+		}
+
+		void Add(const FString& Folder, const FSoftObjectPath& Preset)
+		{
+			int32 Index = 0;
+			ForEachSegment(Folder, [this, &Index](FStringView Segment)
+				{
+					const FName Name(Segment.Len(), Segment.GetData());
+					if (const int32* Child = Nodes[Index].Children.Find(Name))
+					{
+						Index = *Child;
+					}
+					else
+					{
+						const int32 NewIndex = Nodes.AddDefaulted();
+						Nodes[Index].Children.Add(Name, NewIndex);
+						Index = NewIndex;
+					}
+					return true;
+				});
+
+			Nodes[Index].Folder = Folder;
+			Nodes[Index].Preset = Preset;
+		}
+
+		// Deepest node with a preset on the way to Folder, INDEX_NONE if none
+		int32 FindDeepest(FStringView Folder) const
+		{
+			int32 Index = 0;
+			int32 Deepest = Nodes[0].Preset.IsNull() ? INDEX_NONE : 0;
+			ForEachSegment(Folder, [this, &Index, &Deepest](FStringView Segment)
+				{
+					// A segment no folder preset uses has no FName yet either
+					const FName Name(Segment.Len(), Segment.GetData(), FNAME_Find);
+					const int32* Child = Name.IsNone() ? nullptr : Nodes[Index].Children.Find(Name);
+					if (!Child)
+					{
+						return false;
+					}
+
+					Index = *Child;
+					if (!Nodes[Index].Preset.IsNull())
+					{
+						Deepest = Index;
+					}
+					return true;
+				});
+			return Deepest;
+		}
+
+		const FNode& GetNode(int32 Index) const
+		{
+			return Nodes[Index];
+		}
+
+	private:
+		// Calls Visit for every non-empty segment until it returns false
+		template <typename VisitorType>
+		static void ForEachSegment(FStringView Path, VisitorType&& Visit)
+		{
+			while (!Path.IsEmpty())
+			{
+				int32 Slash = INDEX_NONE;
+				Path.FindChar(TEXT('/'), Slash);
+
+				const FStringView Segment = Slash == INDEX_NONE ? Path : Path.Left(Slash);
+				Path.RightChopInline(Slash == INDEX_NONE ? Path.Len() : Slash + 1);
+
+				if (!Segment.IsEmpty() && !Visit(Segment))
+				{
+					return;
+				}
+			}
+		}
+
+		TArray<FNode> Nodes;
+	};
+
+	struct FFolderPresetState
+	{
+		bool bValid = false;
+		FFolderPresetTrie Trie;
+
+		// Package path -> node of its owning folder (INDEX_NONE = none)
+		TMap<FName, int32> OwningNodes;
+	};
+
+	FFolderPresetState GFolderPresetState;
+
+	// Imports arrive one texture at a time; those until the rebuild queue
+	// drains share one journal batch
+	FGuid GImportBatch;
+	FDelegateHandle GImportDrainedHandle;
+
+	const FGuid& GetImportBatch()
+	{
+		if (!GImportDrainedHandle.IsValid())
+		{
+			GImportDrainedHandle = TextureRebuildScheduler::OnDrained().AddLambda([]()
+				{
+					GImportBatch.Invalidate();
+				});
+		}
+		if (!GImportBatch.IsValid())
+		{
+			GImportBatch = TextureBulkJournal::BeginBatch(TEXT("Folder presets on import"));
+		}
+		return GImportBatch;
+	}
+
+	FFolderPresetState& GetState()
+	{
+		check(IsInGameThread());
+
+		FFolderPresetState& State = GFolderPresetState;
+		if (!State.bValid)
+		{
+			State.Trie = FFolderPresetTrie();
+			State.OwningNodes.Reset();
+			for (const FTextureFolderPreset& Entry : GetDefault<UTextureManagerSettings>()->FolderPresets)
+			{
+				const FString Folder = NormalizeFolder(Entry.Folder.Path);
+				if (!Folder.IsEmpty() && !Entry.Preset.IsNull())
+				{
+					State.Trie.Add(Folder, Entry.Preset.ToSoftObjectPath());
+				}
+			}
+			State.bValid = true;
+		}
+		return State;
+	}
+
+	int32 FindOwningNode(FName PackagePath)
+	{
+		FFolderPresetState& State = GetState();
+		if (const int32* Cached = State.OwningNodes.Find(PackagePath))
+		{
+			return *Cached;
+		}
+
+		TStringBuilder<256> Path;
+		Path << PackagePath;
+		const int32 Node = State.Trie.FindDeepest(Path.ToView());
+		State.OwningNodes.Add(PackagePath, Node);
+		return Node;
+	}
+
+	UTexturePresetUserData* GetUserData(const UTexture2D* Texture)
+	{
+		return Cast<UTexturePresetUserData>(
+			const_cast<UTexture2D*>(Texture)->GetAssetUserDataOfClass(UTexturePresetUserData::StaticClass()));
+	}
+
+	// Assigned by hand (or any way other than a folder)
+	bool HasOwnPreset(const UTexture2D* Texture)
+	{
+		const UTexturePresetUserData* UserData = GetUserData(Texture);
+		return UserData && UserData->AssignedPreset && !UserData->bFromFolder;
+	}
+
+	FName GetPackagePath(const UTexture2D* Texture)
+	{
+		return FName(FPackageName::GetLongPackagePath(Texture->GetOutermost()->GetName()));
+	}
+
+	void AssignFromFolder(UTexturePresetAsset* Preset, UTexture2D* Texture)
+	{
+		TexturePresetLibrary::AssignPresetToTexture(Preset, Texture);
+		if (UTexturePresetUserData* UserData = GetUserData(Texture))
+		{
+			UserData->bFromFolder = true;
+		}
+	}
+}
+
+namespace TextureFolderPresets
+{
+	FString FindOwningFolder(FName PackagePath)
+	{
+		const int32 Node = FindOwningNode(PackagePath);
+		return Node == INDEX_NONE ? FString() : GetState().Trie.GetNode(Node).Folder;
+	}
+
+	UTexturePresetAsset* FindFolderPreset(FName PackagePath)
+	{
+		const int32 Node = FindOwningNode(PackagePath);
+		return Node == INDEX_NONE
+			? nullptr
+			: Cast<UTexturePresetAsset>(GetState().Trie.GetNode(Node).Preset.TryLoad());
+	}
+
+	UTexturePresetAsset* GetEffectivePreset(const UTexture2D* Texture)
+	{
+		if (!Texture)
+		{
+			return nullptr;
+		}
+
+		// A folder link follows the folder, even if the folder changed since
+		if (HasOwnPreset(Texture))
+		{
+			return GetUserData(Texture)->AssignedPreset;
+		}
+		return FindFolderPreset(GetPackagePath(Texture));
+	}
+
+	TArray<FAssetData> GetFolderMembers(const FString& Folder)
+	{
+		TEXTURE_MANAGER_SCOPE("GetFolderMembers");
+		const FString Normalized = NormalizeFolder(Folder);
+
+		FARFilter Filter;
+		Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
+		Filter.bRecursiveClasses = true;
+		Filter.PackagePaths.Add(FName(*Normalized));
+		Filter.bRecursivePaths = true;
+
+		TArray<FAssetData> Assets;
+		{
+			FTextureManagerPhaseScope Phase(ETextureManagerPhase::RegistryQuery);
+			IAssetRegistry::GetChecked().GetAssets(Filter, Assets);
+		}
+
+		// Whatever a deeper folder preset owns is not a member
+		Assets.RemoveAll([&Normalized](const FAssetData& Asset)
+			{
+				const int32 Node = FindOwningNode(Asset.PackagePath);
+				return Node != INDEX_NONE && GetState().Trie.GetNode(Node).Folder.Len() > Normalized.Len();
+			});
+		return Assets;
+	}
+
+	bool ApplyFolderPreset(UTexture2D* Texture)
+	{
+		TEXTURE_MANAGER_SCOPE("ApplyFolderPreset");
+		if (!Texture || HasOwnPreset(Texture))
+		{
+			return false;
+		}
+
+		UTexturePresetAsset* Preset = FindFolderPreset(GetPackagePath(Texture));
+		if (!Preset)
+		{
+			return false;
+		}
+
+		Texture->Modify();
+		AssignFromFolder(Preset, Texture);
+
+		// A cook-time preset leaves the imported asset as it is
+		if (!Preset->bApplyAtCook)
+		{
+			TextureRebuildScheduler::Enqueue(Preset, Texture, GetImportBatch());
+		}
+		return true;
+	}
+
+	int32 ReapplyFolders(const TArray<FString>& Folders)
+	{
+		TEXTURE_MANAGER_SCOPE("ReapplyFolders");
+		FTextureManagerOperationScope Operation(TEXT("ReapplyFolders"));
+		// Nested folders list the same textures
+		TArray<FAssetData> Assets;
+		TSet<FName> Seen;
+		for (const FString& Folder : Folders)
+		{
+			for (FAssetData& Asset : GetFolderMembers(Folder))
+			{
+				bool bAlreadySeen = false;
+				Seen.Add(Asset.PackageName, &bAlreadySeen);
+				if (!bAlreadySeen)
+				{
+					Assets.Add(MoveTemp(Asset));
+				}
+			}
+		}
+
+		FScopedSlowTask SlowTask(float(Assets.Num()), LOCTEXT("ApplyingFolderPresets", "Applying folder presets..."));
+		SlowTask.MakeDialogDelayed(0.5f, true);
+
+		const FGuid JournalBatch = TextureBulkJournal::BeginBatch(TEXT("Reapply folder presets"));
+		int32 NumQueued = 0;
+		for (const FAssetData& Asset : Assets)
+		{
+			if (SlowTask.ShouldCancel())
+			{
+				break;
+			}
+			SlowTask.EnterProgressFrame(1);
+
+			UTexture2D* Texture = Cast<UTexture2D>(TextureManagerMetrics::LoadAsset(Asset));
+			if (!Texture || HasOwnPreset(Texture))
+			{
+				continue;
+			}
+
+			UTexturePresetUserData* UserData = GetUserData(Texture);
+			UTexturePresetAsset* Preset = FindFolderPreset(Asset.PackagePath);
+			if (!Preset)
+			{
+				// The folder lost its preset; keep the settings, drop the link
+				if (UserData && UserData->AssignedPreset)
+				{
+					UserData->AssignedPreset->Modify();
+					UserData->AssignedPreset->Files.Remove(Texture);
+					UserData->AssignedPreset->MarkPackageDirty();
+
+					Texture->Modify();
+					Texture->RemoveUserDataOfClass(UTexturePresetUserData::StaticClass());
+				}
+				continue;
+			}
+
+			// Leave untouched textures clean
+			const bool bRelink = !UserData || UserData->AssignedPreset != Preset;
+			const bool bRebuild = !Preset->bApplyAtCook && !TexturePresetLibrary::DiffTexture(Preset, Texture).IsEmpty();
+			if (!bRelink && !bRebuild)
+			{
+				continue;
+			}
+
+			if (bRelink)
+			{
+				Texture->Modify();
+				AssignFromFolder(Preset, Texture);
+			}
+			if (bRebuild)
+			{
+				TextureRebuildScheduler::Enqueue(Preset, Texture, JournalBatch);
+				++NumQueued;
+			}
+		}
+
+		// Nobody ticks the scheduler in a commandlet
+		if (IsRunningCommandlet())
+		{
+			TextureRebuildScheduler::Flush();
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("Folder presets: %d textures checked, %d queued for rebuild"), Assets.Num(), NumQueued);
+		return NumQueued;
+	}
+
+	void SetFolderPreset(const FString& Folder, UTexturePresetAsset* Preset)
+	{
+		const FString Normalized = NormalizeFolder(Folder);
+		if (Normalized.IsEmpty())
+		{
+			return;
+		}
+
+		UTextureManagerSettings* Settings = GetMutableDefault<UTextureManagerSettings>();
+		const int32 Index = Settings->FolderPresets.IndexOfByPredicate([&Normalized](const FTextureFolderPreset& Entry)
+			{
+				return NormalizeFolder(Entry.Folder.Path) == Normalized;
+			});
+
+		if (Preset)
+		{
+			FTextureFolderPreset& Entry = Index == INDEX_NONE
+				? Settings->FolderPresets.AddDefaulted_GetRef()
+				: Settings->FolderPresets[Index];
+			Entry.Folder.Path = Normalized;
+			Entry.Preset = Preset;
+		}
+		else if (Index != INDEX_NONE)
+		{
+			Settings->FolderPresets.RemoveAt(Index);
+		}
+		else
+		{
+			return;
+		}
+
+		Settings->TryUpdateDefaultConfigFile();
+		Invalidate();
+		ReapplyFolders({ Normalized });
+	}
+
+	void Invalidate()
+	{
+		GFolderPresetState.bValid = false;
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
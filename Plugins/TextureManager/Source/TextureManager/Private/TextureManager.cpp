@@ -7,11 +7,23 @@
 #include "Widgets/Docking/SDockTab.h"
 #include "TexturePresetLibrary.h"
 #include "TexturePresetAsset.h"
+#include "TextureFolderPresets.h"
+#include "TexturePresetCook.h"
+#include "TextureScalabilityExport.h"
+#include "TextureBulkJournal.h"
+#include "TextureManagerStats.h"
+#include "STextureManagerMetrics.h"
+#include "ContentBrowserMenuContexts.h"
+#include "AssetRegistry/IAssetRegistry.h"
 
 #define LOCTEXT_NAMESPACE "FTextureManagerModule"
 
 void FTextureManagerModule::StartupModule()
 {
+    // Before the GEditor check: the cook commandlet needs nothing else
+    TexturePresetCook::Register();
+    TextureScalabilityExport::Register();
+
     // Load the Importing
     {
         UE_LOG(LogTemp, Warning, TEXT("Testing module loaded"));
@@ -45,11 +57,17 @@ void FTextureManagerModule::StartupModule()
        .SetMenuType(ETabSpawnerMenuType::Hidden)
        .SetDisplayName(FText::FromString("Texture Preset Manager"));
 
+    FGlobalTabmanager::Get()->RegisterNomadTabSpawner(STextureManagerMetrics::TabId,
+        FOnSpawnTab::CreateStatic(&STextureManagerMetrics::SpawnTab))
+       .SetMenuType(ETabSpawnerMenuType::Hidden)
+       .SetDisplayName(FText::FromString("Texture Manager Metrics"));
+
     UToolMenus::RegisterStartupCallback(FSimpleMulticastDelegate::FDelegate::CreateRaw(this, &FTextureManagerModule::RegisterMenus));
 }
 
 void FTextureManagerModule::OnAssetImported(UFactory* Factory, UObject* Imported)
 {
+    TEXTURE_MANAGER_SCOPE("OnAssetImported");
     UE_LOG(LogTemp, Warning, TEXT("IMPORT FIRED for %s"),
         Imported ? *Imported->GetName() : TEXT("<null>"));
 
@@ -59,6 +77,13 @@ void FTextureManagerModule::OnAssetImported(UFactory* Factory, UObject* Imported
         return;
     }
 
+    // Textures imported into a folder with a preset get it right away
+    if (UTexture2D* ImportedTexture = Cast<UTexture2D>(Imported))
+    {
+        TRACE_COUNTER_INCREMENT(TextureManager_TexturesImported);
+        TextureFolderPresets::ApplyFolderPreset(ImportedTexture);
+    }
+
     // Check if the imported asset is a texture (or any other asset type)
     if (Imported->IsA<UTexture>())
     {
@@ -147,6 +172,107 @@ void FTextureManagerModule::RegisterMenus()
                 FGlobalTabmanager::Get()->TryInvokeTab(FName("TextureManager"));
             }))
     );
+
+    Section.AddMenuEntry(
+        "TextureManagerMetrics",
+        FText::FromString("Texture Manager Metrics"),
+        FText::FromString("Latency percentiles of preset operations and their phases"),
+        FSlateIcon(),
+        FUIAction(FExecuteAction::CreateLambda([]()
+            {
+                FGlobalTabmanager::Get()->TryInvokeTab(STextureManagerMetrics::TabId);
+            }))
+    );
+
+    Section.AddSubMenu(
+        "RollBackTextureBatch",
+        FText::FromString("Roll Back Texture Batch"),
+        FText::FromString("Restore the textures a bulk preset apply changed, also after a restart"),
+        FNewToolMenuDelegate::CreateLambda([](UToolMenu* SubMenu)
+            {
+                FToolMenuSection& BatchSection = SubMenu->AddSection("Batches");
+                for (const FTextureJournalBatch& Batch : TextureBulkJournal::ListBatches())
+                {
+                    const FGuid BatchId = Batch.Id;
+                    BatchSection.AddMenuEntry(
+                        FName(*BatchId.ToString()),
+                        FText::FromString(FString::Printf(TEXT("%s  (%d textures, %s)"),
+                            *Batch.Label, Batch.NumTextures, *Batch.Time.ToString(TEXT("%Y-%m-%d %H:%M")))),
+                        FText::GetEmpty(),
+                        FSlateIcon(),
+                        FUIAction(FExecuteAction::CreateLambda([BatchId]()
+                            {
+                                TextureBulkJournal::Rollback(BatchId);
+                            })));
+                }
+            })
+    );
+
+    Section.AddMenuEntry(
+        "RebuildTextureScalabilityTable",
+        FText::FromString("Rebuild Texture Scalability Table"),
+        FText::FromString("Write the scalability tiers of all presets to the table the game loads"),
+        FSlateIcon(),
+        FUIAction(FExecuteAction::CreateLambda([]()
+            {
+                TextureScalabilityExport::BuildTable();
+            }))
+    );
+
+    // Content Browser folder menu: preset for everything in the folder
+    UToolMenu* FolderMenu = UToolMenus::Get()->ExtendMenu("ContentBrowser.FolderContextMenu");
+    FToolMenuSection& FolderSection = FolderMenu->AddSection("TextureTools", FText::FromString("Texture Tools"));
+    FolderSection.AddDynamicEntry("FolderTexturePreset", FNewToolMenuSectionDelegate::CreateLambda([](FToolMenuSection& InSection)
+        {
+            const UContentBrowserFolderContext* Context = InSection.FindContext<UContentBrowserFolderContext>();
+            if (!Context || Context->SelectedPackagePaths.IsEmpty())
+            {
+                return;
+            }
+
+            const TArray<FString> Folders = Context->SelectedPackagePaths;
+            InSection.AddSubMenu(
+                "FolderTexturePreset",
+                FText::FromString("Texture Preset"),
+                FText::FromString("Preset for every texture in the folder that has none of its own"),
+                FNewToolMenuDelegate::CreateLambda([Folders](UToolMenu* SubMenu)
+                    {
+                        FToolMenuSection& Section = SubMenu->AddSection("Presets");
+
+                        Section.AddMenuEntry(
+                            "None",
+                            FText::FromString("None (use parent folder)"),
+                            FText::FromString("Remove the folder's own preset"),
+                            FSlateIcon(),
+                            FUIAction(FExecuteAction::CreateLambda([Folders]()
+                                {
+                                    for (const FString& Folder : Folders)
+                                    {
+                                        TextureFolderPresets::SetFolderPreset(Folder, nullptr);
+                                    }
+                                })));
+
+                        TArray<FAssetData> PresetAssets;
+                        IAssetRegistry::GetChecked().GetAssetsByClass(UTexturePresetAsset::StaticClass()->GetClassPathName(), PresetAssets, true);
+                        for (const FAssetData& Asset : PresetAssets)
+                        {
+                            const FSoftObjectPath PresetPath = Asset.GetSoftObjectPath();
+                            Section.AddMenuEntry(
+                                Asset.AssetName,
+                                FText::FromName(Asset.AssetName),
+                                FText::FromString(PresetPath.ToString()),
+                                FSlateIcon(),
+                                FUIAction(FExecuteAction::CreateLambda([Folders, PresetPath]()
+                                    {
+                                        UTexturePresetAsset* Preset = Cast<UTexturePresetAsset>(PresetPath.TryLoad());
+                                        for (const FString& Folder : Folders)
+                                        {
+                                            TextureFolderPresets::SetFolderPreset(Folder, Preset);
+                                        }
+                                    })));
+                        }
+                    }));
+        }));
 }
 
 void FTextureManagerModule::ShutdownModule()
@@ -154,7 +280,10 @@ void FTextureManagerModule::ShutdownModule()
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
     FGlobalTabmanager::Get()->UnregisterNomadTabSpawner("TextureManager");
+    FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(STextureManagerMetrics::TabId);
     FEditorDelegates::OnAssetsPreDelete.RemoveAll(this);
+    TexturePresetCook::Unregister();
+    TextureScalabilityExport::Unregister();
 }
 
 void FTextureManagerModule::OnAssetsPreDelete(const TArray<UObject*>& Assets)
@@ -0,0 +1,740 @@
+#include "TextureManagerBenchmark.h"
+
+#include "TextureManagerLists.h"
+#include "TextureManagerMetrics.h"
+#include "TexturePresetAsset.h"
+#include "TexturePresetClustering.h"
+#include "TexturePresetCook.h"
+#include "TexturePresetLibrary.h"
+#include "TexturePresetUserData.h"
+#include "TexturePreviewPool.h"
+#include "TextureBulkJournal.h"
+#include "TextureRebuildCostModel.h"
+#include "TextureRebuildScheduler.h"
+
+#include "AssetCompilingManager.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Texture2D.h"
+#include "HAL/FileManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/SavePackage.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	const TCHAR* BenchmarkRoot = TEXT("/Game/__TextureManagerBenchmark");
+
+	constexpr int32 TexturesPerFolder = 200;
+
+	// Textures a preset is applied to at once, as a multi-selection in the window would
+	constexpr int32 NumSelected = 100;
+
+	struct FSyntheticProject
+	{
+		FString Root;
+		TArray<UTexture2D*> Textures;
+		TArray<UTexturePresetAsset*> Presets;
+	};
+
+	// What the window keeps between calls
+	struct FWindowState
+	{
+		TArray<FAssetData> AllTextureAssets;
+		TArray<TWeakObjectPtr<UTexture2D>> AllTextureItems;
+		TArray<TWeakObjectPtr<UTexture2D>> FilteredTextureItems;
+		TArray<TWeakObjectPtr<UTexturePresetAsset>> AllPresetItems;
+		TArray<TWeakObjectPtr<UTexturePresetAsset>> FilteredPresetItems;
+		TArray<TSharedPtr<FString>> PresetLabels;
+		TArray<UTexturePresetAsset*> PresetChoices;
+	};
+
+	FString GetSaveDir()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("TextureManager") / TEXT("Benchmark");
+	}
+
+	// Keeps the synthetic applies out of the user's journal (Roll Back menu,
+	// pruning) and their tiny builds out of the rebuild cost model
+	struct FBenchmarkHistoryScope
+	{
+		FBenchmarkHistoryScope()
+		{
+			TextureBulkJournal::SetDirectory(GetSaveDir() / TEXT("Journal"));
+			TextureRebuildCostModel::SetRecording(false);
+		}
+
+		~FBenchmarkHistoryScope()
+		{
+			TextureBulkJournal::SetDirectory(FString());
+			TextureRebuildCostModel::SetRecording(true);
+		}
+	};
+
+	template <typename ObjectType>
+	ObjectType* CreateAsset(const FString& PackageName)
+	{
+		UPackage* Package = CreatePackage(*PackageName);
+		ObjectType* Object = NewObject<ObjectType>(
+			Package,
+			FName(*FPackageName::GetShortName(PackageName)),
+			RF_Public | RF_Standalone | RF_Transactional);
+		FAssetRegistryModule::AssetCreated(Object);
+		return Object;
+	}
+
+	FSyntheticProject Generate(const FTextureManagerBenchmarkScenario& Scenario, int32 Seed)
+	{
+		static const TextureCompressionSettings Compressions[] = { TC_Default, TC_Normalmap, TC_Masks, TC_Grayscale, TC_BC7 };
+		static const TextureGroup Groups[] = { TEXTUREGROUP_World, TEXTUREGROUP_WorldNormalMap, TEXTUREGROUP_Character, TEXTUREGROUP_UI, TEXTUREGROUP_Effects };
+		static const int32 MaxSizes[] = { 0, 512, 1024, 2048 };
+
+		FSyntheticProject Project;
+		Project.Root = FString(BenchmarkRoot) / Scenario.GetName();
+		FRandomStream Random(Seed);
+
+		for (int32 Index = 0; Index < Scenario.NumPresets; ++Index)
+		{
+			UTexturePresetAsset* Preset = CreateAsset<UTexturePresetAsset>(
+				FString::Printf(TEXT("%s/Presets/TP_Bench_%04d"), *Project.Root, Index));
+			Preset->PresetName = Preset->GetFName();
+			Preset->Settings.CompressionSettings = Compressions[Random.RandHelper(UE_ARRAY_COUNT(Compressions))];
+			Preset->Settings.TextureGroup = Groups[Random.RandHelper(UE_ARRAY_COUNT(Groups))];
+			Preset->Settings.MaxTextureSize = MaxSizes[Random.RandHelper(UE_ARRAY_COUNT(MaxSizes))];
+			Preset->Settings.LODBias = Random.RandRange(0, 2);
+			Preset->Settings.bSRGB = Preset->Settings.CompressionSettings == TC_Default || Preset->Settings.CompressionSettings == TC_BC7;
+			Preset->NotifySettingsChanged();
+			Project.Presets.Add(Preset);
+		}
+
+		Project.Textures.Reserve(Scenario.NumTextures);
+		for (int32 Index = 0; Index < Scenario.NumTextures; ++Index)
+		{
+			UTexture2D* Texture = CreateAsset<UTexture2D>(
+				FString::Printf(TEXT("%s/Textures/Folder_%03d/T_Bench_%06d"), *Project.Root, Index / TexturesPerFolder, Index));
+			Texture->Source.Init(4, 4, 1, 1, TSF_BGRA8);
+			Project.Textures.Add(Texture);
+
+			// A tenth without a preset; the rest skewed towards the first presets
+			if (Project.Presets.IsEmpty() || Random.FRand() < 0.1f)
+			{
+				continue;
+			}
+			const int32 PresetIndex = FMath::Min(int32(FMath::Square(Random.FRand()) * Project.Presets.Num()), Project.Presets.Num() - 1);
+			UTexturePresetAsset* Preset = Project.Presets[PresetIndex];
+
+			// AssignPresetToTexture searches Files; not needed for a fresh project
+			UTexturePresetUserData* UserData = NewObject<UTexturePresetUserData>(Texture);
+			UserData->AssignedPreset = Preset;
+			Texture->AddAssetUserData(UserData);
+			Preset->Files.Add(Texture);
+		}
+
+		// Generated, not edited
+		for (UTexturePresetAsset* Preset : Project.Presets)
+		{
+			Preset->GetOutermost()->SetDirtyFlag(false);
+		}
+		for (UTexture2D* Texture : Project.Textures)
+		{
+			Texture->GetOutermost()->SetDirtyFlag(false);
+		}
+		return Project;
+	}
+
+	void Destroy(FSyntheticProject& Project)
+	{
+		FAssetCompilingManager::Get().FinishAllCompilation();
+
+		auto Remove = [](UObject* Object)
+			{
+				FAssetRegistryModule::AssetDeleted(Object);
+				Object->ClearFlags(RF_Public | RF_Standalone);
+				Object->MarkAsGarbage();
+			};
+		for (UTexture2D* Texture : Project.Textures)
+		{
+			Remove(Texture);
+		}
+		for (UTexturePresetAsset* Preset : Project.Presets)
+		{
+			Remove(Preset);
+		}
+		Project = FSyntheticProject();
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		IFileManager::Get().DeleteDirectory(*GetSaveDir(), false, true);
+	}
+
+	// ---------- What the window does, without the views ----------
+	// The list work is TextureManagerLists, shared with SMyTwoColumnWidget;
+	// only the widget state around it is kept here.
+
+	// SMyTwoColumnWidget::RefreshTextureList
+	void RefreshTextureList(FWindowState& State, const FString& Root)
+	{
+		State.AllTextureAssets = TextureManagerLists::QueryAssets(UTexture2D::StaticClass(), { FName(*Root) });
+		State.AllTextureItems = TextureManagerLists::LoadTextures(State.AllTextureAssets);
+		State.FilteredTextureItems = State.AllTextureItems;
+	}
+
+	// SMyTwoColumnWidget::RefreshPresetList
+	void RefreshPresetList(FWindowState& State, const FString& Root)
+	{
+		State.AllPresetItems = TextureManagerLists::LoadPresets(
+			TextureManagerLists::QueryAssets(UTexturePresetAsset::StaticClass(), { FName(*Root) }));
+		State.FilteredPresetItems = State.AllPresetItems;
+		State.PresetLabels.Reset();
+		State.PresetChoices.Reset();
+		for (const TWeakObjectPtr<UTexturePresetAsset>& Item : State.AllPresetItems)
+		{
+			State.PresetLabels.Add(MakeShared<FString>(TextureManagerLists::GetPresetLabel(Item.Get())));
+			State.PresetChoices.Add(Item.Get());
+		}
+	}
+
+	// SMyTwoColumnWidget::OnFilterComboChange with a preset picked
+	void FilterByPreset(FWindowState& State, const FString& Root, const FString& Label)
+	{
+		State.FilteredTextureItems.Reset();
+		if (const UTexturePresetAsset* FoundPreset = TexturePresetLibrary::FindPresetByName(Label, Root))
+		{
+			State.FilteredTextureItems = TextureManagerLists::FilterByPreset(State.AllTextureItems, FoundPreset);
+		}
+	}
+
+	// SMyTwoColumnWidget::OnFilesSearchChanged
+	void SearchFiles(FWindowState& State, const FString& Query)
+	{
+		State.FilteredTextureItems = TextureManagerLists::SearchTextures(State.AllTextureItems, Query);
+	}
+
+	// SMyTwoColumnWidget::OnPresetsSearchChanged
+	void SearchPresets(FWindowState& State, const FString& Query)
+	{
+		State.FilteredPresetItems = TextureManagerLists::SearchPresets(State.AllPresetItems, Query);
+	}
+
+	// SMyTwoColumnWidget::SaveFiles: link a preset to the selection and
+	// queue the rebuilds, then wait for them as the save after them would
+	void ApplyToSelection(const TArray<UTexture2D*>& Selection, UTexturePresetAsset* Preset)
+	{
+		const FGuid JournalBatch = TextureBulkJournal::BeginBatch(TEXT("Benchmark"));
+		for (UTexture2D* Texture : Selection)
+		{
+			Texture->Modify();
+			TexturePresetLibrary::AssignPresetToTexture(Preset, Texture);
+			TextureRebuildScheduler::Enqueue(Preset, Texture, JournalBatch);
+		}
+		TextureRebuildScheduler::Flush();
+	}
+
+	// SMyTwoColumnWidget::SaveDirtyTexturesAndPresets, saving under Saved/
+	// instead of over the (non-existent) package files
+	void SaveDirty(const FWindowState& State)
+	{
+		const TArray<UPackage*> PackagesToSave = TextureManagerLists::GatherDirtyPackages(State.AllTextureAssets, State.AllPresetItems);
+
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.SaveFlags = SAVE_NoError;
+
+		FTextureManagerPhaseScope Phase(ETextureManagerPhase::Save);
+		for (UPackage* Package : PackagesToSave)
+		{
+			const FString Filename = FPaths::ConvertRelativePathToFull(
+				GetSaveDir() / Package->GetName() + FPackageName::GetAssetPackageExtension());
+			UPackage::SavePackage(Package, nullptr, *Filename, SaveArgs);
+			Package->SetDirtyFlag(false);
+		}
+		TextureManagerMetrics::AddPackagesSaved(PackagesToSave.Num());
+	}
+
+	// ---------- Timing ----------
+
+	template <typename BodyType, typename AfterType>
+	FTextureManagerBenchmarkResult Measure(const FString& Scenario, const TCHAR* Name, int32 NumIterations, BodyType&& Body, AfterType&& After)
+	{
+		TArray<double> Samples;
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			const double StartSeconds = FPlatformTime::Seconds();
+			Body(Iteration);
+			Samples.Add((FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+
+			// Untimed: leave the next iteration a clean start
+			After(Iteration);
+		}
+		Samples.Sort();
+
+		FTextureManagerBenchmarkResult Result;
+		Result.Scenario = Scenario;
+		Result.Name = Name;
+		Result.NumIterations = Samples.Num();
+		if (!Samples.IsEmpty())
+		{
+			const int32 Middle = Samples.Num() / 2;
+			Result.MinMs = Samples[0];
+			Result.MaxMs = Samples.Last();
+			Result.MedianMs = Samples.Num() % 2 ? Samples[Middle] : 0.5 * (Samples[Middle - 1] + Samples[Middle]);
+			for (double Sample : Samples)
+			{
+				Result.MeanMs += Sample / Samples.Num();
+			}
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("Benchmark %-16s %-28s median %10.2f ms, min %10.2f, max %10.2f"),
+			*Scenario, Name, Result.MedianMs, Result.MinMs, Result.MaxMs);
+		return Result;
+	}
+
+	template <typename BodyType>
+	FTextureManagerBenchmarkResult Measure(const FString& Scenario, const TCHAR* Name, int32 NumIterations, BodyType&& Body)
+	{
+		return Measure(Scenario, Name, NumIterations, Forward<BodyType>(Body), [](int32) {});
+	}
+
+	// ---------- Microbenchmarks ----------
+
+	UTexturePresetAsset* NewTransientPreset(TextureCompressionSettings Compression, int32 LODBias)
+	{
+		UTexturePresetAsset* Preset = NewObject<UTexturePresetAsset>(GetTransientPackage(), NAME_None, RF_Transient);
+		Preset->Settings.CompressionSettings = Compression;
+		Preset->Settings.LODBias = LODBias;
+		Preset->NotifySettingsChanged();
+		return Preset;
+	}
+
+	// Textures linked to Preset, so its Files holds all of them
+	TArray<UTexture2D*> NewTransientTextures(int32 Num, UTexturePresetAsset* Preset)
+	{
+		TArray<UTexture2D*> Textures;
+		Textures.Reserve(Num);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			UTexture2D* Texture = NewObject<UTexture2D>(GetTransientPackage(), NAME_None, RF_Transient);
+			UTexturePresetUserData* UserData = NewObject<UTexturePresetUserData>(Texture);
+			UserData->AssignedPreset = Preset;
+			Texture->AddAssetUserData(UserData);
+			Preset->Files.Add(Texture);
+			Textures.Add(Texture);
+		}
+		return Textures;
+	}
+}
+
+namespace TextureManagerBenchmark
+{
+	TArray<FTextureManagerBenchmarkResult> RunScenario(const FTextureManagerBenchmarkScenario& Scenario, int32 NumIterations, int32 Seed)
+	{
+		check(IsInGameThread());
+		FBenchmarkHistoryScope HistoryScope;
+
+		const FString Name = Scenario.GetName();
+		const double GenerateStart = FPlatformTime::Seconds();
+		FSyntheticProject Project = Generate(Scenario, Seed);
+		UE_LOG(LogTemp, Display, TEXT("Benchmark %s: generated %d textures, %d presets in %.1f s"),
+			*Name, Project.Textures.Num(), Project.Presets.Num(), FPlatformTime::Seconds() - GenerateStart);
+
+		TArray<FTextureManagerBenchmarkResult> Results;
+		FWindowState State;
+
+		Results.Add(Measure(Name, TEXT("RefreshTextureList"), NumIterations, [&](int32)
+			{
+				RefreshTextureList(State, Project.Root);
+			}));
+
+		Results.Add(Measure(Name, TEXT("RefreshPresetList"), NumIterations, [&](int32)
+			{
+				RefreshPresetList(State, Project.Root);
+			}));
+
+		if (!Project.Presets.IsEmpty())
+		{
+			Results.Add(Measure(Name, TEXT("FilterByPreset"), NumIterations, [&](int32 Iteration)
+				{
+					FilterByPreset(State, Project.Root, TextureManagerLists::GetPresetLabel(Project.Presets[Iteration % Project.Presets.Num()]));
+				}));
+		}
+
+		// A few percent of the names match, as a typed query would
+		Results.Add(Measure(Name, TEXT("SearchFiles"), NumIterations, [&](int32)
+			{
+				SearchFiles(State, TEXT("42"));
+			}));
+
+		Results.Add(Measure(Name, TEXT("SearchPresets"), NumIterations, [&](int32)
+			{
+				SearchPresets(State, TEXT("42"));
+			}));
+
+		if (!Project.Presets.IsEmpty() && !Project.Textures.IsEmpty())
+		{
+			// Spread over the folders, like a search result
+			TArray<UTexture2D*> Selection;
+			const int32 Stride = FMath::Max(1, Project.Textures.Num() / NumSelected);
+			for (int32 Index = 0; Index < Project.Textures.Num() && Selection.Num() < NumSelected; Index += Stride)
+			{
+				Selection.Add(Project.Textures[Index]);
+			}
+
+			Results.Add(Measure(Name, TEXT("SaveFiles"), NumIterations,
+				[&](int32 Iteration)
+				{
+					ApplyToSelection(Selection, Project.Presets[Iteration % Project.Presets.Num()]);
+				},
+				[](int32)
+				{
+					FAssetCompilingManager::Get().FinishAllCompilation();
+				}));
+
+			// The same packages are dirty for every iteration, as after one apply
+			auto DirtySelection = [&](int32 Iteration)
+				{
+					for (UTexture2D* Texture : Selection)
+					{
+						Texture->GetOutermost()->SetDirtyFlag(true);
+					}
+					Project.Presets[Iteration % Project.Presets.Num()]->GetOutermost()->SetDirtyFlag(true);
+				};
+			DirtySelection(0);
+
+			Results.Add(Measure(Name, TEXT("SaveDirtyTexturesAndPresets"), NumIterations,
+				[&](int32)
+				{
+					SaveDirty(State);
+				},
+				[&](int32 Iteration)
+				{
+					DirtySelection(Iteration + 1);
+				}));
+		}
+
+		Destroy(Project);
+		return Results;
+	}
+
+	TArray<FTextureManagerBenchmarkResult> RunMicro(const TArray<int32>& Sizes, int32 NumIterations)
+	{
+		check(IsInGameThread());
+
+		TArray<FTextureManagerBenchmarkResult> Results;
+		for (const int32 Size : Sizes)
+		{
+			const FString Scenario = FString::Printf(TEXT("Files%d"), Size);
+			const int32 NumBefore = Results.Num();
+
+			UTexturePresetAsset* PresetA = NewTransientPreset(TC_Default, 0);
+			UTexturePresetAsset* PresetB = NewTransientPreset(TC_Normalmap, 1);
+			UTexturePresetAsset* Scratch = NewTransientPreset(TC_Default, 0);
+			const TArray<UTexture2D*> Textures = NewTransientTextures(Size, PresetA);
+
+			Results.Add(Measure(Scenario, TEXT("CaptureFromTexture"), NumIterations, [&](int32)
+				{
+					for (UTexture2D* Texture : Textures)
+					{
+						TexturePresetLibrary::CaptureFromTexture(Scratch, Texture);
+					}
+				}));
+
+			// Alternate, so every call writes
+			Results.Add(Measure(Scenario, TEXT("ApplyToTexture"), NumIterations, [&](int32 Iteration)
+				{
+					UTexturePresetAsset* Preset = Iteration % 2 ? PresetA : PresetB;
+					for (UTexture2D* Texture : Textures)
+					{
+						TexturePresetLibrary::ApplyToTexture(Preset, Texture);
+					}
+				}));
+
+			Results.Add(Measure(Scenario, TEXT("DiffTexture"), NumIterations, [&](int32)
+				{
+					for (UTexture2D* Texture : Textures)
+					{
+						TexturePresetLibrary::DiffTexture(PresetB, Texture);
+					}
+				}));
+
+			Results.Add(Measure(Scenario, TEXT("CopyProperties"), NumIterations, [&](int32 Iteration)
+				{
+					UTexturePresetAsset* From = Iteration % 2 ? PresetA : PresetB;
+					for (int32 Index = 0; Index < Textures.Num(); ++Index)
+					{
+						TexturePresetLibrary::CopyProperties(From, Scratch);
+					}
+				}));
+
+			// Every texture moves from one preset's Files to the other's and back
+			// on the next iteration: Find / Remove on a list of Size entries
+			Results.Add(Measure(Scenario, TEXT("AssignPresetToTexture"), NumIterations, [&](int32 Iteration)
+				{
+					UTexturePresetAsset* To = Iteration % 2 ? PresetA : PresetB;
+					for (UTexture2D* Texture : Textures)
+					{
+						TexturePresetLibrary::AssignPresetToTexture(To, Texture);
+					}
+				}));
+
+			TArray<FTexturePresetSettings> Captured;
+			Captured.Reserve(Textures.Num());
+			for (const UTexture2D* Texture : Textures)
+			{
+				Captured.Add(TexturePresetLibrary::CaptureSettings(Texture));
+			}
+
+			const FTextureClusteringOptions Options;
+			Results.Add(Measure(Scenario, TEXT("HashSettings"), NumIterations, [&](int32)
+				{
+					for (const FTexturePresetSettings& Settings : Captured)
+					{
+						TexturePresetClustering::HashSettings(Settings, Options, true);
+					}
+				}));
+
+			Results.Add(Measure(Scenario, TEXT("GetPresetHash"), NumIterations, [&](int32 Iteration)
+				{
+					UTexturePresetAsset* Preset = Iteration % 2 ? PresetA : PresetB;
+					for (int32 Index = 0; Index < Textures.Num(); ++Index)
+					{
+						TexturePresetCook::GetPresetHash(Preset, NAME_None);
+					}
+				}));
+
+			for (int32 Index = NumBefore; Index < Results.Num(); ++Index)
+			{
+				Results[Index].Size = Size;
+			}
+
+			for (UObject* Object : TArray<UObject*>{ PresetA, PresetB, Scratch })
+			{
+				Object->MarkAsGarbage();
+			}
+			for (UTexture2D* Texture : Textures)
+			{
+				Texture->MarkAsGarbage();
+			}
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+		return Results;
+	}
+
+	bool CheckPreviewPoolLeak(int32 NumSelections)
+	{
+		check(IsInGameThread());
+
+		// Objects other systems create meanwhile; a leak is one per selection
+		constexpr int32 ObjectSlack = 32;
+		const int32 NumWarmup = FMath::Min(100, NumSelections);
+
+		UTexturePresetAsset* Preset = NewTransientPreset(TC_Default, 0);
+		const TArray<UTexture2D*> Textures = NewTransientTextures(NumSelections, Preset);
+		for (UTexture2D* Texture : Textures)
+		{
+			Texture->Source.Init(64, 64, 1, 1, TSF_BGRA8);
+		}
+
+		FTexturePreviewPool Pool;
+		int32 MaxPooled = 0;
+		int32 WarmupObjects = 0;
+		int64 WarmupBytes = 0;
+		uint64 WarmupPhysical = 0;
+		int32 NumObjects = 0;
+
+		for (int32 Index = 0; Index < Textures.Num(); ++Index)
+		{
+			// Selecting a row, the preset combo following it, and an edit in the details view
+			Pool.GetTexture(Textures[Index]);
+			Pool.GetPreset(Preset);
+			Pool.GetScratchPreset(Preset);
+			MaxPooled = FMath::Max(MaxPooled, Pool.GetNum());
+
+			const int32 NumDone = Index + 1;
+			if (NumDone % 100 != 0 && NumDone != NumWarmup && NumDone != Textures.Num())
+			{
+				continue;
+			}
+
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			NumObjects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+			const uint64 Physical = FPlatformMemory::GetStats().UsedPhysical;
+			if (NumDone == NumWarmup)
+			{
+				WarmupObjects = NumObjects;
+				WarmupBytes = FTexturePreviewPool::GetLiveBytes();
+				WarmupPhysical = Physical;
+			}
+
+			UE_LOG(LogTemp, Display, TEXT("Preview leak check: %d selections, %d objects, %d previews (%s), %s used"),
+				NumDone, NumObjects, Pool.GetNum(),
+				*FText::AsMemory(FTexturePreviewPool::GetLiveBytes()).ToString(),
+				*FText::AsMemory(Physical).ToString());
+		}
+
+		const int64 GrowthBytes = FTexturePreviewPool::GetLiveBytes() - WarmupBytes;
+		const int64 GrowthPhysical = int64(FPlatformMemory::GetStats().UsedPhysical) - int64(WarmupPhysical);
+		const bool bPassed = NumObjects - WarmupObjects <= ObjectSlack && GrowthBytes <= 0;
+
+		// Process memory is noisy (allocator caches, logging); reported, not judged
+		UE_LOG(LogTemp, Display, TEXT("Preview leak check %s: after %d of %d selections %+d objects, previews %+lld bytes (at most %d held), process %+lld bytes"),
+			bPassed ? TEXT("passed") : TEXT("FAILED"),
+			NumWarmup, NumSelections, NumObjects - WarmupObjects, GrowthBytes, MaxPooled, GrowthPhysical);
+
+		Pool.Reset();
+		Preset->MarkAsGarbage();
+		for (UTexture2D* Texture : Textures)
+		{
+			Texture->MarkAsGarbage();
+		}
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		return bPassed;
+	}
+
+	TArray<FString> DescribeScaling(const TArray<FTextureManagerBenchmarkResult>& Results)
+	{
+		// Name -> results by size, in the order they ran
+		TMap<FString, TArray<const FTextureManagerBenchmarkResult*>> ByName;
+		for (const FTextureManagerBenchmarkResult& Result : Results)
+		{
+			if (Result.Size > 0)
+			{
+				ByName.FindOrAdd(Result.Name).Add(&Result);
+			}
+		}
+
+		TArray<FString> Lines;
+		for (TPair<FString, TArray<const FTextureManagerBenchmarkResult*>>& Pair : ByName)
+		{
+			Pair.Value.Sort([](const FTextureManagerBenchmarkResult& A, const FTextureManagerBenchmarkResult& B)
+				{
+					return A.Size < B.Size;
+				});
+
+			FString Line = Pair.Key + TEXT(":");
+			for (int32 Index = 0; Index < Pair.Value.Num(); ++Index)
+			{
+				const FTextureManagerBenchmarkResult& Result = *Pair.Value[Index];
+				Line += FString::Printf(TEXT(" %d -> %.3f ms"), Result.Size, Result.MedianMs);
+
+				const FTextureManagerBenchmarkResult* Previous = Index > 0 ? Pair.Value[Index - 1] : nullptr;
+				if (Previous && Previous->MedianMs > 0.0 && Result.MedianMs > 0.0 && Result.Size > Previous->Size)
+				{
+					const double Exponent = FMath::Loge(Result.MedianMs / Previous->MedianMs)
+						/ FMath::Loge(double(Result.Size) / double(Previous->Size));
+					Line += FString::Printf(TEXT(" (n^%.2f)"), Exponent);
+				}
+				Line += Index + 1 < Pair.Value.Num() ? TEXT(",") : TEXT("");
+			}
+			Lines.Add(MoveTemp(Line));
+		}
+		return Lines;
+	}
+
+	bool SaveJson(const TArray<FTextureManagerBenchmarkResult>& Results, const FString& FilePath)
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		for (const FTextureManagerBenchmarkResult& Result : Results)
+		{
+			TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+			Object->SetStringField(TEXT("Scenario"), Result.Scenario);
+			Object->SetStringField(TEXT("Name"), Result.Name);
+			Object->SetNumberField(TEXT("Size"), Result.Size);
+			Object->SetNumberField(TEXT("Iterations"), Result.NumIterations);
+			Object->SetNumberField(TEXT("MinMs"), Result.MinMs);
+			Object->SetNumberField(TEXT("MedianMs"), Result.MedianMs);
+			Object->SetNumberField(TEXT("MeanMs"), Result.MeanMs);
+			Object->SetNumberField(TEXT("MaxMs"), Result.MaxMs);
+			Values.Add(MakeShared<FJsonValueObject>(Object));
+		}
+
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetStringField(TEXT("Date"), FDateTime::UtcNow().ToIso8601());
+		Root->SetArrayField(TEXT("Results"), Values);
+
+		FString Json;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		return FJsonSerializer::Serialize(Root, Writer) && FFileHelper::SaveStringToFile(Json, *FilePath);
+	}
+
+	bool LoadJson(const FString& FilePath, TArray<FTextureManagerBenchmarkResult>& OutResults)
+	{
+		FString Json;
+		if (!FFileHelper::LoadFileToString(Json, *FilePath))
+		{
+			return false;
+		}
+
+		TSharedPtr<FJsonObject> Root;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) || !Root.IsValid())
+		{
+			return false;
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+		if (!Root->TryGetArrayField(TEXT("Results"), Values))
+		{
+			return false;
+		}
+
+		for (const TSharedPtr<FJsonValue>& Value : *Values)
+		{
+			const TSharedPtr<FJsonObject>* Object = nullptr;
+			if (!Value->TryGetObject(Object))
+			{
+				continue;
+			}
+
+			FTextureManagerBenchmarkResult& Result = OutResults.AddDefaulted_GetRef();
+			(*Object)->TryGetStringField(TEXT("Scenario"), Result.Scenario);
+			(*Object)->TryGetStringField(TEXT("Name"), Result.Name);
+			(*Object)->TryGetNumberField(TEXT("Size"), Result.Size);
+			(*Object)->TryGetNumberField(TEXT("Iterations"), Result.NumIterations);
+			(*Object)->TryGetNumberField(TEXT("MinMs"), Result.MinMs);
+			(*Object)->TryGetNumberField(TEXT("MedianMs"), Result.MedianMs);
+			(*Object)->TryGetNumberField(TEXT("MeanMs"), Result.MeanMs);
+			(*Object)->TryGetNumberField(TEXT("MaxMs"), Result.MaxMs);
+		}
+		return true;
+	}
+
+	TArray<FString> FindRegressions(
+		const TArray<FTextureManagerBenchmarkResult>& Results,
+		const TArray<FTextureManagerBenchmarkResult>& Baseline,
+		double Threshold,
+		double MinDeltaMs)
+	{
+		TMap<FString, double> BaselineMedians;
+		for (const FTextureManagerBenchmarkResult& Result : Baseline)
+		{
+			BaselineMedians.Add(Result.Scenario / Result.Name, Result.MedianMs);
+		}
+
+		TArray<FString> Regressions;
+		for (const FTextureManagerBenchmarkResult& Result : Results)
+		{
+			const double* BaselineMs = BaselineMedians.Find(Result.Scenario / Result.Name);
+			if (!BaselineMs)
+			{
+				continue;
+			}
+
+			// Both: a relative jump on a tiny time is noise, so is a small delta on a long one
+			const double DeltaMs = Result.MedianMs - *BaselineMs;
+			if (DeltaMs > MinDeltaMs && Result.MedianMs > *BaselineMs * (1.0 + Threshold))
+			{
+				Regressions.Add(FString::Printf(TEXT("%s %s: %.2f ms -> %.2f ms (+%.0f%%)"),
+					*Result.Scenario, *Result.Name, *BaselineMs, Result.MedianMs,
+					*BaselineMs > 0.0 ? 100.0 * DeltaMs / *BaselineMs : 100.0));
+			}
+		}
+		return Regressions;
+	}
+}
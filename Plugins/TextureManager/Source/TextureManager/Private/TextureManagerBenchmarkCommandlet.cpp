@@ -0,0 +1,153 @@
+#include "TextureManagerBenchmarkCommandlet.h"
+
+#include "TextureManagerBenchmark.h"
+
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	// "100,1000" -> sizes; malformed entries are skipped
+	TArray<int32> ParseSizes(const FString& List)
+	{
+		TArray<FString> Entries;
+		List.ParseIntoArray(Entries, TEXT(","));
+
+		TArray<int32> Sizes;
+		for (const FString& Entry : Entries)
+		{
+			if (Entry.IsNumeric() && FCString::Atoi(*Entry) > 0)
+			{
+				Sizes.Add(FCString::Atoi(*Entry));
+			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Benchmark: ignoring size '%s'"), *Entry);
+			}
+		}
+		return Sizes;
+	}
+
+	// "1000x10,10000x100" -> scenarios; malformed entries are skipped
+	TArray<FTextureManagerBenchmarkScenario> ParseScenarios(const FString& List)
+	{
+		TArray<FString> Entries;
+		List.ParseIntoArray(Entries, TEXT(","));
+
+		TArray<FTextureManagerBenchmarkScenario> Scenarios;
+		for (const FString& Entry : Entries)
+		{
+			FString Textures;
+			FString Presets;
+			if (!Entry.Split(TEXT("x"), &Textures, &Presets) || !Textures.IsNumeric() || !Presets.IsNumeric())
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Benchmark: ignoring scenario '%s', expected <textures>x<presets>"), *Entry);
+				continue;
+			}
+
+			FTextureManagerBenchmarkScenario& Scenario = Scenarios.AddDefaulted_GetRef();
+			Scenario.NumTextures = FCString::Atoi(*Textures);
+			Scenario.NumPresets = FCString::Atoi(*Presets);
+		}
+		return Scenarios;
+	}
+}
+
+UTextureManagerBenchmarkCommandlet::UTextureManagerBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UTextureManagerBenchmarkCommandlet::Main(const FString& Params)
+{
+	IAssetRegistry::GetChecked().SearchAllAssets(true);
+
+	if (FParse::Param(*Params, TEXT("previewleak")))
+	{
+		int32 NumSelections = 1000;
+		FParse::Value(*Params, TEXT("selections="), NumSelections);
+		return TextureManagerBenchmark::CheckPreviewPoolLeak(FMath::Max(NumSelections, 1)) ? 0 : 2;
+	}
+
+	const bool bMicro = FParse::Param(*Params, TEXT("micro"));
+
+	FString ScenarioList = TEXT("1000x10,10000x100,100000x1000");
+	FParse::Value(*Params, TEXT("scenarios="), ScenarioList, false);
+	const TArray<FTextureManagerBenchmarkScenario> Scenarios = ParseScenarios(ScenarioList);
+
+	FString SizeList = TEXT("100,1000,10000");
+	FParse::Value(*Params, TEXT("sizes="), SizeList, false);
+	const TArray<int32> Sizes = ParseSizes(SizeList);
+
+	if (bMicro ? Sizes.IsEmpty() : Scenarios.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Benchmark: nothing to run"));
+		return 1;
+	}
+
+	int32 NumIterations = 5;
+	FParse::Value(*Params, TEXT("iterations="), NumIterations);
+	NumIterations = FMath::Max(NumIterations, 1);
+
+	int32 Seed = 1;
+	FParse::Value(*Params, TEXT("seed="), Seed);
+
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("TextureManager") / TEXT("Benchmark.json");
+	FParse::Value(*Params, TEXT("output="), OutputPath);
+
+	double Threshold = 0.1;
+	FParse::Value(*Params, TEXT("threshold="), Threshold);
+
+	double MinDeltaMs = 1.0;
+	FParse::Value(*Params, TEXT("mindelta="), MinDeltaMs);
+
+	TArray<FTextureManagerBenchmarkResult> Results;
+	if (bMicro)
+	{
+		Results = TextureManagerBenchmark::RunMicro(Sizes, NumIterations);
+		for (const FString& Line : TextureManagerBenchmark::DescribeScaling(Results))
+		{
+			UE_LOG(LogTemp, Display, TEXT("Benchmark scaling: %s"), *Line);
+		}
+	}
+	else
+	{
+		for (const FTextureManagerBenchmarkScenario& Scenario : Scenarios)
+		{
+			Results.Append(TextureManagerBenchmark::RunScenario(Scenario, NumIterations, Seed));
+		}
+	}
+
+	if (!TextureManagerBenchmark::SaveJson(Results, OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Benchmark: could not write %s"), *OutputPath);
+		return 1;
+	}
+	UE_LOG(LogTemp, Display, TEXT("Benchmark: %d results written to %s"), Results.Num(), *FPaths::ConvertRelativePathToFull(OutputPath));
+
+	FString BaselinePath;
+	if (!FParse::Value(*Params, TEXT("baseline="), BaselinePath))
+	{
+		return 0;
+	}
+
+	TArray<FTextureManagerBenchmarkResult> Baseline;
+	if (!TextureManagerBenchmark::LoadJson(BaselinePath, Baseline))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Benchmark: could not read baseline %s"), *BaselinePath);
+		return 1;
+	}
+
+	const TArray<FString> Regressions = TextureManagerBenchmark::FindRegressions(Results, Baseline, Threshold, MinDeltaMs);
+	for (const FString& Regression : Regressions)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Benchmark regression: %s"), *Regression);
+	}
+	UE_LOG(LogTemp, Display, TEXT("Benchmark: %d regressions against %s (threshold %.0f%%, at least %.1f ms)"),
+		Regressions.Num(), *BaselinePath, Threshold * 100.0, MinDeltaMs);
+
+	return Regressions.IsEmpty() ? 0 : 2;
+}
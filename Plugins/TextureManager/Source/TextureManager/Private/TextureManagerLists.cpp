@@ -0,0 +1,166 @@
+#include "TextureManagerLists.h"
+
+#include "TextureManagerMetrics.h"
+#include "TextureManagerStats.h"
+#include "TexturePresetAsset.h"
+#include "TexturePresetUserData.h"
+
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Texture2D.h"
+#include "Interfaces/IPluginManager.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	template <typename ObjectType>
+	TArray<TWeakObjectPtr<ObjectType>> LoadAll(const TArray<FAssetData>& Assets)
+	{
+		TArray<TWeakObjectPtr<ObjectType>> Items;
+		Items.Reserve(Assets.Num());
+		for (const FAssetData& Data : Assets)
+		{
+			if (ObjectType* Object = Cast<ObjectType>(TextureManagerMetrics::LoadAsset(Data)))
+			{
+				Items.Add(Object);
+			}
+		}
+		return Items;
+	}
+
+	template <typename ObjectType>
+	void AddDirtyPackages(const TArray<TWeakObjectPtr<ObjectType>>& Items, TArray<UPackage*>& OutPackages)
+	{
+		for (const TWeakObjectPtr<ObjectType>& Item : Items)
+		{
+			UPackage* Package = Item.IsValid() ? Item->GetOutermost() : nullptr;
+			if (Package && Package->IsDirty())
+			{
+				OutPackages.AddUnique(Package);
+			}
+		}
+	}
+}
+
+namespace TextureManagerLists
+{
+	TArray<FName> GetContentRoots()
+	{
+		TArray<FName> Roots;
+		Roots.Add(FName(TEXT("/Game")));
+
+		if (TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("TextureManager")))
+		{
+			const FString PluginRoot = Plugin->GetMountedAssetPath(); // e.g. "/TextureManager"
+			if (!PluginRoot.IsEmpty())
+			{
+				Roots.Add(FName(*PluginRoot));
+			}
+		}
+		return Roots;
+	}
+
+	TArray<FAssetData> QueryAssets(const UClass* Class, const TArray<FName>& Roots)
+	{
+		FARFilter Filter;
+		Filter.ClassPaths.Add(Class->GetClassPathName());
+		Filter.bRecursivePaths = true;
+		Filter.bRecursiveClasses = true;
+		Filter.PackagePaths = Roots;
+
+		TArray<FAssetData> Assets;
+		FTextureManagerPhaseScope Phase(ETextureManagerPhase::RegistryQuery);
+		IAssetRegistry::GetChecked().GetAssets(Filter, Assets);
+		return Assets;
+	}
+
+	TArray<TWeakObjectPtr<UTexture2D>> LoadTextures(const TArray<FAssetData>& Assets)
+	{
+		TEXTURE_MANAGER_SCOPE("LoadTextures");
+		return LoadAll<UTexture2D>(Assets);
+	}
+
+	TArray<TWeakObjectPtr<UTexturePresetAsset>> LoadPresets(const TArray<FAssetData>& Assets)
+	{
+		TEXTURE_MANAGER_SCOPE("LoadPresets");
+		return LoadAll<UTexturePresetAsset>(Assets);
+	}
+
+	FString GetPresetLabel(const UTexturePresetAsset* Preset)
+	{
+		return !Preset->PresetName.IsNone() ? Preset->PresetName.ToString() : Preset->GetName();
+	}
+
+	TArray<TWeakObjectPtr<UTexture2D>> FilterByPreset(
+		const TArray<TWeakObjectPtr<UTexture2D>>& Textures,
+		const UTexturePresetAsset* Preset)
+	{
+		TArray<TWeakObjectPtr<UTexture2D>> Filtered;
+		for (const TWeakObjectPtr<UTexture2D>& Item : Textures)
+		{
+			if (!Item.IsValid())
+			{
+				continue;
+			}
+
+			const UTexturePresetUserData* UserData = Cast<UTexturePresetUserData>(
+				Item->GetAssetUserDataOfClass(UTexturePresetUserData::StaticClass()));
+			const bool bMatches = Preset
+				? UserData && UserData->AssignedPreset == Preset
+				: !UserData;
+			if (bMatches)
+			{
+				Filtered.Add(Item);
+			}
+		}
+		return Filtered;
+	}
+
+	TArray<TWeakObjectPtr<UTexture2D>> SearchTextures(
+		const TArray<TWeakObjectPtr<UTexture2D>>& Textures,
+		const FString& Query)
+	{
+		TArray<TWeakObjectPtr<UTexture2D>> Filtered;
+		for (const TWeakObjectPtr<UTexture2D>& Item : Textures)
+		{
+			if (Item.IsValid() && (Query.IsEmpty() || Item->GetName().Contains(Query)))
+			{
+				Filtered.Add(Item);
+			}
+		}
+		return Filtered;
+	}
+
+	TArray<TWeakObjectPtr<UTexturePresetAsset>> SearchPresets(
+		const TArray<TWeakObjectPtr<UTexturePresetAsset>>& Presets,
+		const FString& Query)
+	{
+		TArray<TWeakObjectPtr<UTexturePresetAsset>> Filtered;
+		for (const TWeakObjectPtr<UTexturePresetAsset>& Item : Presets)
+		{
+			if (Item.IsValid() && (Query.IsEmpty() || GetPresetLabel(Item.Get()).Contains(Query)))
+			{
+				Filtered.Add(Item);
+			}
+		}
+		return Filtered;
+	}
+
+	TArray<UPackage*> GatherDirtyPackages(
+		const TArray<FAssetData>& Textures,
+		const TArray<TWeakObjectPtr<UTexturePresetAsset>>& Presets)
+	{
+		TEXTURE_MANAGER_SCOPE("GatherDirtyPackages");
+		TArray<UPackage*> Packages;
+		for (const FAssetData& Asset : Textures)
+		{
+			const UObject* Texture = Asset.FastGetAsset(false);
+			UPackage* Package = Texture ? Texture->GetOutermost() : nullptr;
+			if (Package && Package->IsDirty())
+			{
+				Packages.AddUnique(Package);
+			}
+		}
+		AddDirtyPackages(Presets, Packages);
+		return Packages;
+	}
+}
@@ -0,0 +1,279 @@
+#include "TextureManagerMetrics.h"
+
+#include "TextureManagerStats.h"
+
+#include "Algo/Sort.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	constexpr double MinBucketSeconds = 1e-6;
+	constexpr int32 NumBucketsPerOctave = 4;
+
+	// 32 octaves from 1 us: a bit over an hour
+	constexpr int32 NumBuckets = 32 * NumBucketsPerOctave;
+
+	struct FLatencyHistogram
+	{
+		int64 Buckets[NumBuckets] = {};
+		int64 Count = 0;
+		double TotalSeconds = 0.0;
+		double MaxSeconds = 0.0;
+
+		void Add(double Seconds)
+		{
+			const double Octaves = FMath::Log2(FMath::Max(Seconds, MinBucketSeconds) / MinBucketSeconds);
+			const int32 Bucket = FMath::Clamp(FMath::FloorToInt32(Octaves * NumBucketsPerOctave), 0, NumBuckets - 1);
+			++Buckets[Bucket];
+			++Count;
+			TotalSeconds += Seconds;
+			MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+		}
+
+		// Upper edge of the bucket holding the sample at Fraction, at most the slowest sample
+		double GetPercentile(double Fraction) const
+		{
+			const int64 Rank = FMath::Max<int64>(1, FMath::CeilToInt64(Fraction * double(Count)));
+			int64 Seen = 0;
+			for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+			{
+				Seen += Buckets[Bucket];
+				if (Seen >= Rank)
+				{
+					const double UpperEdge = MinBucketSeconds * FMath::Pow(2.0, double(Bucket + 1) / NumBucketsPerOctave);
+					return FMath::Min(UpperEdge, MaxSeconds);
+				}
+			}
+			return MaxSeconds;
+		}
+
+		void Summarize(FTextureManagerLatencySummary& Out) const
+		{
+			Out.Count = Count;
+			Out.TotalSeconds = TotalSeconds;
+			Out.MaxSeconds = MaxSeconds;
+			if (Count > 0)
+			{
+				Out.P50Seconds = GetPercentile(0.50);
+				Out.P95Seconds = GetPercentile(0.95);
+				Out.P99Seconds = GetPercentile(0.99);
+			}
+		}
+	};
+
+	struct FOperationMetrics
+	{
+		FLatencyHistogram Latency;
+		int64 BytesLoaded = 0;
+		int64 PackagesSaved = 0;
+	};
+
+	struct FOpenOperation
+	{
+		FName Name;
+		double StartSeconds = 0.0;
+		int64 BytesLoaded = 0;
+		int64 PackagesSaved = 0;
+	};
+
+	FLatencyHistogram GPhases[int32(ETextureManagerPhase::Num)];
+	int64 GBytesLoaded = 0;
+	int64 GPackagesSaved = 0;
+
+	TMap<FName, FOperationMetrics> GOperations;
+
+	// Innermost last
+	TArray<FOpenOperation> GOpenOperations;
+
+	uint32 GRevision = 0;
+
+	FString GetDefaultCsvPath()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("TextureManager") / TEXT("Metrics.csv");
+	}
+
+	void DumpCsv(const TArray<FString>& Args)
+	{
+		const FString CsvPath = Args.IsEmpty() ? GetDefaultCsvPath() : Args[0];
+		if (TextureManagerMetrics::SaveCsv(CsvPath))
+		{
+			UE_LOG(LogTemp, Display, TEXT("Texture Manager metrics written to %s"), *FPaths::ConvertRelativePathToFull(CsvPath));
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("Could not write %s"), *CsvPath);
+		}
+	}
+
+	FAutoConsoleCommand GDumpCsvCommand(
+		TEXT("TextureManager.Metrics.DumpCsv"),
+		TEXT("Write the Texture Manager latency histograms to Saved/TextureManager/Metrics.csv, or to the given path"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&DumpCsv));
+
+	FAutoConsoleCommand GResetCommand(
+		TEXT("TextureManager.Metrics.Reset"),
+		TEXT("Clear the Texture Manager latency histograms"),
+		FConsoleCommandDelegate::CreateStatic(&TextureManagerMetrics::Reset));
+}
+
+namespace TextureManagerMetrics
+{
+	const TCHAR* GetPhaseName(ETextureManagerPhase Phase)
+	{
+		switch (Phase)
+		{
+		case ETextureManagerPhase::RegistryQuery: return TEXT("RegistryQuery");
+		case ETextureManagerPhase::Load:          return TEXT("Load");
+		case ETextureManagerPhase::Apply:         return TEXT("Apply");
+		case ETextureManagerPhase::Rebuild:       return TEXT("Rebuild");
+		case ETextureManagerPhase::Save:          return TEXT("Save");
+		default:                                  return TEXT("Unknown");
+		}
+	}
+
+	void AddSample(ETextureManagerPhase Phase, double Seconds)
+	{
+		GPhases[int32(Phase)].Add(Seconds);
+		++GRevision;
+	}
+
+	void AddBytesLoaded(int64 Bytes)
+	{
+		GBytesLoaded += Bytes;
+		for (FOpenOperation& Operation : GOpenOperations)
+		{
+			Operation.BytesLoaded += Bytes;
+		}
+	}
+
+	void AddPackagesSaved(int32 NumPackages)
+	{
+		TRACE_COUNTER_ADD(TextureManager_PackagesSaved, NumPackages);
+		GPackagesSaved += NumPackages;
+		for (FOpenOperation& Operation : GOpenOperations)
+		{
+			Operation.PackagesSaved += NumPackages;
+		}
+	}
+
+	UObject* LoadAsset(const FAssetData& Asset)
+	{
+		if (Asset.IsAssetLoaded())
+		{
+			return Asset.GetAsset();
+		}
+
+		FTextureManagerPhaseScope Phase(ETextureManagerPhase::Load);
+		UObject* Object = Asset.GetAsset();
+		if (Object)
+		{
+			if (const TOptional<FAssetPackageData> PackageData = IAssetRegistry::GetChecked().GetAssetPackageDataCopy(Asset.PackageName))
+			{
+				AddBytesLoaded(PackageData->DiskSize);
+			}
+		}
+		return Object;
+	}
+
+	TArray<FTextureManagerLatencySummary> GetSummaries()
+	{
+		TArray<FTextureManagerLatencySummary> Summaries;
+		for (int32 Index = 0; Index < int32(ETextureManagerPhase::Num); ++Index)
+		{
+			const ETextureManagerPhase Phase = ETextureManagerPhase(Index);
+			FTextureManagerLatencySummary& Summary = Summaries.AddDefaulted_GetRef();
+			Summary.Name = GetPhaseName(Phase);
+			GPhases[Index].Summarize(Summary);
+			Summary.BytesLoaded = Phase == ETextureManagerPhase::Load ? GBytesLoaded : 0;
+			Summary.PackagesSaved = Phase == ETextureManagerPhase::Save ? GPackagesSaved : 0;
+		}
+
+		const int32 NumPhases = Summaries.Num();
+		for (const TPair<FName, FOperationMetrics>& Pair : GOperations)
+		{
+			FTextureManagerLatencySummary& Summary = Summaries.AddDefaulted_GetRef();
+			Summary.Name = Pair.Key.ToString();
+			Summary.bOperation = true;
+			Pair.Value.Latency.Summarize(Summary);
+			Summary.BytesLoaded = Pair.Value.BytesLoaded;
+			Summary.PackagesSaved = Pair.Value.PackagesSaved;
+		}
+
+		Algo::Sort(MakeArrayView(Summaries).RightChop(NumPhases), [](const FTextureManagerLatencySummary& A, const FTextureManagerLatencySummary& B)
+			{
+				return A.Name < B.Name;
+			});
+		return Summaries;
+	}
+
+	uint32 GetRevision()
+	{
+		return GRevision;
+	}
+
+	void Reset()
+	{
+		for (FLatencyHistogram& Histogram : GPhases)
+		{
+			Histogram = FLatencyHistogram();
+		}
+		GBytesLoaded = 0;
+		GPackagesSaved = 0;
+		GOperations.Reset();
+		++GRevision;
+	}
+
+	bool SaveCsv(const FString& FilePath)
+	{
+		const TArray<FTextureManagerLatencySummary> Summaries = GetSummaries();
+
+		TArray<FString> Lines;
+		Lines.Reserve(Summaries.Num() + 1);
+		Lines.Add(TEXT("Kind,Name,Count,TotalMs,MeanMs,P50Ms,P95Ms,P99Ms,MaxMs,BytesLoaded,PackagesSaved,BytesLoadedPerOp,PackagesSavedPerOp"));
+
+		for (const FTextureManagerLatencySummary& Summary : Summaries)
+		{
+			const double Count = double(FMath::Max<int64>(Summary.Count, 1));
+			Lines.Add(FString::Printf(TEXT("%s,%s,%lld,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%lld,%lld,%.1f,%.2f"),
+				Summary.bOperation ? TEXT("Operation") : TEXT("Phase"),
+				*Summary.Name,
+				Summary.Count,
+				Summary.TotalSeconds * 1000.0,
+				Summary.TotalSeconds * 1000.0 / Count,
+				Summary.P50Seconds * 1000.0,
+				Summary.P95Seconds * 1000.0,
+				Summary.P99Seconds * 1000.0,
+				Summary.MaxSeconds * 1000.0,
+				Summary.BytesLoaded,
+				Summary.PackagesSaved,
+				double(Summary.BytesLoaded) / Count,
+				double(Summary.PackagesSaved) / Count));
+		}
+
+		return FFileHelper::SaveStringArrayToFile(Lines, *FilePath);
+	}
+}
+
+FTextureManagerOperationScope::FTextureManagerOperationScope(FName Name)
+{
+	check(IsInGameThread());
+
+	FOpenOperation& Operation = GOpenOperations.AddDefaulted_GetRef();
+	Operation.Name = Name;
+	Operation.StartSeconds = FPlatformTime::Seconds();
+}
+
+FTextureManagerOperationScope::~FTextureManagerOperationScope()
+{
+	const FOpenOperation Operation = GOpenOperations.Pop(EAllowShrinking::No);
+
+	FOperationMetrics& Metrics = GOperations.FindOrAdd(Operation.Name);
+	Metrics.Latency.Add(FPlatformTime::Seconds() - Operation.StartSeconds);
+	Metrics.BytesLoaded += Operation.BytesLoaded;
+	Metrics.PackagesSaved += Operation.PackagesSaved;
+	++GRevision;
+}
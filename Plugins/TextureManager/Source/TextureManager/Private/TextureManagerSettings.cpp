@@ -0,0 +1,70 @@
+#include "TextureManagerSettings.h"
+
+#include "TextureFolderPresets.h"
+
+UTextureManagerSettings::UTextureManagerSettings()
+{
+	CategoryName = TEXT("Plugins");
+	SectionName = TEXT("TextureManager");
+}
+
+#if WITH_EDITOR
+void UTextureManagerSettings::PreEditChange(FProperty* PropertyAboutToChange)
+{
+	Super::PreEditChange(PropertyAboutToChange);
+
+	if (bEditInProgress)
+	{
+		return;
+	}
+	bEditInProgress = true;
+
+	FolderPresetsBeforeEdit.Reset();
+	for (const FTextureFolderPreset& Entry : FolderPresets)
+	{
+		FolderPresetsBeforeEdit.Add(Entry.Folder.Path, Entry.Preset.ToSoftObjectPath());
+	}
+}
+
+void UTextureManagerSettings::PostEditChangeProperty(FPropertyChangedEvent& Event)
+{
+	Super::PostEditChangeProperty(Event);
+
+	TextureFolderPresets::Invalidate();
+
+	// Dragging / typing sends many interactive changes; re-apply once it is set
+	if (Event.ChangeType == EPropertyChangeType::Interactive)
+	{
+		return;
+	}
+
+	// Only folders whose preset was added, changed or removed
+	TSet<FString> Changed;
+	TSet<FString> Current;
+	for (const FTextureFolderPreset& Entry : FolderPresets)
+	{
+		Current.Add(Entry.Folder.Path);
+
+		const FSoftObjectPath* Before = FolderPresetsBeforeEdit.Find(Entry.Folder.Path);
+		if (!Before || *Before != Entry.Preset.ToSoftObjectPath())
+		{
+			Changed.Add(Entry.Folder.Path);
+		}
+	}
+	for (const TPair<FString, FSoftObjectPath>& Pair : FolderPresetsBeforeEdit)
+	{
+		if (!Current.Contains(Pair.Key))
+		{
+			Changed.Add(Pair.Key);
+		}
+	}
+	Changed.Remove(FString());
+	FolderPresetsBeforeEdit.Reset();
+	bEditInProgress = false;
+
+	if (!Changed.IsEmpty())
+	{
+		TextureFolderPresets::ReapplyFolders(Changed.Array());
+	}
+}
+#endif
@@ -0,0 +1,18 @@
+#include "TextureManagerStats.h"
+
+UE_TRACE_CHANNEL_DEFINE(TextureManagerChannel)
+
+LLM_DEFINE_TAG(TextureManager);
+
+TRACE_DECLARE_INT_COUNTER(TextureManager_TexturesApplied, TEXT("TextureManager/Textures Applied"));
+TRACE_DECLARE_INT_COUNTER(TextureManager_TexturesCaptured, TEXT("TextureManager/Textures Captured"));
+TRACE_DECLARE_INT_COUNTER(TextureManager_ObjectsCloned, TEXT("TextureManager/Objects Cloned"));
+TRACE_DECLARE_INT_COUNTER(TextureManager_TexturesImported, TEXT("TextureManager/Textures Imported"));
+TRACE_DECLARE_INT_COUNTER(TextureManager_PackagesSaved, TEXT("TextureManager/Packages Saved"));
+TRACE_DECLARE_INT_COUNTER(TextureManager_ListedTextures, TEXT("TextureManager/Listed Textures"));
+TRACE_DECLARE_INT_COUNTER(TextureManager_ListedPresets, TEXT("TextureManager/Listed Presets"));
+TRACE_DECLARE_INT_COUNTER(TextureManager_RebuildsQueued, TEXT("TextureManager/Rebuilds Queued"));
+TRACE_DECLARE_INT_COUNTER(TextureManager_RebuildsRunning, TEXT("TextureManager/Rebuilds Running"));
+TRACE_DECLARE_MEMORY_COUNTER(TextureManager_RebuildMemory, TEXT("TextureManager/Rebuild Memory"));
+TRACE_DECLARE_INT_COUNTER(TextureManager_PreviewObjects, TEXT("TextureManager/Preview Objects"));
+TRACE_DECLARE_MEMORY_COUNTER(TextureManager_PreviewMemory, TEXT("TextureManager/Preview Memory"));
@@ -0,0 +1,417 @@
+#include "TextureMemoryEstimator.h"
+
+#include "TextureAnalysisLibrary.h"
+#include "TexturePresetLibrary.h"
+
+#include "Engine/Texture2D.h"
+#include "Engine/TextureLODSettings.h"
+#include "AssetRegistry/AssetData.h"
+#include "DeviceProfiles/DeviceProfile.h"
+#include "DeviceProfiles/DeviceProfileManager.h"
+
+namespace
+{
+	// Copy the LOD group limits the engine would apply into Inputs
+	void FillGroupInputs(FTextureMemoryInputs& Inputs)
+	{
+		Inputs.MinResidentMips = UTexture2D::GetStaticMinTextureResidentMipCount();
+
+		const UTextureLODSettings* LODSettings = TextureMemoryEstimator::GetActiveLODSettings();
+		if (!LODSettings)
+		{
+			return;
+		}
+
+		const FTextureLODGroup& Group = LODSettings->GetTextureLODGroup(Inputs.Settings.TextureGroup);
+		Inputs.GroupLODBias = Group.LODBias;
+		Inputs.GroupMaxLODSize = Group.MaxLODSize;
+		Inputs.GroupMinLODSize = FMath::Max(Group.MinLODSize, 1);
+		Inputs.GroupNumStreamedMips = Group.NumStreamedMips;
+		Inputs.GroupMipGenSettings = Group.MipGenSettings;
+	}
+
+	// Platform of the active device profile, the one FillGroupInputs reads
+	// the LOD groups of
+	FName GetActivePlatformName()
+	{
+		if (const UDeviceProfile* Profile = UDeviceProfileManager::Get().GetActiveProfile())
+		{
+			return FName(*Profile->DeviceType);
+		}
+		return NAME_None;
+	}
+
+	// Source alpha that survives compression under Settings
+	bool ResolveHasAlpha(const UTexture2D* Texture, const FTexturePresetSettings& Settings)
+	{
+		// A preset without alpha keeps the alpha a texture uses (see the bUseAlpha
+		// binding); one not analyzed yet is taken as removable
+		const FTextureAlphaInfo Alpha = TextureAnalysisLibrary::FindAlphaUsage(Texture);
+		if (!Settings.bUseAlpha)
+		{
+			return Alpha.Usage != ETextureAlphaUsage::Unknown && !Alpha.IsRemovable();
+		}
+
+		// Not analyzed: a texture compressed without alpha may still have it in its source
+		if (Alpha.Usage == ETextureAlphaUsage::Unknown)
+		{
+			return Texture->HasAlphaChannel() || Texture->CompressionNoAlpha;
+		}
+
+		return Alpha.Usage != ETextureAlphaUsage::Absent;
+	}
+
+	int64 GetMipBytes(int32 SizeX, int32 SizeY, int32 BitsPerPixel, int32 BlockSize)
+	{
+		const int64 BlocksX = FMath::DivideAndRoundUp(FMath::Max(SizeX, 1), BlockSize);
+		const int64 BlocksY = FMath::DivideAndRoundUp(FMath::Max(SizeY, 1), BlockSize);
+		return BlocksX * BlocksY * BlockSize * BlockSize * BitsPerPixel / 8;
+	}
+
+	template <typename EnumType>
+	bool GetEnumTag(const FAssetData& Asset, const TCHAR* Tag, EnumType& OutValue)
+	{
+		FString Value;
+		if (!Asset.GetTagValue(FName(Tag), Value))
+		{
+			return false;
+		}
+
+		const int64 Parsed = StaticEnum<EnumType>()->GetValueByNameString(Value);
+		if (Parsed == INDEX_NONE)
+		{
+			return false;
+		}
+
+		OutValue = static_cast<EnumType>(Parsed);
+		return true;
+	}
+}
+
+namespace TextureMemoryEstimator
+{
+	const UTextureLODSettings* GetActiveLODSettings()
+	{
+		if (UDeviceProfile* Profile = UDeviceProfileManager::Get().GetActiveProfile())
+		{
+			return Profile->GetTextureLODSettings();
+		}
+		return nullptr;
+	}
+
+	void GetFormatInfo(TextureCompressionSettings Compression, bool bHasAlpha, int32& OutBitsPerPixel, int32& OutBlockSize)
+	{
+		OutBlockSize = 1;
+
+		switch (Compression)
+		{
+		case TC_Default:
+		case TC_Masks:
+			// BC3 with alpha, BC1 without
+			OutBitsPerPixel = bHasAlpha ? 8 : 4;
+			OutBlockSize = 4;
+			break;
+		case TC_Normalmap:		// BC5
+		case TC_HDR_Compressed:	// BC6H
+		case TC_BC7:
+			OutBitsPerPixel = 8;
+			OutBlockSize = 4;
+			break;
+		case TC_Alpha:			// BC4
+			OutBitsPerPixel = 4;
+			OutBlockSize = 4;
+			break;
+		case TC_Grayscale:
+		case TC_Displacementmap:
+		case TC_DistanceFieldFont:
+			OutBitsPerPixel = 8;
+			break;
+		case TC_HalfFloat:
+		case TC_LQ:
+			OutBitsPerPixel = 16;
+			break;
+		case TC_HDR:
+			OutBitsPerPixel = 64;
+			break;
+		case TC_HDR_F32:
+			OutBitsPerPixel = 128;
+			break;
+		default:
+			// BGRA8 and friends
+			OutBitsPerPixel = 32;
+			break;
+		}
+	}
+
+	FTextureMemoryEstimate Estimate(const FTextureMemoryInputs& Inputs)
+	{
+		FTextureMemoryEstimate Result;
+
+		const FTexturePresetSettings& Settings = Inputs.Settings;
+		if (Inputs.SourceSizeX <= 0 || Inputs.SourceSizeY <= 0)
+		{
+			return Result;
+		}
+
+		const TextureMipGenSettings MipGen = (Settings.MipGenSettings == TMGS_FromTextureGroup)
+			? Inputs.GroupMipGenSettings.GetValue()
+			: Settings.MipGenSettings.GetValue();
+
+		// Non power of two textures don't get a mip chain (and can't stream)
+		const bool bPowerOfTwo = FMath::IsPowerOfTwo(Inputs.SourceSizeX) && FMath::IsPowerOfTwo(Inputs.SourceSizeY);
+		const bool bHasMips = bPowerOfTwo && MipGen != TMGS_NoMipmaps;
+
+		const int32 Longest = FMath::Max(Inputs.SourceSizeX, Inputs.SourceSizeY);
+		const int32 FullMips = bHasMips ? int32(FMath::FloorLog2(uint32(Longest))) + 1 : 1;
+
+		// Mips dropped from the top by MaxTextureSize and the group's MaxLODSize.
+		// Without mips the engine resizes the single level instead; same maths.
+		int32 Dropped = 0;
+		auto LongestAfterDrop = [&]() { return FMath::Max(Longest >> Dropped, 1); };
+
+		if (Settings.MaxTextureSize > 0)
+		{
+			while (LongestAfterDrop() > Settings.MaxTextureSize && LongestAfterDrop() > 1)
+			{
+				++Dropped;
+			}
+		}
+		if (Inputs.GroupMaxLODSize > 0)
+		{
+			while (LongestAfterDrop() > Inputs.GroupMaxLODSize && LongestAfterDrop() > 1)
+			{
+				++Dropped;
+			}
+		}
+
+		// LOD bias only drops real mips, and never below the group's MinLODSize
+		if (bHasMips)
+		{
+			int32 Bias = FMath::Max(Settings.LODBias + Inputs.GroupLODBias, 0);
+			while (Bias-- > 0 && LongestAfterDrop() > Inputs.GroupMinLODSize && Dropped + 1 < FullMips)
+			{
+				++Dropped;
+			}
+		}
+
+		Result.SizeX = FMath::Max(Inputs.SourceSizeX >> Dropped, 1);
+		Result.SizeY = FMath::Max(Inputs.SourceSizeY >> Dropped, 1);
+		Result.NumMips = bHasMips ? FMath::Max(FullMips - Dropped, 1) : 1;
+
+		// Resident part
+		if (Settings.VirtualTextureStreaming)
+		{
+			// Pages live in the shared virtual texture pool
+			Result.NumResidentMips = 0;
+		}
+		else if (Settings.NeverStream || Settings.bForceMiplevelsToBeResident || !bHasMips || Result.NumMips == 1)
+		{
+			Result.NumResidentMips = Result.NumMips;
+		}
+		else
+		{
+			int32 NonStreamed = FMath::Min(Inputs.MinResidentMips, Result.NumMips);
+			if (Inputs.GroupNumStreamedMips >= 0)
+			{
+				NonStreamed = FMath::Max(Result.NumMips - Inputs.GroupNumStreamedMips, NonStreamed);
+			}
+			Result.NumResidentMips = FMath::Clamp(NonStreamed, 1, Result.NumMips);
+		}
+
+		int32 BlockSize = 1;
+		GetFormatInfo(Settings.CompressionSettings, Inputs.bHasAlpha, Result.BitsPerPixel, BlockSize);
+
+		const int32 FirstResidentMip = Result.NumMips - Result.NumResidentMips;
+		for (int32 Mip = 0; Mip < Result.NumMips; ++Mip)
+		{
+			const int64 MipBytes = GetMipBytes(Result.SizeX >> Mip, Result.SizeY >> Mip, Result.BitsPerPixel, BlockSize);
+			if (Mip >= FirstResidentMip)
+			{
+				Result.ResidentBytes += MipBytes;
+			}
+			else
+			{
+				Result.StreamedBytes += MipBytes;
+			}
+		}
+
+		// Every remaining mip ends up in the cooked package, streamed or not
+		Result.CookedBytes = Result.GetTotalBytes();
+
+		return Result;
+	}
+
+	FTexturePresetSettings GetTextureSettings(const UTexture2D* Texture)
+	{
+		FTexturePresetSettings Settings;
+		if (!Texture)
+		{
+			return Settings;
+		}
+
+		Settings.MipGenSettings = Texture->MipGenSettings;
+		Settings.LODBias = Texture->LODBias;
+		Settings.TextureGroup = Texture->LODGroup;
+		Settings.NumCinematicMipLevels = Texture->NumCinematicMipLevels;
+		Settings.NeverStream = Texture->NeverStream;
+		Settings.bForceMiplevelsToBeResident = Texture->bForceMiplevelsToBeResident;
+		Settings.bUseAlpha = !Texture->CompressionNoAlpha;
+		Settings.CompressionSettings = Texture->CompressionSettings;
+		Settings.MaxTextureSize = Texture->MaxTextureSize;
+		Settings.bSRGB = Texture->SRGB;
+		Settings.VirtualTextureStreaming = Texture->VirtualTextureStreaming;
+		return Settings;
+	}
+
+	FTextureMemoryInputs MakeInputs(const UTexture2D* Texture, const FTexturePresetSettings& Settings)
+	{
+		FTextureMemoryInputs Inputs;
+		Inputs.Settings = TexturePresetLibrary::ResolveForPlatform(Settings, GetActivePlatformName());
+
+		if (!Texture)
+		{
+			return Inputs;
+		}
+
+#if WITH_EDITOR
+		if (Texture->Source.IsValid())
+		{
+			Inputs.SourceSizeX = Texture->Source.GetSizeX();
+			Inputs.SourceSizeY = Texture->Source.GetSizeY();
+		}
+		else
+#endif
+		{
+			Inputs.SourceSizeX = Texture->GetImportedSize().X;
+			Inputs.SourceSizeY = Texture->GetImportedSize().Y;
+		}
+
+		Inputs.bHasAlpha = ResolveHasAlpha(Texture, Settings);
+		FillGroupInputs(Inputs);
+		return Inputs;
+	}
+
+	bool MakeInputs(const FAssetData& Asset, const FTexturePresetSettings* Settings, FTextureMemoryInputs& OutInputs)
+	{
+		// "Dimensions" is the imported (source) size, e.g. "1024x1024"
+		FString Dimensions;
+		FString Width, Height;
+		if (!Asset.GetTagValue(FName(TEXT("Dimensions")), Dimensions) || !Dimensions.Split(TEXT("x"), &Width, &Height))
+		{
+			return false;
+		}
+
+		OutInputs = FTextureMemoryInputs();
+		OutInputs.SourceSizeX = FCString::Atoi(*Width);
+		OutInputs.SourceSizeY = FCString::Atoi(*Height);
+
+		FString HasAlpha;
+		const bool bSourceAlpha = Asset.GetTagValue(FName(TEXT("HasAlphaChannel")), HasAlpha) && HasAlpha.ToBool();
+
+		if (Settings)
+		{
+			OutInputs.Settings = TexturePresetLibrary::ResolveForPlatform(*Settings, GetActivePlatformName());
+		}
+		else
+		{
+			// Whatever the searchable tags tell us; the rest stays at defaults
+			TextureCompressionSettings Compression = TC_Default;
+			if (GetEnumTag(Asset, TEXT("CompressionSettings"), Compression))
+			{
+				OutInputs.Settings.CompressionSettings = Compression;
+			}
+
+			TextureGroup Group = TEXTUREGROUP_World;
+			if (GetEnumTag(Asset, TEXT("LODGroup"), Group))
+			{
+				OutInputs.Settings.TextureGroup = Group;
+			}
+
+			FString Flag;
+			OutInputs.Settings.NeverStream = Asset.GetTagValue(FName(TEXT("NeverStream")), Flag) && Flag.ToBool();
+			OutInputs.Settings.VirtualTextureStreaming = Asset.GetTagValue(FName(TEXT("VirtualTextureStreaming")), Flag) && Flag.ToBool();
+			OutInputs.Settings.bUseAlpha = true;
+		}
+
+		// Alpha analysis needs the texture; assume whatever alpha it has is kept
+		OutInputs.bHasAlpha = bSourceAlpha;
+		FillGroupInputs(OutInputs);
+		return true;
+	}
+
+	FTextureMemoryEstimate EstimateTexture(const UTexture2D* Texture)
+	{
+		if (!Texture)
+		{
+			return FTextureMemoryEstimate();
+		}
+
+		FTextureMemoryInputs Inputs = MakeInputs(Texture, GetTextureSettings(Texture));
+
+		// On the texture itself the flag drops alpha unconditionally
+		Inputs.bHasAlpha &= !Texture->CompressionNoAlpha;
+
+		return Estimate(Inputs);
+	}
+
+	FTextureMemoryEstimate EstimateTexture(const UTexture2D* Texture, const FTexturePresetSettings& Settings)
+	{
+		return Texture ? Estimate(MakeInputs(Texture, Settings)) : FTextureMemoryEstimate();
+	}
+
+	FTextureMemoryEstimate EstimateAsset(const FAssetData& Asset)
+	{
+		if (const UTexture2D* Texture = Cast<UTexture2D>(Asset.FastGetAsset(false)))
+		{
+			return EstimateTexture(Texture);
+		}
+
+		FTextureMemoryInputs Inputs;
+		if (MakeInputs(Asset, nullptr, Inputs))
+		{
+			return Estimate(Inputs);
+		}
+
+		return FTextureMemoryEstimate();
+	}
+
+	FTextureMemoryEstimate EstimatePreset(const UTexturePresetAsset* Preset, const FTexturePresetSettings& InSettings)
+	{
+		FTextureMemoryEstimate Total;
+		if (!Preset)
+		{
+			return Total;
+		}
+
+		// A partial preset leaves the other fields as each texture has them
+		const uint64 FieldMask = TexturePresetLibrary::GetAppliedFieldMask(Preset);
+		const bool bAllFields = FieldMask == TexturePresetLibrary::GetAllFieldsMask();
+
+		FTexturePresetSettings Settings = InSettings;
+		if (!Preset->bApplyAtCook)
+		{
+			TexturePresetLibrary::ClearCookOnlyOverrides(Settings);
+		}
+
+		for (const UTexture2D* Texture : Preset->Files)
+		{
+			if (!Texture)
+			{
+				continue;
+			}
+
+			if (bAllFields)
+			{
+				Total += EstimateTexture(Texture, Settings);
+			}
+			else
+			{
+				FTexturePresetSettings Effective = GetTextureSettings(Texture);
+				TexturePresetLibrary::CopyFields(Settings, Effective, FieldMask);
+				Total += EstimateTexture(Texture, Effective);
+			}
+		}
+
+		return Total;
+	}
+}
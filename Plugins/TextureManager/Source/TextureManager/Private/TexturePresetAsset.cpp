@@ -0,0 +1,120 @@
+#include "TexturePresetAsset.h"
+
+#include "TexturePresetLibrary.h"
+
+#include "Misc/DataDrivenPlatformInfoRegistry.h"
+
+namespace
+{
+	// Shared by all presets so a revision is never reused, not even by a
+	// preset that was deleted and recreated under the same name
+	uint32 GSettingsRevision = 0;
+}
+
+void UTexturePresetAsset::NotifySettingsChanged()
+{
+	SettingsRevision = ++GSettingsRevision;
+}
+
+TArray<FName> UTexturePresetAsset::GetSettingsFieldOptions()
+{
+	TArray<FName> Names;
+	for (TFieldIterator<FProperty> It(FTexturePresetSettings::StaticStruct()); It; ++It)
+	{
+		Names.Add(It->GetFName());
+	}
+	return Names;
+}
+
+TArray<FName> UTexturePresetAsset::GetAppliedFieldOptions()
+{
+	return TexturePresetLibrary::GetApplicableFields();
+}
+
+TArray<FName> UTexturePresetAsset::GetPlatformOptions()
+{
+	TArray<FName> Groups;
+	TArray<FName> Platforms;
+	for (const TPair<FName, FDataDrivenPlatformInfo>& Pair : FDataDrivenPlatformInfoRegistry::GetAllPlatformInfos())
+	{
+		if (!Pair.Value.PlatformGroupName.IsNone())
+		{
+			Groups.AddUnique(Pair.Value.PlatformGroupName);
+		}
+		Platforms.Add(Pair.Key);
+	}
+
+	Groups.Sort(FNameLexicalLess());
+	Platforms.Sort(FNameLexicalLess());
+	Groups.Append(Platforms);
+	return Groups;
+}
+
+#if WITH_EDITOR
+bool UTexturePresetAsset::CanEditChange(const FProperty* InProperty) const
+{
+	if (!Super::CanEditChange(InProperty))
+	{
+		return false;
+	}
+
+	// Textures have no per-platform size, LOD bias or quality, so outside the
+	// cook these overrides would do nothing
+	if (!bApplyAtCook && InProperty && InProperty->GetOwnerStruct() == FTexturePresetPlatformOverride::StaticStruct())
+	{
+		const FName Name = InProperty->GetFName();
+		return Name != GET_MEMBER_NAME_CHECKED(FTexturePresetPlatformOverride, bOverrideMaxTextureSize)
+			&& Name != GET_MEMBER_NAME_CHECKED(FTexturePresetPlatformOverride, MaxTextureSize)
+			&& Name != GET_MEMBER_NAME_CHECKED(FTexturePresetPlatformOverride, bOverrideLODBias)
+			&& Name != GET_MEMBER_NAME_CHECKED(FTexturePresetPlatformOverride, LODBias)
+			&& Name != GET_MEMBER_NAME_CHECKED(FTexturePresetPlatformOverride, bOverrideCompressionQuality)
+			&& Name != GET_MEMBER_NAME_CHECKED(FTexturePresetPlatformOverride, CompressionQuality);
+	}
+	return true;
+}
+
+void UTexturePresetAsset::PostEditChangeChainProperty(FPropertyChangedChainEvent& Event)
+{
+	const FEditPropertyChain::TDoubleLinkedListNode* Head = Event.PropertyChain.GetHead();
+	const FName MemberName = Head ? Head->GetValue()->GetFName() : NAME_None;
+	const bool bParentChanged = MemberName == GET_MEMBER_NAME_CHECKED(UTexturePresetAsset, ParentPreset);
+
+	if (bParentChanged && TexturePresetLibrary::HasInheritanceCycle(this))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: %s would inherit from itself, parent cleared"),
+			*GetName(), *GetNameSafe(ParentPreset));
+		ParentPreset = nullptr;
+	}
+
+	// Editing a field of a derived preset overrides it
+	if (ParentPreset && MemberName == GET_MEMBER_NAME_CHECKED(UTexturePresetAsset, Settings)
+		&& Head->GetNextNode())
+	{
+		OverriddenFields.AddUnique(Head->GetNextNode()->GetValue()->GetFName());
+	}
+
+	if (MemberName == GET_MEMBER_NAME_CHECKED(UTexturePresetAsset, bApplyAtCook) && !bApplyAtCook
+		&& TexturePresetLibrary::HasCookOnlyOverrides(TexturePresetLibrary::ResolveSettings(this)))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: per-platform size, LOD bias and quality overrides are ignored without Apply At Cook"),
+			*GetName());
+	}
+
+	NotifySettingsChanged();
+
+	// Show the inherited values; the resolve result doesn't change by this
+	if (bParentChanged && ParentPreset)
+	{
+		Settings = TexturePresetLibrary::ResolveSettings(this);
+	}
+
+	Super::PostEditChangeChainProperty(Event);
+}
+
+void UTexturePresetAsset::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	NotifySettingsChanged();
+}
+#endif
@@ -0,0 +1,564 @@
+#include "TexturePresetClustering.h"
+
+#include "TexturePresetAsset.h"
+#include "TexturePresetLibrary.h"
+#include "TexturePresetUserData.h"
+#include "TextureBulkJournal.h"
+#include "TextureRebuildScheduler.h"
+
+#include "Engine/Texture2D.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Hash/CityHash.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopedSlowTask.h"
+#include "ObjectTools.h"
+#include "ScopedTransaction.h"
+#include "UObject/Package.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+	struct FHashedProperty
+	{
+		const FProperty* Property = nullptr;
+		bool bFloat = false;
+		bool bSizeOverride = false;
+
+		// Arrays (PlatformOverrides) are hashed by their text form
+		bool bExportText = false;
+	};
+
+	// Every field of FTexturePresetSettings; resolved once on the game thread
+	const TArray<FHashedProperty>& GetHashedProperties()
+	{
+		static const TArray<FHashedProperty> Properties = []()
+			{
+				TArray<FHashedProperty> Result;
+				for (TFieldIterator<FProperty> It(FTexturePresetSettings::StaticStruct()); It; ++It)
+				{
+					FHashedProperty& Entry = Result.AddDefaulted_GetRef();
+					Entry.Property = *It;
+					Entry.bFloat = It->IsA<FFloatProperty>();
+					Entry.bExportText = It->IsA<FArrayProperty>();
+					Entry.bSizeOverride = It->GetFName() == GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, LODBias)
+						|| It->GetFName() == GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, MaxTextureSize)
+						|| It->GetFName() == GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, PlatformOverrides);
+				}
+				return Result;
+			}();
+		return Properties;
+	}
+
+	struct FTagBinding
+	{
+		FName Tag;
+		const FProperty* Property = nullptr;
+	};
+
+	// Registry tags of UTexture2D and the preset field each one maps to, with the
+	// same meaning CaptureSettings gives them
+	const TArray<FTagBinding>& GetTagBindings()
+	{
+		static const TArray<FTagBinding> Bindings = []()
+			{
+				const TPair<const TCHAR*, FName> Table[] =
+				{
+					{ TEXT("LODGroup"), GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, TextureGroup) },
+					{ TEXT("CompressionSettings"), GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, CompressionSettings) },
+					{ TEXT("SRGB"), GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, bSRGB) },
+					{ TEXT("Filter"), GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, Filter) },
+					{ TEXT("AddressX"), GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, XTilingMethod) },
+					{ TEXT("AddressY"), GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, YTilingMethod) },
+					{ TEXT("MipGenSettings"), GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, MipGenSettings) },
+					{ TEXT("LODBias"), GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, LODBias) },
+					{ TEXT("MaxTextureSize"), GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, MaxTextureSize) },
+					{ TEXT("NeverStream"), GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, NeverStream) },
+					{ TEXT("VirtualTextureStreaming"), GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, VirtualTextureStreaming) },
+
+					// No bUseAlpha: HasAlphaChannel reflects the built data, and
+					// CompressionNoAlpha has no tag. The default (on) is what a
+					// texture that was never stripped captures.
+				};
+
+				TArray<FTagBinding> Result;
+				for (const TPair<const TCHAR*, FName>& Entry : Table)
+				{
+					if (const FProperty* Property = FTexturePresetSettings::StaticStruct()->FindPropertyByName(Entry.Value))
+					{
+						Result.Add({ FName(Entry.Key), Property });
+					}
+				}
+				return Result;
+			}();
+		return Bindings;
+	}
+
+	FString MakeProposedName(const FTexturePresetSettings& Settings)
+	{
+		FString Compression = StaticEnum<TextureCompressionSettings>()->GetNameStringByValue(Settings.CompressionSettings);
+		Compression.RemoveFromStart(TEXT("TC_"));
+
+		FString Group = StaticEnum<TextureGroup>()->GetNameStringByValue(Settings.TextureGroup);
+		Group.RemoveFromStart(TEXT("TEXTUREGROUP_"));
+
+		return FString::Printf(TEXT("TP_%s_%s_%s"), *Group, *Compression, Settings.bSRGB ? TEXT("sRGB") : TEXT("Linear"));
+	}
+
+	// Package names under PackagePath that are neither on disk nor in memory
+	FString MakeUniqueAssetName(const FString& PackagePath, const FString& BaseName)
+	{
+		FString Name = BaseName;
+		for (int32 Suffix = 2; ; ++Suffix)
+		{
+			const FString PackageName = PackagePath / Name;
+			if (!FindPackage(nullptr, *PackageName) && !FPackageName::DoesPackageExist(PackageName))
+			{
+				return Name;
+			}
+			Name = FString::Printf(TEXT("%s_%d"), *BaseName, Suffix);
+		}
+	}
+
+	// Everything besides the settings values that decides what a preset does
+	// to its textures: the parent, which fields it sets and applies, when it
+	// applies them and its scalability tiers
+	FString GetPresetSetupKey(const UTexturePresetAsset* Preset)
+	{
+		TStringBuilder<512> Key;
+		Key << (Preset->ParentPreset ? Preset->ParentPreset->GetPathName() : FString());
+		Key << TEXT('|') << (Preset->bApplyAtCook ? TEXT("Cook") : TEXT("Save"));
+
+		for (const TArray<FName>* Fields : { &Preset->OverriddenFields, &Preset->AppliedFields })
+		{
+			TArray<FName> Sorted = *Fields;
+			Sorted.Sort(FNameLexicalLess());
+			Key << TEXT('|');
+			for (const FName Field : Sorted)
+			{
+				Key << Field << TEXT(',');
+			}
+		}
+
+		static const FProperty* TiersProperty = UTexturePresetAsset::StaticClass()->FindPropertyByName(
+			GET_MEMBER_NAME_CHECKED(UTexturePresetAsset, ScalabilityTiers));
+		FString Tiers;
+		TiersProperty->ExportTextItem_Direct(Tiers, &Preset->ScalabilityTiers, nullptr, nullptr, PPF_None);
+		Key << TEXT('|') << Tiers;
+
+		return FString(Key.ToView());
+	}
+}
+
+namespace TexturePresetClustering
+{
+	FTexturePresetSettings CaptureFromTags(const FAssetData& Asset)
+	{
+		FTexturePresetSettings Settings;
+
+		FString Value;
+		for (const FTagBinding& Binding : GetTagBindings())
+		{
+			if (Asset.GetTagValue(Binding.Tag, Value))
+			{
+				Binding.Property->ImportText_Direct(*Value, Binding.Property->ContainerPtrToValuePtr<void>(&Settings), nullptr, PPF_None);
+			}
+		}
+
+		return Settings;
+	}
+
+	uint64 HashSettings(const FTexturePresetSettings& Settings, const FTextureClusteringOptions& Options, bool bQuantize)
+	{
+		TArray<uint8, TInlineAllocator<256>> Key;
+
+		const float Tolerance = FMath::Max(Options.FloatTolerance, UE_KINDA_SMALL_NUMBER);
+
+		for (const FHashedProperty& Entry : GetHashedProperties())
+		{
+			if (bQuantize && Options.bIgnoreSizeOverrides && Entry.bSizeOverride)
+			{
+				continue;
+			}
+
+			const void* Value = Entry.Property->ContainerPtrToValuePtr<void>(&Settings);
+
+			if (Entry.bExportText)
+			{
+				FString Text;
+				Entry.Property->ExportTextItem_Direct(Text, Value, nullptr, nullptr, PPF_None);
+				Key.Append(reinterpret_cast<const uint8*>(*Text), Text.Len() * sizeof(TCHAR));
+			}
+			else if (Entry.bFloat && bQuantize)
+			{
+				const int32 Quantized = FMath::RoundToInt(*static_cast<const float*>(Value) / Tolerance);
+				Key.Append(reinterpret_cast<const uint8*>(&Quantized), sizeof(Quantized));
+			}
+			else
+			{
+				// Every other field is plain data (enums, bools, ints, floats, FColor)
+				Key.Append(static_cast<const uint8*>(Value), Entry.Property->GetSize());
+			}
+		}
+
+		return CityHash64(reinterpret_cast<const char*>(Key.GetData()), Key.Num());
+	}
+
+	FTextureClusteringResult FindClusters(
+		const TArray<FAssetData>& Textures,
+		const TArray<TWeakObjectPtr<UTexturePresetAsset>>& ExistingPresets,
+		const FTextureClusteringOptions& Options)
+	{
+		check(IsInGameThread());
+
+		const double StartSeconds = FPlatformTime::Seconds();
+		FTextureClusteringResult Result;
+
+		// Resolve the reflection tables before going wide
+		GetHashedProperties();
+		GetTagBindings();
+
+		TSet<FSoftObjectPath> Assigned;
+		TMap<uint64, UTexturePresetAsset*> PresetsByHash;
+		for (const TWeakObjectPtr<UTexturePresetAsset>& Item : ExistingPresets)
+		{
+			UTexturePresetAsset* Preset = Item.Get();
+			if (!Preset)
+			{
+				continue;
+			}
+
+			for (const UTexture2D* Texture : Preset->Files)
+			{
+				if (Texture)
+				{
+					Assigned.Add(FSoftObjectPath(Texture));
+				}
+			}
+
+			PresetsByHash.FindOrAdd(HashSettings(TexturePresetLibrary::ResolveSettings(Preset), Options, true), Preset);
+		}
+
+		TArray<const FAssetData*> Candidates;
+		Candidates.Reserve(Textures.Num());
+		for (const FAssetData& Asset : Textures)
+		{
+			if (!Options.bIncludeAssigned && Assigned.Contains(Asset.GetSoftObjectPath()))
+			{
+				continue;
+			}
+			Candidates.Add(&Asset);
+		}
+
+		const int32 Num = Candidates.Num();
+		Result.NumTextures = Num;
+
+		TArray<FTexturePresetSettings> Settings;
+		TArray<uint64> NearHashes;
+		TArray<uint64> ExactHashes;
+		Settings.SetNum(Num);
+		NearHashes.SetNumUninitialized(Num);
+		ExactHashes.SetNumUninitialized(Num);
+
+		// Loaded textures are captured exactly, here: UObjects are not for
+		// worker threads. Everything else is read from its tags below.
+		TBitArray<> Captured(false, Num);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			if (const UTexture2D* Texture = Cast<UTexture2D>(Candidates[Index]->FastGetAsset(false)))
+			{
+				Settings[Index] = TexturePresetLibrary::CaptureSettings(Texture);
+				Captured[Index] = true;
+			}
+		}
+
+		ParallelFor(Num, [&](int32 Index)
+			{
+				if (!Captured[Index])
+				{
+					Settings[Index] = CaptureFromTags(*Candidates[Index]);
+				}
+
+				NearHashes[Index] = HashSettings(Settings[Index], Options, true);
+				ExactHashes[Index] = HashSettings(Settings[Index], Options, false);
+			});
+
+		TMap<uint64, TArray<int32>> Groups;
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Groups.FindOrAdd(NearHashes[Index]).Add(Index);
+		}
+		Result.NumGroups = Groups.Num();
+
+		for (const TPair<uint64, TArray<int32>>& Group : Groups)
+		{
+			const TArray<int32>& Members = Group.Value;
+			if (Members.Num() < FMath::Max(Options.MinClusterSize, 1))
+			{
+				continue;
+			}
+
+			// The most common exact settings become the preset
+			TMap<uint64, int32> Counts;
+			int32 Representative = Members[0];
+			int32 BestCount = 0;
+			for (int32 Member : Members)
+			{
+				const int32 Count = ++Counts.FindOrAdd(ExactHashes[Member]);
+				if (Count > BestCount)
+				{
+					BestCount = Count;
+					Representative = Member;
+				}
+			}
+
+			FTextureSettingsCluster& Cluster = Result.Clusters.AddDefaulted_GetRef();
+			Cluster.Settings = Settings[Representative];
+			Cluster.NearHash = Group.Key;
+			Cluster.ExactHash = ExactHashes[Representative];
+			Cluster.NumExact = BestCount;
+			Cluster.ExistingPreset = PresetsByHash.FindRef(Group.Key);
+
+			Cluster.Assets.Reserve(Members.Num());
+			for (int32 Member : Members)
+			{
+				Cluster.Assets.Add(*Candidates[Member]);
+			}
+
+			Result.NumClustered += Members.Num();
+		}
+
+		Result.Clusters.Sort([](const FTextureSettingsCluster& A, const FTextureSettingsCluster& B)
+			{
+				return A.Assets.Num() > B.Assets.Num();
+			});
+
+		// Readable names, unique among the proposals
+		TMap<FString, int32> NameCounts;
+		for (FTextureSettingsCluster& Cluster : Result.Clusters)
+		{
+			if (UTexturePresetAsset* Preset = Cluster.ExistingPreset.Get())
+			{
+				Cluster.ProposedName = !Preset->PresetName.IsNone() ? Preset->PresetName : Preset->GetFName();
+				continue;
+			}
+
+			const FString BaseName = MakeProposedName(Cluster.Settings);
+			const int32 Count = ++NameCounts.FindOrAdd(BaseName);
+			Cluster.ProposedName = FName(Count == 1 ? BaseName : FString::Printf(TEXT("%s_%d"), *BaseName, Count));
+		}
+
+		Result.Seconds = FPlatformTime::Seconds() - StartSeconds;
+		return Result;
+	}
+
+	int32 AssignClusters(
+		const TArray<FTextureSettingsCluster>& Clusters,
+		const FString& PackagePath,
+		const FTextureClusteringOptions& Options,
+		int32& OutSkipped)
+	{
+		check(IsInGameThread());
+
+		OutSkipped = 0;
+		int32 NumAssigned = 0;
+
+		int32 NumTextures = 0;
+		for (const FTextureSettingsCluster& Cluster : Clusters)
+		{
+			NumTextures += Cluster.Assets.Num();
+		}
+
+		FScopedSlowTask SlowTask(float(NumTextures), NSLOCTEXT("TextureManager", "AssigningClusters", "Assigning presets..."));
+		SlowTask.MakeDialog(true);
+
+		const FGuid JournalBatch = TextureBulkJournal::BeginBatch(TEXT("Assign clusters"));
+
+		for (const FTextureSettingsCluster& Cluster : Clusters)
+		{
+			UTexturePresetAsset* Preset = Cluster.ExistingPreset.Get();
+			if (!Preset)
+			{
+				const FString Name = MakeUniqueAssetName(PackagePath, Cluster.ProposedName.ToString());
+				Preset = TexturePresetLibrary::CreatePresetAsset(PackagePath, FName(*Name));
+				if (!Preset)
+				{
+					OutSkipped += Cluster.Assets.Num();
+					continue;
+				}
+				Preset->Settings = Cluster.Settings;
+				Preset->NotifySettingsChanged();
+			}
+
+			for (const FAssetData& Asset : Cluster.Assets)
+			{
+				if (SlowTask.ShouldCancel())
+				{
+					return NumAssigned;
+				}
+				SlowTask.EnterProgressFrame(1.f);
+
+				UTexture2D* Texture = Cast<UTexture2D>(Asset.GetAsset());
+				if (!Texture)
+				{
+					++OutSkipped;
+					continue;
+				}
+
+				// The tags only show some settings; check the loaded texture agrees
+				const FTexturePresetSettings Captured = TexturePresetLibrary::CaptureSettings(Texture);
+				if (HashSettings(Captured, Options, true) != Cluster.NearHash)
+				{
+					++OutSkipped;
+					continue;
+				}
+
+				// Identical settings are left clean by the scheduler
+				Texture->Modify();
+				TexturePresetLibrary::AssignPresetToTexture(Preset, Texture);
+				TextureRebuildScheduler::Enqueue(Preset, Texture, JournalBatch);
+
+				++NumAssigned;
+			}
+		}
+
+		return NumAssigned;
+	}
+
+	TArray<FPresetMergeGroup> FindDuplicatePresets(const TArray<TWeakObjectPtr<UTexturePresetAsset>>& Presets)
+	{
+		const FTextureClusteringOptions Exact;
+
+		// Derived presets only match siblings that override the same fields
+		// with the same values; anything else parts ways when the parent changes
+		TMap<TPair<FString, uint64>, TArray<UTexturePresetAsset*>> ByHash;
+		for (const TWeakObjectPtr<UTexturePresetAsset>& Item : Presets)
+		{
+			UTexturePresetAsset* Preset = Item.Get();
+			if (Preset)
+			{
+				const uint64 SettingsHash = HashSettings(TexturePresetLibrary::ResolveSettings(Preset), Exact, false);
+				ByHash.FindOrAdd({ GetPresetSetupKey(Preset), SettingsHash }).AddUnique(Preset);
+			}
+		}
+
+		TArray<FPresetMergeGroup> Groups;
+		for (TPair<TPair<FString, uint64>, TArray<UTexturePresetAsset*>>& Pair : ByHash)
+		{
+			TArray<UTexturePresetAsset*>& Members = Pair.Value;
+			if (Members.Num() < 2)
+			{
+				continue;
+			}
+
+			Members.Sort([](const UTexturePresetAsset& A, const UTexturePresetAsset& B)
+				{
+					if (A.Files.Num() != B.Files.Num())
+					{
+						return A.Files.Num() > B.Files.Num();
+					}
+					return A.GetName().Len() < B.GetName().Len();
+				});
+
+			FPresetMergeGroup& Group = Groups.AddDefaulted_GetRef();
+			for (UTexturePresetAsset* Preset : Members)
+			{
+				Group.Presets.Add(Preset);
+			}
+		}
+
+		return Groups;
+	}
+
+	int32 MergePresets(const TArray<FPresetMergeGroup>& Groups)
+	{
+		check(IsInGameThread());
+
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+		TArray<TPair<UTexturePresetAsset*, TArray<UObject*>>> ToConsolidate;
+
+		{
+			FScopedTransaction Transaction(NSLOCTEXT("TextureManager", "MergePresets", "Merge Texture Presets"));
+
+			for (const FPresetMergeGroup& Group : Groups)
+			{
+				UTexturePresetAsset* Keeper = Group.Presets.Num() > 0 ? Group.Presets[0].Get() : nullptr;
+				if (!Keeper)
+				{
+					continue;
+				}
+
+				Keeper->Modify();
+				TArray<UObject*> Duplicates;
+
+				for (int32 Index = 1; Index < Group.Presets.Num(); ++Index)
+				{
+					UTexturePresetAsset* Duplicate = Group.Presets[Index].Get();
+					if (!Duplicate || Duplicate == Keeper)
+					{
+						continue;
+					}
+
+					// Files, plus any texture that links to the duplicate without being listed
+					TArray<UTexture2D*> Linked = Duplicate->Files;
+
+					TArray<FName> Referencers;
+					AssetRegistry.GetReferencers(Duplicate->GetOutermost()->GetFName(), Referencers);
+					for (FName PackageName : Referencers)
+					{
+						TArray<FAssetData> Assets;
+						AssetRegistry.GetAssetsByPackageName(PackageName, Assets);
+						for (const FAssetData& Asset : Assets)
+						{
+							if (Asset.IsInstanceOf(UTexture2D::StaticClass()))
+							{
+								Linked.AddUnique(Cast<UTexture2D>(Asset.GetAsset()));
+							}
+						}
+					}
+
+					for (UTexture2D* Texture : Linked)
+					{
+						UTexturePresetUserData* UserData = Texture
+							? Cast<UTexturePresetUserData>(Texture->GetAssetUserDataOfClass(UTexturePresetUserData::StaticClass()))
+							: nullptr;
+
+						if (!UserData || UserData->AssignedPreset != Duplicate)
+						{
+							continue;
+						}
+
+						UserData->Modify();
+						UserData->AssignedPreset = Keeper;
+						Keeper->Files.AddUnique(Texture);
+						Texture->MarkPackageDirty();
+					}
+
+					Duplicate->Modify();
+					Duplicate->Files.Reset();
+					Duplicate->MarkPackageDirty();
+					Duplicates.Add(Duplicate);
+				}
+
+				if (Duplicates.Num() > 0)
+				{
+					Keeper->MarkPackageDirty();
+					ToConsolidate.Emplace(Keeper, MoveTemp(Duplicates));
+				}
+			}
+		}
+
+		// Consolidation clears the undo buffer, so it runs after the links are
+		// committed; it leaves redirectors for anything still pointing at the
+		// old packages
+		int32 NumMerged = 0;
+		for (const TPair<UTexturePresetAsset*, TArray<UObject*>>& Entry : ToConsolidate)
+		{
+			const ObjectTools::FConsolidationResults Results = ObjectTools::ConsolidateObjects(Entry.Key, Entry.Value, false);
+			NumMerged += Entry.Value.Num() - Results.FailedConsolidationObjs.Num() - Results.InvalidConsolidationObjs.Num();
+		}
+
+		return NumMerged;
+	}
+}
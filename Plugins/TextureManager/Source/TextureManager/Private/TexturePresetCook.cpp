@@ -0,0 +1,148 @@
+#include "TexturePresetCook.h"
+
+#include "TextureFolderPresets.h"
+#include "TexturePresetAsset.h"
+#include "TexturePresetLibrary.h"
+
+#include "Engine/Texture2D.h"
+#include "Interfaces/ITargetPlatform.h"
+#include "Interfaces/ITargetPlatformManagerModule.h"
+#include "Misc/SecureHash.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	FDelegateHandle GAssetLoadedHandle;
+
+	// CompressionCacheId of each texture before a preset was first folded into
+	// it, so applying again (another platform, the DDC warm-up) keys the same
+	TMap<TWeakObjectPtr<UTexture2D>, FGuid> GOriginalCacheIds;
+
+	// Presets already warned about in this cook
+	TSet<FObjectKey> GWarnedPresets;
+
+	// With one target platform its overrides can be resolved; a multi-platform
+	// cook keeps them as per-platform downscale only
+	FName GetCookPlatformName()
+	{
+		const TArray<ITargetPlatform*>& Platforms = GetTargetPlatformManagerRef().GetActiveTargetPlatforms();
+		return Platforms.Num() == 1 ? FName(*Platforms[0]->IniPlatformName()) : NAME_None;
+	}
+
+	FTexturePresetSettings GetCookSettings(const UTexturePresetAsset* Preset, FName PlatformName)
+	{
+		const FTexturePresetSettings Settings = TexturePresetLibrary::ResolveSettings(Preset);
+		return PlatformName.IsNone() ? Settings : TexturePresetLibrary::ResolveForPlatform(Settings, PlatformName);
+	}
+
+	// All platforms build from the one texture object, and only downscale has a
+	// per-platform value on it; the other overrides need a cook per platform
+	void WarnDroppedOverrides(const UTexturePresetAsset* Preset, const FTexturePresetSettings& Settings)
+	{
+		bool bAlreadyWarned = false;
+		GWarnedPresets.Add(FObjectKey(Preset), &bAlreadyWarned);
+		if (bAlreadyWarned)
+		{
+			return;
+		}
+
+		TArray<FString> Dropped;
+		for (const FTexturePresetPlatformOverride& Override : Settings.PlatformOverrides)
+		{
+			if (Override.bOverrideMaxTextureSize || Override.bOverrideLODBias || Override.bOverrideCompressionQuality)
+			{
+				Dropped.AddUnique(Override.Platform.ToString());
+			}
+		}
+
+		if (!Dropped.IsEmpty())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Cook: preset %s overrides size, LOD bias or quality for %s; a multi-platform cook ignores them (only downscale is per platform). Cook those platforms on their own to get them."),
+				*Preset->GetName(), *FString::Join(Dropped, TEXT(", ")));
+		}
+	}
+
+	void OnAssetLoaded(UObject* Object)
+	{
+		if (UTexture2D* Texture = Cast<UTexture2D>(Object))
+		{
+			TexturePresetCook::ApplyForCook(Texture, GetCookPlatformName());
+		}
+	}
+}
+
+namespace TexturePresetCook
+{
+	void Register()
+	{
+#if WITH_EDITOR
+		if (IsRunningCookCommandlet() && !GAssetLoadedHandle.IsValid())
+		{
+			GAssetLoadedHandle = FCoreUObjectDelegates::OnAssetLoaded.AddStatic(&OnAssetLoaded);
+		}
+#endif
+	}
+
+	void Unregister()
+	{
+#if WITH_EDITOR
+		FCoreUObjectDelegates::OnAssetLoaded.Remove(GAssetLoadedHandle);
+		GAssetLoadedHandle.Reset();
+		GOriginalCacheIds.Reset();
+		GWarnedPresets.Reset();
+#endif
+	}
+
+	FGuid GetPresetHash(const UTexturePresetAsset* Preset, FName PlatformName)
+	{
+		const FTexturePresetSettings Settings = GetCookSettings(Preset, PlatformName);
+
+		FString Text;
+		FTexturePresetSettings::StaticStruct()->ExportText(Text, &Settings, nullptr, nullptr, PPF_None, nullptr);
+		Text += FString::Printf(TEXT("|%llx"), TexturePresetLibrary::GetAppliedFieldMask(Preset));
+
+		FMD5 Md5;
+		Md5.Update(reinterpret_cast<const uint8*>(*Text), Text.Len() * sizeof(TCHAR));
+		uint32 Digest[4];
+		Md5.Final(reinterpret_cast<uint8*>(Digest));
+		return FGuid(Digest[0], Digest[1], Digest[2], Digest[3]);
+	}
+
+	bool ApplyForCook(UTexture2D* Texture, FName PlatformName)
+	{
+#if WITH_EDITORONLY_DATA
+		const UTexturePresetAsset* Preset = TextureFolderPresets::GetEffectivePreset(Texture);
+		if (!Preset || !Preset->bApplyAtCook)
+		{
+			return false;
+		}
+
+		const FTexturePresetSettings Settings = GetCookSettings(Preset, PlatformName);
+		if (PlatformName.IsNone() && IsRunningCookCommandlet())
+		{
+			WarnDroppedOverrides(Preset, Settings);
+		}
+
+		const bool bChanged = TexturePresetLibrary::ApplySettingsToTexture(
+			Settings, TexturePresetLibrary::GetAppliedFieldMask(Preset), Texture);
+
+		// Part of the texture's DDC key, so a preset edit never hits data
+		// built with the old settings, and the source settings' data is not reused
+		const FGuid PresetHash = GetPresetHash(Preset, PlatformName);
+		const FGuid& OriginalId = GOriginalCacheIds.FindOrAdd(Texture, Texture->CompressionCacheId);
+		Texture->CompressionCacheId = OriginalId.IsValid()
+			? FGuid::Combine(OriginalId, PresetHash)
+			: PresetHash;
+
+		// Drop anything built from the source settings while loading
+		Texture->ClearAllCachedCookedPlatformData();
+
+		UE_LOG(LogTemp, Verbose, TEXT("Cook: %s gets preset %s%s"),
+			*Texture->GetPathName(), *Preset->GetName(), bChanged ? TEXT("") : TEXT(" (already matching)"));
+		return bChanged;
+#else
+		return false;
+#endif
+	}
+}
@@ -1,8 +1,17 @@
 #include "TexturePresetLibrary.h"
 
+#include "TextureAnalysisLibrary.h"
 #include "TexturePresetAsset.h"
 #include "TexturePresetUserData.h"
+#include "TextureBulkJournal.h"
+#include "TextureManagerMetrics.h"
+#include "TextureManagerStats.h"
+#include "TextureRebuildScheduler.h"
 #include "Engine/Texture.h"
+#include "Engine/Texture2D.h"
+#include "Misc/DataDrivenPlatformInfoRegistry.h"
+#include "Misc/ScopedSlowTask.h"
+#include "UObject/ObjectKey.h"
 
 #if WITH_EDITOR
 #include "AssetRegistry/AssetRegistryModule.h"
@@ -11,118 +20,569 @@
 #include "FileHelpers.h" 
 #endif
 
+#define LOCTEXT_NAMESPACE "TexturePresetLibrary"
+
+namespace
+{
+	// Deeper chains are treated as broken
+	constexpr int32 MaxInheritanceDepth = 16;
+
+	using FInheritanceChain = TArray<const UTexturePresetAsset*, TInlineAllocator<4>>;
+
+	struct FResolvedPreset
+	{
+		FTexturePresetSettings Settings;
+
+		// The preset and its ancestors (nearest first) with the revision each
+		// had when resolved; any mismatch means an ancestor was edited
+		TArray<TPair<FObjectKey, uint32>, TInlineAllocator<4>> Chain;
+	};
+
+	// Game thread only
+	TMap<FObjectKey, FResolvedPreset> GResolvedPresets;
+
+	// Preset first, root last; stops before a preset that is already in the chain
+	void GetInheritanceChain(const UTexturePresetAsset* Preset, FInheritanceChain& OutChain)
+	{
+		for (const UTexturePresetAsset* Node = Preset;
+			Node && OutChain.Num() < MaxInheritanceDepth && !OutChain.Contains(Node);
+			Node = Node->ParentPreset.Get())
+		{
+			OutChain.Add(Node);
+		}
+	}
+
+	bool IsCacheValid(const FResolvedPreset& Cached, const FInheritanceChain& Chain)
+	{
+		if (Cached.Chain.Num() != Chain.Num())
+		{
+			return false;
+		}
+		for (int32 Index = 0; Index < Chain.Num(); ++Index)
+		{
+			if (Cached.Chain[Index].Key != FObjectKey(Chain[Index])
+				|| Cached.Chain[Index].Value != Chain[Index]->GetSettingsRevision())
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Downscale per platform as the texture should carry it
+	TMap<FName, float> GetPerPlatformDownscale(const FTexturePresetSettings& Settings)
+	{
+		TMap<FName, float> PerPlatform;
+		for (const FTexturePresetPlatformOverride& Override : Settings.PlatformOverrides)
+		{
+			if (Override.bOverrideDownscaleFactor && !Override.Platform.IsNone())
+			{
+				PerPlatform.Add(Override.Platform, Override.DownscaleFactor);
+			}
+		}
+		return PerPlatform;
+	}
+
+	// A preset without alpha only strips it where the texture does not use
+	// it. Analyzed once per source id; off the game thread only a cached
+	// result counts, so an unknown texture keeps its alpha.
+	bool WantsNoAlpha(const FTexturePresetSettings& In, const UTexture2D& Texture)
+	{
+		if (In.bUseAlpha)
+		{
+			return false;
+		}
+
+		FTextureAlphaInfo Alpha = TextureAnalysisLibrary::FindAlphaUsage(&Texture);
+		if (Alpha.Usage == ETextureAlphaUsage::Unknown && IsInGameThread())
+		{
+			Alpha = TextureAnalysisLibrary::AnalyzeAlphaUsage(const_cast<UTexture2D*>(&Texture));
+		}
+		return Alpha.IsRemovable();
+	}
+
+	// How one preset field maps onto the texture. Apply, capture and diff all
+	// go through this table; a field's bit in a mask is its index here.
+	struct FPresetFieldBinding
+	{
+		FName Field;
+		bool (*Matches)(const FTexturePresetSettings& In, const UTexture2D& Texture);
+		void (*Apply)(const FTexturePresetSettings& In, UTexture2D& Texture);
+		void (*Capture)(const UTexture2D& Texture, FTexturePresetSettings& Out);
+		void (*Copy)(const FTexturePresetSettings& From, FTexturePresetSettings& To);
+	};
+
+#define TEXTURE_PRESET_FIELD(SettingsField, TextureField) \
+	{ \
+		GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, SettingsField), \
+		[](const FTexturePresetSettings& In, const UTexture2D& Texture) { return Texture.TextureField == static_cast<decltype(Texture.TextureField)>(In.SettingsField); }, \
+		[](const FTexturePresetSettings& In, UTexture2D& Texture) { Texture.TextureField = In.SettingsField; }, \
+		[](const UTexture2D& Texture, FTexturePresetSettings& Out) { Out.SettingsField = Texture.TextureField; }, \
+		[](const FTexturePresetSettings& From, FTexturePresetSettings& To) { To.SettingsField = From.SettingsField; } \
+	}
+
+	TConstArrayView<FPresetFieldBinding> GetFieldBindings()
+	{
+		// Not bound yet: ZTilingMethod
+		static const FPresetFieldBinding Bindings[] =
+		{
+			// --- Core ---
+			TEXTURE_PRESET_FIELD(TextureGroup, LODGroup),
+			TEXTURE_PRESET_FIELD(LODBias, LODBias),
+			TEXTURE_PRESET_FIELD(CompressionSettings, CompressionSettings),
+			TEXTURE_PRESET_FIELD(bSRGB, SRGB),
+			TEXTURE_PRESET_FIELD(bFlipGreenChannel, bFlipGreenChannel),
+
+			// bUseAlpha is the inverse of CompressionNoAlpha, except on textures
+			// whose alpha is used: those keep it whatever the preset says. Checked
+			// here so every path (editor, folder presets, cook) gets the same answer.
+			{
+				GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, bUseAlpha),
+				[](const FTexturePresetSettings& In, const UTexture2D& Texture) { return bool(Texture.CompressionNoAlpha) == WantsNoAlpha(In, Texture); },
+				[](const FTexturePresetSettings& In, UTexture2D& Texture) { Texture.CompressionNoAlpha = WantsNoAlpha(In, Texture); },
+				[](const UTexture2D& Texture, FTexturePresetSettings& Out) { Out.bUseAlpha = !Texture.CompressionNoAlpha; },
+				[](const FTexturePresetSettings& From, FTexturePresetSettings& To) { To.bUseAlpha = From.bUseAlpha; }
+			},
+
+			// --- Filter / addressing ---
+			TEXTURE_PRESET_FIELD(Filter, Filter),
+			TEXTURE_PRESET_FIELD(XTilingMethod, AddressX),
+			TEXTURE_PRESET_FIELD(YTilingMethod, AddressY),
+
+			// --- Mips / size ---
+			TEXTURE_PRESET_FIELD(MipGenSettings, MipGenSettings),
+			TEXTURE_PRESET_FIELD(MaxTextureSize, MaxTextureSize),
+			TEXTURE_PRESET_FIELD(DownscaleFactor, Downscale.Default),
+			TEXTURE_PRESET_FIELD(NumCinematicMipLevels, NumCinematicMipLevels),
+			TEXTURE_PRESET_FIELD(bPreserveBorder, bPreserveBorder),
+
+			// --- Streaming / residency ---
+			TEXTURE_PRESET_FIELD(NeverStream, NeverStream),
+			TEXTURE_PRESET_FIELD(bForceMiplevelsToBeResident, bForceMiplevelsToBeResident),
+
+			// --- Adjustments ---
+			TEXTURE_PRESET_FIELD(Brightness, AdjustBrightness),
+			TEXTURE_PRESET_FIELD(BrightnessCurve, AdjustBrightnessCurve),
+			TEXTURE_PRESET_FIELD(Vibrance, AdjustVibrance),
+			TEXTURE_PRESET_FIELD(Saturation, AdjustSaturation),
+			TEXTURE_PRESET_FIELD(RGBCurve, AdjustRGBCurve),
+			TEXTURE_PRESET_FIELD(Hue, AdjustHue),
+			TEXTURE_PRESET_FIELD(MinAlpha, AdjustMinAlpha),
+			TEXTURE_PRESET_FIELD(MaxAlpha, AdjustMaxAlpha),
+			TEXTURE_PRESET_FIELD(ChromaKeyTexture, bChromaKeyTexture),
+			TEXTURE_PRESET_FIELD(ChromaKeyThreshold, ChromaKeyThreshold),
+			TEXTURE_PRESET_FIELD(ChromaKeyColor, ChromaKeyColor),
+
+			// --- Compression quality ---
+			{
+				GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, CompressionQuality),
+				[](const FTexturePresetSettings& In, const UTexture2D& Texture) { return int32(Texture.CompressionQuality) == In.CompressionQuality; },
+				[](const FTexturePresetSettings& In, UTexture2D& Texture) { Texture.CompressionQuality = ETextureCompressionQuality(In.CompressionQuality); },
+				[](const UTexture2D& Texture, FTexturePresetSettings& Out) { Out.CompressionQuality = int32(Texture.CompressionQuality); },
+				[](const FTexturePresetSettings& From, FTexturePresetSettings& To) { To.CompressionQuality = From.CompressionQuality; }
+			},
+
+			// --- Virtual texturing ---
+			TEXTURE_PRESET_FIELD(VirtualTextureStreaming, VirtualTextureStreaming),
+
+			// --- Platforms ---
+			// Only downscale has a per-platform value on the texture; a platform
+			// only rebuilds when its own value changes
+			{
+				GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, PlatformOverrides),
+				[](const FTexturePresetSettings& In, const UTexture2D& Texture)
+				{
+					return Texture.Downscale.PerPlatform.OrderIndependentCompareEqual(GetPerPlatformDownscale(In));
+				},
+				[](const FTexturePresetSettings& In, UTexture2D& Texture) { Texture.Downscale.PerPlatform = GetPerPlatformDownscale(In); },
+				[](const UTexture2D& Texture, FTexturePresetSettings& Out)
+				{
+					for (FTexturePresetPlatformOverride& Override : Out.PlatformOverrides)
+					{
+						Override.bOverrideDownscaleFactor = false;
+					}
+					for (const TPair<FName, float>& Pair : Texture.Downscale.PerPlatform)
+					{
+						FTexturePresetPlatformOverride* Override = Out.PlatformOverrides.FindByPredicate(
+							[&Pair](const FTexturePresetPlatformOverride& Item) { return Item.Platform == Pair.Key; });
+						if (!Override)
+						{
+							Override = &Out.PlatformOverrides.AddDefaulted_GetRef();
+							Override->Platform = Pair.Key;
+						}
+						Override->bOverrideDownscaleFactor = true;
+						Override->DownscaleFactor = Pair.Value;
+					}
+				},
+				[](const FTexturePresetSettings& From, FTexturePresetSettings& To) { To.PlatformOverrides = From.PlatformOverrides; }
+			},
+		};
+		static_assert(UE_ARRAY_COUNT(Bindings) <= 64, "Field masks are 64 bit");
+
+		return Bindings;
+	}
+
+#undef TEXTURE_PRESET_FIELD
+
+	bool HasField(uint64 FieldMask, int32 Index)
+	{
+		return (FieldMask & (uint64(1) << Index)) != 0;
+	}
+}
+
 namespace TexturePresetLibrary
 {
-	void CaptureFromTexture(UTexturePresetAsset* PresetAsset, UTexture2D* Texture)
+	FTexturePresetSettings ResolveSettings(const UTexturePresetAsset* PresetAsset)
 	{
-		if (!PresetAsset || !Texture) return;
+		TEXTURE_MANAGER_SCOPE("ResolveSettings");
+		if (!PresetAsset) return FTexturePresetSettings();
+		if (!PresetAsset->ParentPreset) return PresetAsset->Settings;
 
-		FTexturePresetSettings& Out = PresetAsset->Settings;
+		FInheritanceChain Chain;
+		GetInheritanceChain(PresetAsset, Chain);
 
-		// --- Core ---
-		Out.TextureGroup = Texture->LODGroup;
-		Out.LODBias = Texture->LODBias;
-		Out.CompressionSettings = Texture->CompressionSettings;
-		//Out.CompressionQuality = Texture->CompressionQuality;
-		Out.bSRGB = Texture->SRGB;
+		const FObjectKey Key(PresetAsset);
+		if (const FResolvedPreset* Cached = GResolvedPresets.Find(Key))
+		{
+			if (IsCacheValid(*Cached, Chain))
+			{
+				return Cached->Settings;
+			}
+		}
 
-		Out.bUseAlpha = Texture->HasAlphaChannel(); // informational
-		Out.bFlipGreenChannel = Texture->bFlipGreenChannel;
+		// Root settings, then every override on the way down
+		FResolvedPreset Resolved;
+		Resolved.Settings = Chain.Last()->Settings;
+		for (int32 Index = Chain.Num() - 2; Index >= 0; --Index)
+		{
+			const UTexturePresetAsset* Node = Chain[Index];
+			for (const FName& Field : Node->OverriddenFields)
+			{
+				if (const FProperty* Property = FTexturePresetSettings::StaticStruct()->FindPropertyByName(Field))
+				{
+					Property->CopyCompleteValue_InContainer(&Resolved.Settings, &Node->Settings);
+				}
+			}
+		}
 
-		// --- Filter / addressing ---
-		Out.Filter = Texture->Filter;
-		Out.XTilingMethod = Texture->AddressX;
-		Out.YTilingMethod = Texture->AddressY;
-		//Out.AddressZ = Texture->AddressZ;
-		//Out.MaxAnisotropy = Texture->MaxAnisotropy;
+		for (const UTexturePresetAsset* Node : Chain)
+		{
+			Resolved.Chain.Emplace(FObjectKey(Node), Node->GetSettingsRevision());
+		}
 
-		// --- Mips / size ---
-		Out.MipGenSettings = Texture->MipGenSettings;
-		Out.MaxTextureSize = Texture->MaxTextureSize;
-		Out.NumCinematicMipLevels = Texture->NumCinematicMipLevels;
-		Out.bPreserveBorder = Texture->bPreserveBorder;
-		//Out.DownscaleFactor = Texture->DownscaleFactor;
-		//Out.DownscaleOptions = Texture->DownscaleOptions;
+		// Preview clones come and go; drop entries of presets that are gone
+		if (GResolvedPresets.Num() >= 256)
+		{
+			for (auto It = GResolvedPresets.CreateIterator(); It; ++It)
+			{
+				if (!It.Key().ResolveObjectPtr())
+				{
+					It.RemoveCurrent();
+				}
+			}
+		}
+		return GResolvedPresets.Add(Key, MoveTemp(Resolved)).Settings;
+	}
 
-		// --- Streaming / residency ---
-		Out.NeverStream = Texture->NeverStream;
-		Out.bForceMiplevelsToBeResident = Texture->bForceMiplevelsToBeResident;
-		//Out.StreamingDistanceMultiplier = Texture->StreamingDistanceMultiplier;
+	bool HasInheritanceCycle(const UTexturePresetAsset* PresetAsset)
+	{
+		int32 Depth = 0;
+		for (const UTexturePresetAsset* Node = PresetAsset ? PresetAsset->ParentPreset.Get() : nullptr;
+			Node; Node = Node->ParentPreset.Get())
+		{
+			if (Node == PresetAsset || ++Depth >= MaxInheritanceDepth)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
 
-		Out.Brightness = Texture->AdjustBrightness;
-		Out.BrightnessCurve = Texture->AdjustBrightnessCurve;
-		Out.Vibrance = Texture->AdjustVibrance;
-		Out.Saturation = Texture->AdjustSaturation;
-		Out.RGBCurve = Texture->AdjustRGBCurve;
-		Out.Hue = Texture->AdjustHue;
-		Out.MinAlpha = Texture->AdjustMinAlpha;
-		Out.MaxAlpha = Texture->AdjustMaxAlpha;
-		Out.ChromaKeyTexture = Texture->bChromaKeyTexture;
-		Out.ChromaKeyThreshold = Texture->ChromaKeyThreshold;
-		Out.ChromaKeyColor = Texture->ChromaKeyColor;
+	TArray<UTexturePresetAsset*> GetDerivedPresets(
+		const UTexturePresetAsset* BasePreset,
+		const TArray<TWeakObjectPtr<UTexturePresetAsset>>& Presets)
+	{
+		TArray<UTexturePresetAsset*> Derived;
+		if (!BasePreset) return Derived;
 
-		// --- Virtual texturing ---
-		Out.VirtualTextureStreaming = Texture->VirtualTextureStreaming;
+		for (const TWeakObjectPtr<UTexturePresetAsset>& WeakPreset : Presets)
+		{
+			UTexturePresetAsset* Preset = WeakPreset.Get();
+			if (!Preset || Preset == BasePreset || !Preset->ParentPreset)
+			{
+				continue;
+			}
 
-		// Add more fields here if you decide to extend the struct later.
+			FInheritanceChain Chain;
+			GetInheritanceChain(Preset, Chain);
+			if (Chain.Contains(BasePreset))
+			{
+				Derived.AddUnique(Preset);
+			}
+		}
+		return Derived;
 	}
 
-	void ApplyToTexture(UTexturePresetAsset* PresetAsset, UTexture2D* Texture)
+	int32 ApplyToLinkedTextures(const TArray<UTexturePresetAsset*>& Presets)
 	{
-		if (!PresetAsset || !Texture) return;
+		TEXTURE_MANAGER_SCOPE("ApplyToLinkedTextures");
+		FTextureManagerOperationScope Operation(TEXT("ApplyToLinkedTextures"));
+		int32 NumTextures = 0;
+		for (const UTexturePresetAsset* Preset : Presets)
+		{
+			NumTextures += Preset ? Preset->Files.Num() : 0;
+		}
 
-		const FTexturePresetSettings& In = PresetAsset->Settings;
+		FScopedSlowTask SlowTask(NumTextures, LOCTEXT("ApplyingPresets", "Applying presets..."));
+		SlowTask.MakeDialogDelayed(0.5f);
 
-		//Texture->Modify();
+		FString Label = TEXT("Apply");
+		for (const UTexturePresetAsset* Preset : Presets)
+		{
+			Label += TEXT(" ") + GetNameSafe(Preset);
+		}
+		const FGuid JournalBatch = TextureBulkJournal::BeginBatch(Label);
 
-		// --- Core ---
-		Texture->LODGroup = In.TextureGroup;
-		Texture->LODBias = In.LODBias;
-		Texture->CompressionSettings = In.CompressionSettings;
-		//Texture->CompressionQuality = In.CompressionQuality;
-		Texture->SRGB = In.bSRGB;
-		Texture->bFlipGreenChannel = In.bFlipGreenChannel;
+		// A texture is only linked to one preset, but Files can be stale
+		TSet<UTexture2D*> Applied;
+		int32 NumRebuilt = 0;
+		for (UTexturePresetAsset* Preset : Presets)
+		{
+			// The cook applies these; source packages stay as they are
+			if (!Preset || Preset->bApplyAtCook) continue;
 
-		// NOTE: bUseAlpha is informational; you cant actually force a texture
-		// to have alpha without changing its source/import. We dont apply it.
+			// Copy, PostEditChange can reach back into the preset
+			const TArray<UTexture2D*> Files = Preset->Files;
+			for (UTexture2D* Texture : Files)
+			{
+				SlowTask.EnterProgressFrame(1);
+				if (!Texture) continue;
 
-		// --- Filter / addressing ---
-		Texture->Filter = In.Filter;
-		Texture->AddressX = In.XTilingMethod;
-		Texture->AddressY = In.YTilingMethod;
-		//Texture->AddressZ = In.AddressZ;
-		//Texture->MaxAnisotropy = In.MaxAnisotropy;
+				bool bAlreadyApplied = false;
+				Applied.Add(Texture, &bAlreadyApplied);
+				if (bAlreadyApplied) continue;
 
-		// --- Mips / size ---
-		Texture->MipGenSettings = In.MipGenSettings;
-		Texture->MaxTextureSize = In.MaxTextureSize;
-		Texture->NumCinematicMipLevels = In.NumCinematicMipLevels;
-		Texture->bPreserveBorder = In.bPreserveBorder;
-		//Texture->DownscaleFactor = In.DownscaleFactor;
-		//Texture->DownscaleOptions = In.DownscaleOptions;
+				// Untouched textures are not rebuilt (nor dirtied)
+				if (DiffTexture(Preset, Texture).IsEmpty()) continue;
 
-		// --- Streaming / residency ---
-		Texture->NeverStream = In.NeverStream;
-		Texture->bForceMiplevelsToBeResident = In.bForceMiplevelsToBeResident;
-		//Texture->StreamingDistanceMultiplier = In.StreamingDistanceMultiplier;
-
-		Texture->AdjustBrightness = In.Brightness;
-		Texture->AdjustBrightnessCurve = In.BrightnessCurve;
-		Texture->AdjustVibrance = In.Vibrance;
-		Texture->AdjustSaturation = In.Saturation;
-		Texture->AdjustRGBCurve = In.RGBCurve;
-		Texture->AdjustHue = In.Hue;
-		Texture->AdjustMinAlpha = In.MinAlpha;
-		Texture->AdjustMaxAlpha = In.MaxAlpha;
-		Texture->bChromaKeyTexture = In.ChromaKeyTexture;
-		Texture->ChromaKeyThreshold = In.ChromaKeyThreshold;
-		Texture->ChromaKeyColor = In.ChromaKeyColor;
+				TextureRebuildScheduler::Enqueue(Preset, Texture, JournalBatch);
+				++NumRebuilt;
+			}
+		}
 
-		// --- Virtual texturing ---
-		Texture->VirtualTextureStreaming = In.VirtualTextureStreaming;
+		// Nobody ticks the scheduler in a commandlet
+		if (IsRunningCommandlet())
+		{
+			TextureRebuildScheduler::Flush();
+		}
+		return NumRebuilt;
+	}
+
+	FTexturePresetSettings ResolveForPlatform(const FTexturePresetSettings& Settings, FName PlatformName)
+	{
+		FTexturePresetSettings Out = Settings;
+		Out.PlatformOverrides.Reset();
+		if (PlatformName.IsNone() || Settings.PlatformOverrides.IsEmpty())
+		{
+			return Out;
+		}
+
+		// Group entries first so the platform's own entry wins
+		const FName GroupName = FDataDrivenPlatformInfoRegistry::GetPlatformInfo(PlatformName).PlatformGroupName;
+		for (const FName Name : { GroupName, PlatformName })
+		{
+			if (Name.IsNone())
+			{
+				continue;
+			}
+
+			for (const FTexturePresetPlatformOverride& Override : Settings.PlatformOverrides)
+			{
+				if (Override.Platform != Name)
+				{
+					continue;
+				}
+
+				if (Override.bOverrideMaxTextureSize) Out.MaxTextureSize = Override.MaxTextureSize;
+				if (Override.bOverrideLODBias) Out.LODBias = Override.LODBias;
+				if (Override.bOverrideDownscaleFactor) Out.DownscaleFactor = Override.DownscaleFactor;
+				if (Override.bOverrideCompressionQuality) Out.CompressionQuality = Override.CompressionQuality;
+			}
+		}
+		return Out;
+	}
+
+	void ClearCookOnlyOverrides(FTexturePresetSettings& Settings)
+	{
+		for (FTexturePresetPlatformOverride& Override : Settings.PlatformOverrides)
+		{
+			Override.bOverrideMaxTextureSize = false;
+			Override.bOverrideLODBias = false;
+			Override.bOverrideCompressionQuality = false;
+		}
+	}
+
+	bool HasCookOnlyOverrides(const FTexturePresetSettings& Settings)
+	{
+		return Settings.PlatformOverrides.ContainsByPredicate([](const FTexturePresetPlatformOverride& Override)
+		{
+			return Override.bOverrideMaxTextureSize || Override.bOverrideLODBias || Override.bOverrideCompressionQuality;
+		});
+	}
+
+	TArray<FName> GetApplicableFields()
+	{
+		TArray<FName> Names;
+		for (const FPresetFieldBinding& Binding : GetFieldBindings())
+		{
+			Names.Add(Binding.Field);
+		}
+		return Names;
+	}
+
+	uint64 GetAllFieldsMask()
+	{
+		const int32 NumFields = GetFieldBindings().Num();
+		return NumFields >= 64 ? ~uint64(0) : (uint64(1) << NumFields) - 1;
+	}
+
+	uint64 GetAppliedFieldMask(const UTexturePresetAsset* PresetAsset)
+	{
+		FInheritanceChain Chain;
+		GetInheritanceChain(PresetAsset, Chain);
+
+		for (const UTexturePresetAsset* Node : Chain)
+		{
+			if (Node->AppliedFields.IsEmpty())
+			{
+				continue;
+			}
+
+			const TConstArrayView<FPresetFieldBinding> Bindings = GetFieldBindings();
+			uint64 FieldMask = 0;
+			for (int32 Index = 0; Index < Bindings.Num(); ++Index)
+			{
+				if (Node->AppliedFields.Contains(Bindings[Index].Field))
+				{
+					FieldMask |= uint64(1) << Index;
+				}
+			}
+			return FieldMask;
+		}
+		return GetAllFieldsMask();
+	}
+
+	void CopyFields(const FTexturePresetSettings& From, FTexturePresetSettings& To, uint64 FieldMask)
+	{
+		const TConstArrayView<FPresetFieldBinding> Bindings = GetFieldBindings();
+		for (int32 Index = 0; Index < Bindings.Num(); ++Index)
+		{
+			if (HasField(FieldMask, Index))
+			{
+				Bindings[Index].Copy(From, To);
+			}
+		}
+	}
+
+	TArray<FName> DiffTexture(const UTexturePresetAsset* PresetAsset, const UTexture2D* Texture)
+	{
+		TEXTURE_MANAGER_SCOPE("DiffTexture");
+		if (!PresetAsset || !Texture) return TArray<FName>();
+
+		return DiffSettings(ResolveSettings(PresetAsset), GetAppliedFieldMask(PresetAsset), Texture);
+	}
+
+	TArray<FName> DiffSettings(const FTexturePresetSettings& In, uint64 FieldMask, const UTexture2D* Texture)
+	{
+		TArray<FName> Changed;
+		if (!Texture) return Changed;
+
+		const TConstArrayView<FPresetFieldBinding> Bindings = GetFieldBindings();
+		for (int32 Index = 0; Index < Bindings.Num(); ++Index)
+		{
+			if (HasField(FieldMask, Index) && !Bindings[Index].Matches(In, *Texture))
+			{
+				Changed.Add(Bindings[Index].Field);
+			}
+		}
+		return Changed;
+	}
+
+	FTexturePresetSettings CaptureSettings(const UTexture2D* Texture)
+	{
+		TEXTURE_MANAGER_SCOPE("CaptureSettings");
+		FTexturePresetSettings Out;
+		if (!Texture) return Out;
+
+		for (const FPresetFieldBinding& Binding : GetFieldBindings())
+		{
+			Binding.Capture(*Texture, Out);
+		}
+		TRACE_COUNTER_INCREMENT(TextureManager_TexturesCaptured);
+		return Out;
+	}
+
+	void CaptureFromTexture(UTexturePresetAsset* PresetAsset, UTexture2D* Texture)
+	{
+		TEXTURE_MANAGER_SCOPE("CaptureFromTexture");
+		if (!PresetAsset || !Texture) return;
+
+		// Only the fields the preset applies; a derived preset now sets them itself
+		const uint64 FieldMask = GetAppliedFieldMask(PresetAsset);
+		const TConstArrayView<FPresetFieldBinding> Bindings = GetFieldBindings();
+		for (int32 Index = 0; Index < Bindings.Num(); ++Index)
+		{
+			if (HasField(FieldMask, Index))
+			{
+				Bindings[Index].Capture(*Texture, PresetAsset->Settings);
+				if (PresetAsset->ParentPreset)
+				{
+					PresetAsset->OverriddenFields.AddUnique(Bindings[Index].Field);
+				}
+			}
+		}
+		PresetAsset->NotifySettingsChanged();
+		TRACE_COUNTER_INCREMENT(TextureManager_TexturesCaptured);
+	}
+
+	bool ApplyToTexture(UTexturePresetAsset* PresetAsset, UTexture2D* Texture)
+	{
+		if (!PresetAsset || !Texture) return false;
 
 		//Texture->PostEditChange();
 		//Texture->MarkPackageDirty();
+		return ApplySettingsToTexture(ResolveSettings(PresetAsset), GetAppliedFieldMask(PresetAsset), Texture);
+	}
+
+	bool ApplySettingsToTexture(const FTexturePresetSettings& In, uint64 FieldMask, UTexture2D* Texture)
+	{
+		TEXTURE_MANAGER_SCOPE("ApplySettingsToTexture");
+		FTextureManagerPhaseScope Phase(ETextureManagerPhase::Apply);
+		if (!Texture) return false;
+
+		// Write only what differs, so callers can skip the rebuild otherwise
+		bool bChanged = false;
+		const TConstArrayView<FPresetFieldBinding> Bindings = GetFieldBindings();
+		for (int32 Index = 0; Index < Bindings.Num(); ++Index)
+		{
+			if (HasField(FieldMask, Index) && !Bindings[Index].Matches(In, *Texture))
+			{
+				Bindings[Index].Apply(In, *Texture);
+				bChanged = true;
+
+				if (Bindings[Index].Field == GET_MEMBER_NAME_CHECKED(FTexturePresetSettings, bUseAlpha)
+					&& !In.bUseAlpha && !Texture->CompressionNoAlpha)
+				{
+					UE_LOG(LogTemp, Log, TEXT("%s uses its alpha, kept it although the preset has Use Alpha off"),
+						*Texture->GetName());
+				}
+			}
+		}
+		if (bChanged)
+		{
+			TRACE_COUNTER_INCREMENT(TextureManager_TexturesApplied);
+		}
+		return bChanged;
 	}
 
 	UTexturePresetAsset* CreatePresetAssetFromTexture(
@@ -130,6 +590,7 @@ namespace TexturePresetLibrary
 		const FString& PackagePath,
 		FName PresetName)
 	{
+		TEXTURE_MANAGER_SCOPE("CreatePresetAssetFromTexture");
 #if WITH_EDITOR
 		if (!Texture)
 		{
@@ -189,6 +650,7 @@ namespace TexturePresetLibrary
 
 	UTexturePresetAsset* CreatePresetAsset(const FString& PackagePath, FName PresetName)
 	{
+		TEXTURE_MANAGER_SCOPE("CreatePresetAsset");
 #if WITH_EDITOR
 		// Default path if none provided
 		const FString SanitizedPath = PackagePath.IsEmpty()
@@ -264,6 +726,7 @@ namespace TexturePresetLibrary
 			UserData->AssignedPreset->MarkPackageDirty();
 		}
 		UserData->AssignedPreset = PresetAsset;
+		UserData->bFromFolder = false;
 		UserData->AssignedPreset->Files.Add(Texture);
 		UserData->AssignedPreset->MarkPackageDirty();
 
@@ -294,13 +757,16 @@ namespace TexturePresetLibrary
 		Filter.bRecursivePaths = true;
 
 		TArray<FAssetData> PresetAssets;
-		AssetRegistryModule.Get().GetAssets(Filter, PresetAssets);
+		{
+			FTextureManagerPhaseScope Phase(ETextureManagerPhase::RegistryQuery);
+			AssetRegistryModule.Get().GetAssets(Filter, PresetAssets);
+		}
 
 		const FName TargetName(*InPresetName);
 
 		for (const FAssetData& AssetData : PresetAssets)
 		{
-			UTexturePresetAsset* Preset = Cast<UTexturePresetAsset>(AssetData.GetAsset());
+			UTexturePresetAsset* Preset = Cast<UTexturePresetAsset>(TextureManagerMetrics::LoadAsset(AssetData));
 			if (!Preset)
 			{
 				continue;
@@ -325,6 +791,7 @@ namespace TexturePresetLibrary
 
 	TArray<UTexture2D*> GetAllTexturesUsingPreset(UTexturePresetAsset* PresetAsset)
 	{
+		TEXTURE_MANAGER_SCOPE("GetAllTexturesUsingPreset");
 		TArray<UTexture2D*> Result;
 
 #if WITH_EDITOR
@@ -342,11 +809,14 @@ namespace TexturePresetLibrary
 		Filter.PackagePaths.Add(FName(TEXT("/Game"))); // Limit to /Game; tweak if needed
 
 		TArray<FAssetData> TextureAssets;
-		AssetRegistryModule.Get().GetAssets(Filter, TextureAssets);
+		{
+			FTextureManagerPhaseScope Phase(ETextureManagerPhase::RegistryQuery);
+			AssetRegistryModule.Get().GetAssets(Filter, TextureAssets);
+		}
 
 		for (const FAssetData& Data : TextureAssets)
 		{
-			UTexture2D* Texture = Cast<UTexture2D>(Data.GetAsset());
+			UTexture2D* Texture = Cast<UTexture2D>(TextureManagerMetrics::LoadAsset(Data));
 			if (!Texture)
 			{
 				continue;
@@ -387,6 +857,7 @@ namespace TexturePresetLibrary
 
 	void CopyProperties(UTexturePresetAsset* AssetIn, UTexturePresetAsset* AssetOut)
 	{
+		TEXTURE_MANAGER_SCOPE("CopyProperties");
 		FTexturePresetSettings& In = AssetIn->Settings;
 		FTexturePresetSettings& Out = AssetOut->Settings;
 
@@ -394,7 +865,7 @@ namespace TexturePresetLibrary
 		Out.TextureGroup = In.TextureGroup;
 		Out.LODBias = In.LODBias;
 		Out.CompressionSettings = In.CompressionSettings;
-		//Out.CompressionQuality = Texture->CompressionQuality;
+		Out.CompressionQuality = In.CompressionQuality;
 		Out.bSRGB = In.bSRGB;
 
 		Out.bUseAlpha = In.bUseAlpha; // informational
@@ -412,7 +883,7 @@ namespace TexturePresetLibrary
 		Out.MaxTextureSize = In.MaxTextureSize;
 		Out.NumCinematicMipLevels = In.NumCinematicMipLevels;
 		Out.bPreserveBorder = In.bPreserveBorder;
-		//Out.DownscaleFactor = Texture->DownscaleFactor;
+		Out.DownscaleFactor = In.DownscaleFactor;
 		//Out.DownscaleOptions = Texture->DownscaleOptions;
 
 		// --- Streaming / residency ---
@@ -434,9 +905,29 @@ namespace TexturePresetLibrary
 
 		// --- Virtual texturing ---
 		Out.VirtualTextureStreaming = In.VirtualTextureStreaming;
+
+		// --- Platforms ---
+		Out.PlatformOverrides = In.PlatformOverrides;
+
+		// --- Scalability ---
+		AssetOut->ScalabilityTiers = AssetIn->ScalabilityTiers;
+		AssetOut->bApplyAtCook = AssetIn->bApplyAtCook;
+
+		// --- Inheritance / mask ---
+		AssetOut->AppliedFields = AssetIn->AppliedFields;
+		AssetOut->OverriddenFields = AssetIn->OverriddenFields;
+		AssetOut->ParentPreset = AssetIn->ParentPreset;
+		if (HasInheritanceCycle(AssetOut))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s: %s would inherit from itself, parent cleared"),
+				*AssetOut->GetName(), *GetNameSafe(AssetOut->ParentPreset));
+			AssetOut->ParentPreset = nullptr;
+		}
+
+		AssetOut->NotifySettingsChanged();
 	}
 
-	void RemovePresetFromTexture(UTexture2D* Texture)
+	void RemovePresetFromTexture(UTexture2D* Texture, TArray<UPackage*>* OutPackagesToSave)
 	{
 #if WITH_EDITOR
 		if (!Texture)
@@ -476,12 +967,26 @@ namespace TexturePresetLibrary
 		UserData->AssignedPreset = nullptr;
 		Texture->RemoveUserDataOfClass(UTexturePresetUserData::StaticClass());
 		Texture->MarkPackageDirty();
+
+		if (OutPackagesToSave)
+		{
+			for (UPackage* Package : PackagesToSave)
+			{
+				OutPackagesToSave->AddUnique(Package);
+			}
+			return;
+		}
+
 		// Save without another "Do you want to save?" prompt  pressing our Save
 // button is already the explicit intent to save these assets.
+		FTextureManagerPhaseScope Phase(ETextureManagerPhase::Save);
 		FEditorFileUtils::PromptForCheckoutAndSave(
 			PackagesToSave,
 			/*bCheckDirty=*/false,
 			/*bPromptToSave=*/false);
+		TextureManagerMetrics::AddPackagesSaved(PackagesToSave.Num());
 #endif
 	}
 }
+
+#undef LOCTEXT_NAMESPACE
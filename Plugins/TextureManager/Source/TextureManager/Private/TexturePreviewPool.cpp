@@ -0,0 +1,273 @@
+#include "TexturePreviewPool.h"
+
+#include "TextureManagerStats.h"
+#include "TexturePresetAsset.h"
+#include "TexturePresetLibrary.h"
+
+#include "Engine/AssetUserData.h"
+#include "Engine/Texture2D.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "UObject/Package.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+	// Totals over every pool, game thread only
+	int32 LiveObjects = 0;
+	int64 LiveBytes = 0;
+
+	void PublishCounters()
+	{
+		SET_DWORD_STAT(STAT_TextureManager_PreviewObjects, LiveObjects);
+		SET_MEMORY_STAT(STAT_TextureManager_PreviewMemory, LiveBytes);
+		TRACE_COUNTER_SET(TextureManager_PreviewObjects, LiveObjects);
+		TRACE_COUNTER_SET(TextureManager_PreviewMemory, LiveBytes);
+	}
+
+	// Approximate: what the object serializes to plus its render resources
+	int64 EstimateBytes(UObject* Object)
+	{
+		FArchiveCountMem Ar(Object);
+		return int64(Ar.GetMax()) + int64(Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive));
+	}
+
+	// Both objects are of the same class. Instanced subobjects are left alone;
+	// copying them would share them between the two objects.
+	void CopyPropertyValues(const UObject* From, UObject* To, EPropertyFlags RequiredFlags)
+	{
+		for (TFieldIterator<FProperty> It(From->GetClass()); It; ++It)
+		{
+			const FProperty* Property = *It;
+			if (!Property->HasAllPropertyFlags(RequiredFlags)
+				|| Property->HasAnyPropertyFlags(CPF_InstancedReference | CPF_ContainsInstancedReference))
+			{
+				continue;
+			}
+			Property->CopyCompleteValue_InContainer(To, From);
+		}
+	}
+
+	// Asset user data (the preset link among it) is instanced: update the
+	// copy's objects in place, duplicate only what it does not have yet
+	void CopyAssetUserData(UTexture2D* From, UTexture2D* To)
+	{
+		const TArray<UAssetUserData*> FromUserData = From->GetAssetUserDataArray() ? *From->GetAssetUserDataArray() : TArray<UAssetUserData*>();
+		const TArray<UAssetUserData*> ToUserData = To->GetAssetUserDataArray() ? *To->GetAssetUserDataArray() : TArray<UAssetUserData*>();
+
+		for (UAssetUserData* UserData : ToUserData)
+		{
+			if (UserData && !From->GetAssetUserDataOfClass(UserData->GetClass()))
+			{
+				To->RemoveUserDataOfClass(UserData->GetClass());
+			}
+		}
+
+		for (UAssetUserData* UserData : FromUserData)
+		{
+			if (!UserData)
+			{
+				continue;
+			}
+
+			if (UAssetUserData* Existing = To->GetAssetUserDataOfClass(UserData->GetClass()))
+			{
+				CopyPropertyValues(UserData, Existing, CPF_None);
+			}
+			else
+			{
+				To->AddAssetUserData(DuplicateObject<UAssetUserData>(UserData, To));
+			}
+		}
+	}
+
+	void RefreshPreset(UTexturePresetAsset* Source, UTexturePresetAsset* Clone)
+	{
+		// Show the values currently inherited from the parent
+		Clone->Settings = TexturePresetLibrary::ResolveSettings(Source);
+		Clone->NotifySettingsChanged();
+	}
+}
+
+FTexturePreviewPool::FTexturePreviewPool(int32 InMaxTextures, int32 InMaxPresets)
+	: MaxTextures(FMath::Max(InMaxTextures, 1))
+	, MaxPresets(FMath::Max(InMaxPresets, 1))
+{
+}
+
+FTexturePreviewPool::~FTexturePreviewPool()
+{
+	Reset();
+}
+
+UTexture2D* FTexturePreviewPool::GetTexture(UTexture2D* Source)
+{
+	TEXTURE_MANAGER_SCOPE("PreviewPool::GetTexture");
+	if (!Source) return nullptr;
+
+	FEntry* Entry = FindOrAdd(Textures, MaxTextures, Source);
+
+#if WITH_EDITORONLY_DATA
+	const FGuid SourceId = Source->Source.GetId();
+#else
+	const FGuid SourceId;
+#endif
+
+	UTexture2D* Clone = Cast<UTexture2D>(Entry->Clone.Get());
+	if (Clone && Entry->SourceId == SourceId)
+	{
+		CopyPropertyValues(Source, Clone, CPF_Edit);
+		CopyAssetUserData(Source, Clone);
+		return Clone;
+	}
+
+	// New source art (or nothing pooled yet): the copy needs the new mips
+	Release(*Entry);
+	Fill(*Entry, Source);
+	Entry->SourceId = SourceId;
+	return Cast<UTexture2D>(Entry->Clone.Get());
+}
+
+UTexturePresetAsset* FTexturePreviewPool::GetPreset(UTexturePresetAsset* Source)
+{
+	TEXTURE_MANAGER_SCOPE("PreviewPool::GetPreset");
+	if (!Source) return nullptr;
+
+	FEntry* Entry = FindOrAdd(Presets, MaxPresets, Source);
+
+	UTexturePresetAsset* Clone = Cast<UTexturePresetAsset>(Entry->Clone.Get());
+	if (Clone)
+	{
+		CopyPropertyValues(Source, Clone, CPF_Edit);
+	}
+	else
+	{
+		Fill(*Entry, Source);
+		Clone = Cast<UTexturePresetAsset>(Entry->Clone.Get());
+	}
+
+	RefreshPreset(Source, Clone);
+	return Clone;
+}
+
+UTexturePresetAsset* FTexturePreviewPool::GetScratchPreset(UTexturePresetAsset* Source)
+{
+	TEXTURE_MANAGER_SCOPE("PreviewPool::GetScratchPreset");
+	if (!Source) return nullptr;
+
+	Scratch.Source = Source;
+
+	UTexturePresetAsset* Clone = Cast<UTexturePresetAsset>(Scratch.Clone.Get());
+	if (Clone)
+	{
+		CopyPropertyValues(Source, Clone, CPF_Edit);
+	}
+	else
+	{
+		Fill(Scratch, Source);
+		Clone = Cast<UTexturePresetAsset>(Scratch.Clone.Get());
+	}
+
+	RefreshPreset(Source, Clone);
+	return Clone;
+}
+
+void FTexturePreviewPool::Reset()
+{
+	for (FEntry& Entry : Textures)
+	{
+		Release(Entry);
+	}
+	for (FEntry& Entry : Presets)
+	{
+		Release(Entry);
+	}
+	Release(Scratch);
+
+	Textures.Reset();
+	Presets.Reset();
+	Scratch.Source.Reset();
+}
+
+int32 FTexturePreviewPool::GetNumLiveObjects()
+{
+	return LiveObjects;
+}
+
+int64 FTexturePreviewPool::GetLiveBytes()
+{
+	return LiveBytes;
+}
+
+FTexturePreviewPool::FEntry* FTexturePreviewPool::FindOrAdd(TArray<FEntry>& Entries, int32 MaxEntries, UObject* Source)
+{
+	int32 Found = INDEX_NONE;
+	for (int32 Index = Entries.Num() - 1; Index >= 0; --Index)
+	{
+		UObject* EntrySource = Entries[Index].Source.Get();
+		if (EntrySource == Source)
+		{
+			Found = Index;
+		}
+		else if (!EntrySource)
+		{
+			// The asset is gone; so is any reason to keep its copy
+			Release(Entries[Index]);
+			Entries.RemoveAt(Index);
+			if (Found != INDEX_NONE)
+			{
+				--Found;
+			}
+		}
+	}
+
+	if (Found != INDEX_NONE)
+	{
+		FEntry Entry = MoveTemp(Entries[Found]);
+		Entries.RemoveAt(Found);
+		return &Entries.Add_GetRef(MoveTemp(Entry));
+	}
+
+	while (Entries.Num() >= MaxEntries)
+	{
+		Release(Entries[0]);
+		Entries.RemoveAt(0);
+	}
+
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Source = Source;
+	return &Entry;
+}
+
+void FTexturePreviewPool::Fill(FEntry& Entry, UObject* Source)
+{
+	UObject* Outer = GetTransientPackage();
+	const FName Name = MakeUniqueObjectName(Outer, Source->GetClass(), FName(*FString::Printf(TEXT("%s_Copy"), *Source->GetName())));
+
+	UObject* Clone = DuplicateObject<UObject>(Source, Outer, Name);
+	Clone->ClearFlags(RF_Standalone | RF_Public);
+	Clone->SetFlags(RF_Transient);
+	TRACE_COUNTER_INCREMENT(TextureManager_ObjectsCloned);
+
+	Entry.Clone.Reset(Clone);
+	Entry.Bytes = EstimateBytes(Clone);
+
+	++LiveObjects;
+	LiveBytes += Entry.Bytes;
+	PublishCounters();
+}
+
+void FTexturePreviewPool::Release(FEntry& Entry)
+{
+	if (!Entry.Clone.IsValid())
+	{
+		return;
+	}
+
+	// Nothing else owns the copy; the next garbage collection frees it
+	Entry.Clone.Reset();
+
+	--LiveObjects;
+	LiveBytes -= Entry.Bytes;
+	Entry.Bytes = 0;
+	PublishCounters();
+}
@@ -0,0 +1,249 @@
+#include "TextureRebuildCostModel.h"
+
+#include "TextureMemoryEstimator.h"
+#include "TexturePresetAsset.h"
+#include "TexturePresetLibrary.h"
+
+#include "Engine/Texture2D.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	constexpr int32 CacheFileVersion = 1;
+
+	// Later samples weigh at least 1/MaxWeight, so the model follows new
+	// hardware or compressor versions instead of averaging over all history
+	constexpr int32 MaxWeight = 32;
+
+	// Before any sample at all; roughly BC7 on a desktop CPU
+	constexpr double DefaultSecondsPerMegapixel = 0.5;
+
+	struct FBucket
+	{
+		int32 Samples = 0;
+		double SecondsPerMegapixel = 0.0;
+	};
+
+	// Compression | size log2 << 8 | mips << 16
+	TMap<uint32, FBucket> GBuckets;
+
+	bool GLoaded = false;
+	bool GDirty = false;
+	bool GRecording = true;
+
+	FString GetCacheFilePath()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("TextureManager") / TEXT("RebuildCosts.bin");
+	}
+
+	void SerializeModel(FArchive& Ar)
+	{
+		int32 Version = CacheFileVersion;
+		Ar << Version;
+		if (Version != CacheFileVersion)
+		{
+			return;
+		}
+
+		int32 Num = GBuckets.Num();
+		Ar << Num;
+
+		if (Ar.IsLoading())
+		{
+			GBuckets.Reserve(Num);
+			for (int32 Index = 0; Index < Num && !Ar.IsError(); ++Index)
+			{
+				uint32 Key = 0;
+				FBucket Bucket;
+				Ar << Key << Bucket.Samples << Bucket.SecondsPerMegapixel;
+				GBuckets.Add(Key, Bucket);
+			}
+		}
+		else
+		{
+			for (TPair<uint32, FBucket>& Pair : GBuckets)
+			{
+				Ar << Pair.Key << Pair.Value.Samples << Pair.Value.SecondsPerMegapixel;
+			}
+		}
+	}
+
+	void LoadModel()
+	{
+		if (GLoaded)
+		{
+			return;
+		}
+		GLoaded = true;
+
+		TArray<uint8> Bytes;
+		if (FFileHelper::LoadFileToArray(Bytes, *GetCacheFilePath(), FILEREAD_Silent))
+		{
+			FMemoryReader Reader(Bytes);
+			SerializeModel(Reader);
+			if (Reader.IsError())
+			{
+				GBuckets.Reset();
+			}
+		}
+	}
+
+	// Top mip as built: the source, clamped by MaxTextureSize (LOD bias only
+	// drops mips at runtime, they are all built)
+	void GetBuildSize(const FTextureMemoryInputs& Inputs, int32& OutSizeX, int32& OutSizeY)
+	{
+		OutSizeX = FMath::Max(Inputs.SourceSizeX, 1);
+		OutSizeY = FMath::Max(Inputs.SourceSizeY, 1);
+
+		const int32 MaxSize = Inputs.Settings.MaxTextureSize;
+		while (MaxSize > 0 && FMath::Max(OutSizeX, OutSizeY) > MaxSize)
+		{
+			OutSizeX = FMath::Max(OutSizeX / 2, 1);
+			OutSizeY = FMath::Max(OutSizeY / 2, 1);
+		}
+	}
+
+	uint32 MakeKey(uint8 Compression, int32 SizeLog2, bool bMips)
+	{
+		return uint32(Compression) | (uint32(SizeLog2) << 8) | (uint32(bMips ? 1 : 0) << 16);
+	}
+
+	uint32 MakeKey(const FTextureMemoryInputs& Inputs, double& OutMegapixels)
+	{
+		int32 SizeX = 0;
+		int32 SizeY = 0;
+		GetBuildSize(Inputs, SizeX, SizeY);
+		OutMegapixels = double(SizeX) * double(SizeY) / (1024.0 * 1024.0);
+
+		return MakeKey(
+			uint8(Inputs.Settings.CompressionSettings.GetValue()),
+			FMath::CeilLogTwo(FMath::Max(SizeX, SizeY)),
+			Inputs.Settings.MipGenSettings != TMGS_NoMipmaps);
+	}
+
+	// Rate of the bucket, else the same format and mips at the nearest size,
+	// else the mean of all buckets
+	double FindSecondsPerMegapixel(uint32 Key, bool& bOutExtrapolated)
+	{
+		bOutExtrapolated = false;
+		if (const FBucket* Bucket = GBuckets.Find(Key))
+		{
+			return Bucket->SecondsPerMegapixel;
+		}
+
+		bOutExtrapolated = true;
+		const uint32 ShapeMask = 0xFFu | (1u << 16);
+		const int32 SizeLog2 = int32((Key >> 8) & 0xFF);
+
+		const FBucket* Nearest = nullptr;
+		int32 NearestDistance = MAX_int32;
+		double Sum = 0.0;
+		for (const TPair<uint32, FBucket>& Pair : GBuckets)
+		{
+			Sum += Pair.Value.SecondsPerMegapixel;
+			if ((Pair.Key & ShapeMask) != (Key & ShapeMask))
+			{
+				continue;
+			}
+
+			const int32 Distance = FMath::Abs(int32((Pair.Key >> 8) & 0xFF) - SizeLog2);
+			if (Distance < NearestDistance)
+			{
+				NearestDistance = Distance;
+				Nearest = &Pair.Value;
+			}
+		}
+
+		if (Nearest)
+		{
+			return Nearest->SecondsPerMegapixel;
+		}
+		return GBuckets.IsEmpty() ? DefaultSecondsPerMegapixel : Sum / GBuckets.Num();
+	}
+}
+
+namespace TextureRebuildCostModel
+{
+	void AddSample(const UTexture2D* Texture, double Seconds)
+	{
+		if (!Texture || Seconds <= 0.0 || !GRecording)
+		{
+			return;
+		}
+		LoadModel();
+
+		const FTextureMemoryInputs Inputs =
+			TextureMemoryEstimator::MakeInputs(Texture, TextureMemoryEstimator::GetTextureSettings(Texture));
+		double Megapixels = 0.0;
+		const uint32 Key = MakeKey(Inputs, Megapixels);
+
+		FBucket& Bucket = GBuckets.FindOrAdd(Key);
+		Bucket.Samples = FMath::Min(Bucket.Samples + 1, MaxWeight);
+		Bucket.SecondsPerMegapixel += (Seconds / Megapixels - Bucket.SecondsPerMegapixel) / Bucket.Samples;
+		GDirty = true;
+	}
+
+	double EstimateSeconds(const FTextureMemoryInputs& Inputs, bool& bOutExtrapolated)
+	{
+		LoadModel();
+
+		double Megapixels = 0.0;
+		const uint32 Key = MakeKey(Inputs, Megapixels);
+		return FindSecondsPerMegapixel(Key, bOutExtrapolated) * Megapixels;
+	}
+
+	FTextureRebuildEstimate EstimateApply(const UTexturePresetAsset* Preset, const TArray<UTexture2D*>& Textures)
+	{
+		FTextureRebuildEstimate Estimate;
+		if (!Preset)
+		{
+			return Estimate;
+		}
+
+		FTexturePresetSettings Settings = TexturePresetLibrary::ResolveSettings(Preset);
+		if (!Preset->bApplyAtCook)
+		{
+			TexturePresetLibrary::ClearCookOnlyOverrides(Settings);
+		}
+		const uint64 FieldMask = TexturePresetLibrary::GetAppliedFieldMask(Preset);
+
+		for (const UTexture2D* Texture : Textures)
+		{
+			if (!Texture || TexturePresetLibrary::DiffTexture(Preset, Texture).IsEmpty())
+			{
+				continue;
+			}
+
+			FTexturePresetSettings Effective = TextureMemoryEstimator::GetTextureSettings(Texture);
+			TexturePresetLibrary::CopyFields(Settings, Effective, FieldMask);
+
+			bool bExtrapolated = false;
+			Estimate.Seconds += EstimateSeconds(TextureMemoryEstimator::MakeInputs(Texture, Effective), bExtrapolated);
+			Estimate.NumExtrapolated += bExtrapolated ? 1 : 0;
+			++Estimate.NumTextures;
+		}
+		return Estimate;
+	}
+
+	void Save()
+	{
+		if (!GDirty)
+		{
+			return;
+		}
+		GDirty = false;
+
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		SerializeModel(Writer);
+		FFileHelper::SaveArrayToFile(Bytes, *GetCacheFilePath());
+	}
+
+	void SetRecording(bool bRecord)
+	{
+		GRecording = bRecord;
+	}
+}
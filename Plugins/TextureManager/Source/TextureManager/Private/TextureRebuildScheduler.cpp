@@ -0,0 +1,426 @@
+#include "TextureRebuildScheduler.h"
+
+#include "TextureBulkJournal.h"
+#include "TextureManagerMetrics.h"
+#include "TextureManagerSettings.h"
+#include "TextureManagerStats.h"
+#include "TexturePresetAsset.h"
+#include "TexturePresetLibrary.h"
+#include "TextureRebuildCostModel.h"
+
+#include "AssetCompilingManager.h"
+#include "Containers/Ticker.h"
+#include "Engine/Texture2D.h"
+#include "HAL/PlatformMisc.h"
+
+namespace
+{
+	struct FQueuedRebuild
+	{
+		TWeakObjectPtr<UTexture2D> Texture;
+
+		// The preset, resolved when the build starts, or settings already
+		// resolved with the fields to write (rollback)
+		TWeakObjectPtr<UTexturePresetAsset> Preset;
+		TOptional<FTexturePresetSettings> Settings;
+		uint64 FieldMask = 0;
+
+		FGuid JournalBatch;
+
+		// Key into GQueueByPackage, kept here as the texture may be gone on removal
+		FName PackageName;
+	};
+
+	struct FRunningRebuild
+	{
+		TWeakObjectPtr<UTexture2D> Texture;
+		int64 Bytes = 0;
+		double StartSeconds = 0.0;
+
+		// Builds share the cores; the cost model wants the time one would take alone
+		int32 Concurrency = 1;
+	};
+
+	// Oldest first. A started or dropped entry leaves a hole (explicitly null
+	// Texture) so the slots in GQueueIndex stay valid; holes at the front are
+	// skipped and the array is compacted once they make up half of it.
+	TArray<FQueuedRebuild> GQueue;
+	TMap<TWeakObjectPtr<UTexture2D>, int32> GQueueIndex;
+	int32 GQueueHead = 0;
+
+	// Same slots by package, so priority rows are found without a queue scan
+	TMap<FName, int32> GQueueByPackage;
+
+	TArray<FRunningRebuild> GRunning;
+	int32 GNumDone = 0;
+	bool GPaused = false;
+
+	FTSTicker::FDelegateHandle GTickerHandle;
+
+	TextureRebuildScheduler::FOnGatherPriority GOnGatherPriority;
+	FSimpleMulticastDelegate GOnDrained;
+
+	int32 GetMaxInFlight()
+	{
+		const int32 Configured = GetDefault<UTextureManagerSettings>()->RebuildMaxInFlight;
+
+		// Compressors are multithreaded themselves
+		return Configured > 0 ? Configured : FMath::Max(FPlatformMisc::NumberOfCores() / 2, 1);
+	}
+
+	int64 GetMemoryBudget()
+	{
+		return int64(GetDefault<UTextureManagerSettings>()->RebuildMemoryBudgetMB) * 1024 * 1024;
+	}
+
+	int64 GetBuildMemory(const UTexture2D* Texture)
+	{
+#if WITH_EDITOR
+		const int64 Required = Texture->GetBuildRequiredMemory();
+		if (Required > 0)
+		{
+			return Required;
+		}
+
+		// Source as RGBA32F with its mip chain
+		return int64(Texture->Source.GetSizeX()) * Texture->Source.GetSizeY() * 16 * 4 / 3;
+#else
+		return 0;
+#endif
+	}
+
+	bool IsQueueEmpty()
+	{
+		return GQueueIndex.IsEmpty();
+	}
+
+	void ResetQueue()
+	{
+		GQueue.Reset();
+		GQueueIndex.Reset();
+		GQueueByPackage.Reset();
+		GQueueHead = 0;
+	}
+
+	void RemoveQueued(int32 Index)
+	{
+		GQueueIndex.Remove(GQueue[Index].Texture);
+		GQueueByPackage.Remove(GQueue[Index].PackageName);
+		GQueue[Index] = FQueuedRebuild();
+
+		if (GQueueIndex.IsEmpty())
+		{
+			ResetQueue();
+			return;
+		}
+
+		while (GQueue[GQueueHead].Texture.IsExplicitlyNull())
+		{
+			++GQueueHead;
+		}
+
+		if (GQueueHead >= 1024 && GQueueHead * 2 >= GQueue.Num())
+		{
+			GQueue.RemoveAt(0, GQueueHead);
+			for (TPair<TWeakObjectPtr<UTexture2D>, int32>& Pair : GQueueIndex)
+			{
+				Pair.Value -= GQueueHead;
+			}
+			for (TPair<FName, int32>& Pair : GQueueByPackage)
+			{
+				Pair.Value -= GQueueHead;
+			}
+			GQueueHead = 0;
+		}
+	}
+
+	// A texture already queued keeps its place
+	FQueuedRebuild& FindOrAddQueued(UTexture2D* Texture)
+	{
+		if (const int32* Existing = GQueueIndex.Find(Texture))
+		{
+			return GQueue[*Existing];
+		}
+
+		const int32 Index = GQueue.AddDefaulted();
+		GQueue[Index].Texture = Texture;
+		GQueue[Index].PackageName = Texture->GetOutermost()->GetFName();
+		GQueueIndex.Add(Texture, Index);
+		GQueueByPackage.Add(GQueue[Index].PackageName, Index);
+		return GQueue[Index];
+	}
+
+	int64 GetBuildingBytes()
+	{
+		int64 Bytes = 0;
+		for (const FRunningRebuild& Running : GRunning)
+		{
+			Bytes += Running.Bytes;
+		}
+		return Bytes;
+	}
+
+	void PublishCounters()
+	{
+		TRACE_COUNTER_SET(TextureManager_RebuildsQueued, GQueueIndex.Num());
+		TRACE_COUNTER_SET(TextureManager_RebuildsRunning, GRunning.Num());
+		TRACE_COUNTER_SET(TextureManager_RebuildMemory, GetBuildingBytes());
+	}
+
+	void ReapFinished()
+	{
+		TEXTURE_MANAGER_SCOPE("ReapFinishedRebuilds");
+		for (int32 Index = GRunning.Num() - 1; Index >= 0; --Index)
+		{
+			FRunningRebuild& Running = GRunning[Index];
+			UTexture2D* Texture = Running.Texture.Get();
+			if (Texture && Texture->IsCompiling())
+			{
+				continue;
+			}
+
+			if (Texture)
+			{
+				const double Seconds = FPlatformTime::Seconds() - Running.StartSeconds;
+				TextureRebuildCostModel::AddSample(Texture, Seconds / Running.Concurrency);
+				TextureManagerMetrics::AddSample(ETextureManagerPhase::Rebuild, Seconds);
+				++GNumDone;
+			}
+			GRunning.RemoveAtSwap(Index);
+		}
+	}
+
+	// Index of the next texture to start: the oldest priority one, else the
+	// oldest. Costs the size of the priority set (visible rows), not the queue.
+	int32 PickNext(const TSet<FName>& Priority)
+	{
+		int32 Best = INDEX_NONE;
+		for (const FName PackageName : Priority)
+		{
+			const int32* Index = GQueueByPackage.Find(PackageName);
+			if (Index && (Best == INDEX_NONE || *Index < Best))
+			{
+				Best = *Index;
+			}
+		}
+		if (Best != INDEX_NONE)
+		{
+			return Best;
+		}
+		return IsQueueEmpty() ? INDEX_NONE : GQueueHead;
+	}
+
+	void StartQueued()
+	{
+		if (IsQueueEmpty())
+		{
+			return;
+		}
+		TEXTURE_MANAGER_SCOPE("StartQueuedRebuilds");
+
+		TSet<FName> Priority;
+		GOnGatherPriority.Broadcast(Priority);
+
+		const int32 MaxInFlight = GetMaxInFlight();
+		const int64 Budget = GetMemoryBudget();
+		int64 BuildingBytes = GetBuildingBytes();
+
+		while (!IsQueueEmpty() && GRunning.Num() < MaxInFlight)
+		{
+			const int32 Index = PickNext(Priority);
+			UTexture2D* Texture = GQueue[Index].Texture.Get();
+			UTexturePresetAsset* Preset = GQueue[Index].Preset.Get();
+			if (!Texture || (!Preset && !GQueue[Index].Settings.IsSet()))
+			{
+				RemoveQueued(Index);
+				continue;
+			}
+
+			// One build alone may exceed the budget; it still has to run
+			const int64 Bytes = GetBuildMemory(Texture);
+			if (!GRunning.IsEmpty() && BuildingBytes + Bytes > Budget)
+			{
+				break;
+			}
+
+			const FGuid JournalBatch = GQueue[Index].JournalBatch;
+			const TOptional<FTexturePresetSettings> Settings = MoveTemp(GQueue[Index].Settings);
+			const uint64 FieldMask = GQueue[Index].FieldMask;
+			RemoveQueued(Index);
+
+			// Unchanged since it was queued (or changed back): leave it clean
+			const TArray<FName> Changed = Settings.IsSet()
+				? TexturePresetLibrary::DiffSettings(Settings.GetValue(), FieldMask, Texture)
+				: TexturePresetLibrary::DiffTexture(Preset, Texture);
+			if (Changed.IsEmpty())
+			{
+				continue;
+			}
+
+			// A journaled batch is undone by rolling it back, not through the transaction buffer
+			if (JournalBatch.IsValid())
+			{
+				TextureBulkJournal::Record(JournalBatch, Texture, Changed);
+			}
+			else
+			{
+				Texture->Modify();
+			}
+			if (Settings.IsSet())
+			{
+				TexturePresetLibrary::ApplySettingsToTexture(Settings.GetValue(), FieldMask, Texture);
+			}
+			else
+			{
+				TexturePresetLibrary::ApplyToTexture(Preset, Texture);
+			}
+
+			FRunningRebuild& Running = GRunning.AddDefaulted_GetRef();
+			Running.Texture = Texture;
+			Running.Bytes = Bytes;
+			Running.StartSeconds = FPlatformTime::Seconds();
+			Running.Concurrency = GRunning.Num();
+			BuildingBytes += Bytes;
+
+			Texture->PostEditChange();
+			Texture->MarkPackageDirty();
+		}
+	}
+
+	void OnQueueDrained()
+	{
+		// Once per batch; the samples of a 10k texture apply are one write
+		TextureRebuildCostModel::Save();
+		TextureBulkJournal::CloseBatches();
+		TextureBulkJournal::FinishRollbacks();
+		TextureBulkJournal::Prune(GetDefault<UTextureManagerSettings>()->JournalMaxBatches);
+		GOnDrained.Broadcast();
+	}
+
+	bool Tick(float DeltaTime)
+	{
+		ReapFinished();
+		if (!GPaused)
+		{
+			StartQueued();
+		}
+		PublishCounters();
+
+		if (IsQueueEmpty() && GRunning.IsEmpty())
+		{
+			GTickerHandle.Reset();
+			OnQueueDrained();
+			return false;
+		}
+
+		// Keep ticking while paused with nothing running, so Resume needs no restart
+		return true;
+	}
+
+	void EnsureTicking()
+	{
+		if (!GTickerHandle.IsValid())
+		{
+			GTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&Tick));
+		}
+	}
+}
+
+namespace TextureRebuildScheduler
+{
+	void Enqueue(UTexturePresetAsset* Preset, UTexture2D* Texture, const FGuid& JournalBatch)
+	{
+		check(IsInGameThread());
+		if (!Preset || !Texture)
+		{
+			return;
+		}
+
+		FQueuedRebuild& Queued = FindOrAddQueued(Texture);
+		Queued.Preset = Preset;
+		Queued.Settings.Reset();
+		Queued.JournalBatch = JournalBatch;
+		EnsureTicking();
+	}
+
+	void EnqueueSettings(const FTexturePresetSettings& Settings, uint64 FieldMask, UTexture2D* Texture)
+	{
+		check(IsInGameThread());
+		if (!Texture || FieldMask == 0)
+		{
+			return;
+		}
+
+		FQueuedRebuild& Queued = FindOrAddQueued(Texture);
+		Queued.Preset.Reset();
+		Queued.Settings = Settings;
+		Queued.FieldMask = FieldMask;
+		Queued.JournalBatch.Invalidate();
+		EnsureTicking();
+	}
+
+	void Pause()
+	{
+		GPaused = true;
+	}
+
+	void Resume()
+	{
+		GPaused = false;
+		if (!IsQueueEmpty())
+		{
+			EnsureTicking();
+		}
+	}
+
+	void Cancel()
+	{
+		UE_LOG(LogTemp, Log, TEXT("Texture rebuilds: %d cancelled, %d still running"), GQueueIndex.Num(), GRunning.Num());
+		ResetQueue();
+	}
+
+	void Flush()
+	{
+		check(IsInGameThread());
+		TEXTURE_MANAGER_SCOPE("FlushRebuilds");
+
+		// Still within the limits, just without waiting for the next tick
+		do
+		{
+			StartQueued();
+			PublishCounters();
+			FAssetCompilingManager::Get().FinishAllCompilation();
+			ReapFinished();
+		}
+		while (!IsQueueEmpty() || !GRunning.IsEmpty());
+		PublishCounters();
+
+		if (GTickerHandle.IsValid())
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(GTickerHandle);
+			GTickerHandle.Reset();
+		}
+		OnQueueDrained();
+	}
+
+	FTextureRebuildSchedulerState GetState()
+	{
+		FTextureRebuildSchedulerState State;
+		State.NumQueued = GQueueIndex.Num();
+		State.NumBuilding = GRunning.Num();
+		State.NumDone = GNumDone;
+		State.BuildingBytes = GetBuildingBytes();
+		State.bPaused = GPaused;
+		return State;
+	}
+
+	FOnGatherPriority& OnGatherPriority()
+	{
+		return GOnGatherPriority;
+	}
+
+	FSimpleMulticastDelegate& OnDrained()
+	{
+		return GOnDrained;
+	}
+}
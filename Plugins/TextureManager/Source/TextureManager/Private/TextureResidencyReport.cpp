@@ -0,0 +1,326 @@
+#include "TextureResidencyReport.h"
+
+#include "TexturePresetAsset.h"
+#include "TexturePresetClustering.h"
+#include "TexturePresetLibrary.h"
+#include "TexturePresetUserData.h"
+
+#include "Engine/Texture2D.h"
+#include "Engine/TextureLODSettings.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+	FName GetPresetLabel(const UTexturePresetAsset* Preset)
+	{
+		return Preset->PresetName.IsNone() ? Preset->GetFName() : Preset->PresetName;
+	}
+
+	FString GetGroupLabel(TextureGroup Group)
+	{
+		return StaticEnum<TextureGroup>()->GetDisplayNameTextByValue(Group).ToString();
+	}
+
+	int64 GetPoolSizeBytes()
+	{
+		// Reflects [SystemSettings] / device profile overrides from the ini files
+		if (IConsoleVariable* PoolSize = IConsoleManager::Get().FindConsoleVariable(TEXT("r.Streaming.PoolSize")))
+		{
+			return int64(FMath::Max(PoolSize->GetInt(), 0)) * 1024 * 1024;
+		}
+		return 0;
+	}
+
+	void SortTotals(TArray<FTextureResidencyTotal>& Totals)
+	{
+		Totals.Sort([](const FTextureResidencyTotal& A, const FTextureResidencyTotal& B)
+			{
+				return A.ResidentBytes > B.ResidentBytes;
+			});
+	}
+
+	FString FormatBytes(int64 Bytes)
+	{
+		return FText::AsMemory(Bytes).ToString();
+	}
+}
+
+namespace TextureResidencyReport
+{
+	FTextureResidencyReport Build()
+	{
+		check(IsInGameThread());
+
+		FTextureResidencyReport Report;
+		IAssetRegistry& Registry = IAssetRegistry::GetChecked();
+
+		// Presets are small; load them for their settings
+		TArray<FAssetData> PresetAssets;
+		Registry.GetAssetsByClass(UTexturePresetAsset::StaticClass()->GetClassPathName(), PresetAssets, true);
+
+		TMap<FName, const UTexturePresetAsset*> PresetsByPackage;
+		for (const FAssetData& Asset : PresetAssets)
+		{
+			if (const UTexturePresetAsset* Preset = Cast<UTexturePresetAsset>(Asset.GetAsset()))
+			{
+				PresetsByPackage.Add(Asset.PackageName, Preset);
+			}
+		}
+
+		TArray<FAssetData> TextureAssets;
+		Registry.GetAssetsByClass(UTexture2D::StaticClass()->GetClassPathName(), TextureAssets, true);
+
+		// 1) Everything that touches UObjects or the registry, on this thread
+		TArray<FTextureMemoryInputs> Inputs;
+		Inputs.Reserve(TextureAssets.Num());
+		Report.Entries.Reserve(TextureAssets.Num());
+
+		TArray<FName> Dependencies;
+		for (const FAssetData& Asset : TextureAssets)
+		{
+			UTexture2D* Texture = Cast<UTexture2D>(Asset.FastGetAsset(false));
+
+			// The assigned preset: from the user data when loaded, otherwise
+			// from the hard reference the user data leaves in the package
+			const UTexturePresetAsset* Preset = nullptr;
+			if (Texture)
+			{
+				if (const UTexturePresetUserData* UserData = Cast<UTexturePresetUserData>(
+					Texture->GetAssetUserDataOfClass(UTexturePresetUserData::StaticClass())))
+				{
+					Preset = UserData->AssignedPreset;
+				}
+			}
+			else
+			{
+				Dependencies.Reset();
+				Registry.GetDependencies(Asset.PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+				for (FName Dependency : Dependencies)
+				{
+					if (const UTexturePresetAsset* const* Found = PresetsByPackage.Find(Dependency))
+					{
+						Preset = *Found;
+						break;
+					}
+				}
+			}
+
+			FTexturePresetSettings PresetSettings = TexturePresetLibrary::ResolveSettings(Preset);
+			if (Preset && !Preset->bApplyAtCook)
+			{
+				TexturePresetLibrary::ClearCookOnlyOverrides(PresetSettings);
+			}
+
+			// A partial preset only decides its own fields
+			const uint64 FieldMask = TexturePresetLibrary::GetAppliedFieldMask(Preset);
+			if (Preset && FieldMask != TexturePresetLibrary::GetAllFieldsMask())
+			{
+				FTexturePresetSettings Effective = Texture
+					? TextureMemoryEstimator::GetTextureSettings(Texture)
+					: TexturePresetClustering::CaptureFromTags(Asset);
+				TexturePresetLibrary::CopyFields(PresetSettings, Effective, FieldMask);
+				PresetSettings = Effective;
+			}
+
+			FTextureMemoryInputs TextureInputs;
+			if (Texture)
+			{
+				TextureInputs = Preset
+					? TextureMemoryEstimator::MakeInputs(Texture, PresetSettings)
+					: TextureMemoryEstimator::MakeInputs(Texture, TextureMemoryEstimator::GetTextureSettings(Texture));
+			}
+			else if (!TextureMemoryEstimator::MakeInputs(Asset, Preset ? &PresetSettings : nullptr, TextureInputs))
+			{
+				continue;
+			}
+
+			FTextureResidencyEntry& Entry = Report.Entries.AddDefaulted_GetRef();
+			Entry.PackageName = Asset.PackageName;
+			Entry.AssetName = Asset.AssetName.ToString();
+			Entry.PresetName = Preset ? GetPresetLabel(Preset) : NAME_None;
+			Entry.Group = TextureInputs.Settings.TextureGroup;
+			Entry.bPinned = TextureInputs.Settings.NeverStream || TextureInputs.Settings.bForceMiplevelsToBeResident;
+
+			Inputs.Add(MoveTemp(TextureInputs));
+		}
+
+		// 2) Estimates are plain arithmetic; spread them over all cores
+		ParallelFor(Report.Entries.Num(), [&Report, &Inputs](int32 Index)
+			{
+				FTextureResidencyEntry& Entry = Report.Entries[Index];
+				Entry.Estimate = TextureMemoryEstimator::Estimate(Inputs[Index]);
+
+				if (Entry.bPinned)
+				{
+					FTextureMemoryInputs Streamed = Inputs[Index];
+					Streamed.Settings.NeverStream = false;
+					Streamed.Settings.bForceMiplevelsToBeResident = false;
+
+					const int64 StreamedResident = TextureMemoryEstimator::Estimate(Streamed).ResidentBytes;
+					Entry.PinnedExtraBytes = FMath::Max<int64>(Entry.Estimate.ResidentBytes - StreamedResident, 0);
+				}
+			});
+
+		// 3) Totals and ranking
+		TMap<FName, FTextureResidencyTotal> PresetTotals;
+		TMap<int32, FTextureResidencyTotal> GroupTotals;
+
+		for (const FTextureResidencyEntry& Entry : Report.Entries)
+		{
+			Report.Total.Add(Entry);
+
+			FTextureResidencyTotal& PresetTotal = PresetTotals.FindOrAdd(Entry.PresetName);
+			PresetTotal.Label = Entry.PresetName.IsNone() ? TEXT("<NONE>") : Entry.PresetName.ToString();
+			PresetTotal.Add(Entry);
+
+			FTextureResidencyTotal& GroupTotal = GroupTotals.FindOrAdd(Entry.Group);
+			GroupTotal.Label = GetGroupLabel(Entry.Group);
+			GroupTotal.Add(Entry);
+		}
+
+		PresetTotals.GenerateValueArray(Report.ByPreset);
+		GroupTotals.GenerateValueArray(Report.ByGroup);
+		SortTotals(Report.ByPreset);
+		SortTotals(Report.ByGroup);
+
+		Report.Entries.Sort([](const FTextureResidencyEntry& A, const FTextureResidencyEntry& B)
+			{
+				if (A.PinnedExtraBytes != B.PinnedExtraBytes)
+				{
+					return A.PinnedExtraBytes > B.PinnedExtraBytes;
+				}
+				return A.Estimate.ResidentBytes > B.Estimate.ResidentBytes;
+			});
+
+		// 4) Compare against the pool and the LOD group settings
+		Report.PoolSizeBytes = GetPoolSizeBytes();
+		Report.Total.Label = TEXT("Total");
+
+		if (Report.PoolSizeBytes > 0)
+		{
+			if (Report.Total.ResidentBytes > Report.PoolSizeBytes)
+			{
+				Report.Warnings.Add(FString::Printf(
+					TEXT("Always-resident textures (%s) exceed the streaming pool (%s)"),
+					*FormatBytes(Report.Total.ResidentBytes), *FormatBytes(Report.PoolSizeBytes)));
+			}
+			else if (Report.Total.ResidentBytes * 2 > Report.PoolSizeBytes)
+			{
+				Report.Warnings.Add(FString::Printf(
+					TEXT("Always-resident textures (%s) use more than half of the streaming pool (%s)"),
+					*FormatBytes(Report.Total.ResidentBytes), *FormatBytes(Report.PoolSizeBytes)));
+			}
+		}
+
+		if (const UTextureLODSettings* LODSettings = TextureMemoryEstimator::GetActiveLODSettings())
+		{
+			for (const TPair<int32, FTextureResidencyTotal>& Pair : GroupTotals)
+			{
+				const FTextureLODGroup& Group = LODSettings->GetTextureLODGroup(TextureGroup(Pair.Key));
+				const FTextureResidencyTotal& Total = Pair.Value;
+
+				if (Group.NumStreamedMips == 0)
+				{
+					Report.Warnings.Add(FString::Printf(
+						TEXT("%s: NumStreamedMips=0, all %d textures are fully resident (%s)"),
+						*Total.Label, Total.NumTextures, *FormatBytes(Total.ResidentBytes)));
+				}
+
+				if (Report.PoolSizeBytes > 0 && Total.ResidentBytes * 4 > Report.PoolSizeBytes)
+				{
+					Report.Warnings.Add(FString::Printf(
+						TEXT("%s: %s resident is over a quarter of the pool (MaxLODSize=%d, LODBias=%d)"),
+						*Total.Label, *FormatBytes(Total.ResidentBytes), Group.MaxLODSize, Group.LODBias));
+				}
+			}
+		}
+
+		for (const FTextureResidencyTotal& Total : Report.ByPreset)
+		{
+			if (Total.NumPinned > 0)
+			{
+				Report.Warnings.Add(FString::Printf(
+					TEXT("Preset %s pins %d textures (+%s resident)"),
+					*Total.Label, Total.NumPinned, *FormatBytes(Total.PinnedExtraBytes)));
+			}
+		}
+
+		return Report;
+	}
+
+	FString ToString(const FTextureResidencyReport& Report, int32 MaxOffenders)
+	{
+		FString Out;
+
+		auto AppendTotal = [&Out](const FTextureResidencyTotal& Total)
+			{
+				Out += FString::Printf(TEXT("  %-32s %5d textures  %5d pinned  resident %10s  pinned extra %10s  streamed %10s\n"),
+					*Total.Label, Total.NumTextures, Total.NumPinned,
+					*FormatBytes(Total.ResidentBytes), *FormatBytes(Total.PinnedExtraBytes), *FormatBytes(Total.StreamedBytes));
+			};
+
+		Out += TEXT("Texture residency report\n");
+		AppendTotal(Report.Total);
+		if (Report.PoolSizeBytes > 0)
+		{
+			Out += FString::Printf(TEXT("  Streaming pool (r.Streaming.PoolSize): %s\n"), *FormatBytes(Report.PoolSizeBytes));
+		}
+
+		Out += TEXT("\nBy preset\n");
+		for (const FTextureResidencyTotal& Total : Report.ByPreset)
+		{
+			AppendTotal(Total);
+		}
+
+		Out += TEXT("\nBy texture group\n");
+		for (const FTextureResidencyTotal& Total : Report.ByGroup)
+		{
+			AppendTotal(Total);
+		}
+
+		Out += TEXT("\nWorst offenders\n");
+		for (int32 Index = 0; Index < FMath::Min(MaxOffenders, Report.Entries.Num()); ++Index)
+		{
+			const FTextureResidencyEntry& Entry = Report.Entries[Index];
+			Out += FString::Printf(TEXT("  %-40s %-20s %dx%d  resident %10s  pinned extra %10s\n"),
+				*Entry.AssetName,
+				Entry.PresetName.IsNone() ? TEXT("<NONE>") : *Entry.PresetName.ToString(),
+				Entry.Estimate.SizeX, Entry.Estimate.SizeY,
+				*FormatBytes(Entry.Estimate.ResidentBytes), *FormatBytes(Entry.PinnedExtraBytes));
+		}
+
+		if (Report.Warnings.Num() > 0)
+		{
+			Out += TEXT("\nWarnings\n");
+			for (const FString& Warning : Report.Warnings)
+			{
+				Out += TEXT("  ") + Warning + TEXT("\n");
+			}
+		}
+
+		return Out;
+	}
+
+	bool SaveCsv(const FTextureResidencyReport& Report, const FString& FilePath)
+	{
+		TArray<FString> Lines;
+		Lines.Reserve(Report.Entries.Num() + 1);
+		Lines.Add(TEXT("Package,Preset,Group,Pinned,SizeX,SizeY,Mips,ResidentBytes,StreamedBytes,PinnedExtraBytes"));
+
+		for (const FTextureResidencyEntry& Entry : Report.Entries)
+		{
+			Lines.Add(FString::Printf(TEXT("%s,%s,%s,%d,%d,%d,%d,%lld,%lld,%lld"),
+				*Entry.PackageName.ToString(),
+				Entry.PresetName.IsNone() ? TEXT("") : *Entry.PresetName.ToString(),
+				*GetGroupLabel(Entry.Group),
+				Entry.bPinned ? 1 : 0,
+				Entry.Estimate.SizeX, Entry.Estimate.SizeY, Entry.Estimate.NumMips,
+				Entry.Estimate.ResidentBytes, Entry.Estimate.StreamedBytes, Entry.PinnedExtraBytes));
+		}
+
+		return FFileHelper::SaveStringArrayToFile(Lines, *FilePath);
+	}
+}
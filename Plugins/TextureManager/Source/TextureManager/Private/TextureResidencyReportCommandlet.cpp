@@ -0,0 +1,46 @@
+#include "TextureResidencyReportCommandlet.h"
+
+#include "TextureResidencyReport.h"
+
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/Paths.h"
+
+UTextureResidencyReportCommandlet::UTextureResidencyReportCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UTextureResidencyReportCommandlet::Main(const FString& Params)
+{
+	// The report reads registry metadata only; make sure it is complete
+	IAssetRegistry::GetChecked().SearchAllAssets(true);
+
+	FString CsvPath = FPaths::ProjectSavedDir() / TEXT("TextureManager") / TEXT("ResidencyReport.csv");
+	FParse::Value(*Params, TEXT("csv="), CsvPath);
+
+	int32 MaxOffenders = 20;
+	FParse::Value(*Params, TEXT("top="), MaxOffenders);
+
+	const FTextureResidencyReport Report = TextureResidencyReport::Build();
+
+	TArray<FString> Lines;
+	TextureResidencyReport::ToString(Report, MaxOffenders).ParseIntoArrayLines(Lines, false);
+	for (const FString& Line : Lines)
+	{
+		UE_LOG(LogTemp, Display, TEXT("%s"), *Line);
+	}
+
+	if (!TextureResidencyReport::SaveCsv(Report, CsvPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Could not write %s"), *CsvPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Wrote %d textures to %s"), Report.Entries.Num(), *CsvPath);
+
+	// Non-zero when the always-resident set doesn't fit the pool, so CI can gate on it
+	return (Report.PoolSizeBytes > 0 && Report.Total.ResidentBytes > Report.PoolSizeBytes) ? 2 : 0;
+}
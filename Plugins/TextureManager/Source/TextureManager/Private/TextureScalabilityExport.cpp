@@ -0,0 +1,222 @@
+#include "TextureScalabilityExport.h"
+
+#include "TextureManagerMetrics.h"
+#include "TexturePresetAsset.h"
+#include "TextureScalabilitySettings.h"
+#include "TextureScalabilityTable.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Containers/Ticker.h"
+#include "Engine/Texture2D.h"
+#include "FileHelpers.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopedSlowTask.h"
+#include "UObject/ICookInfo.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+
+#define LOCTEXT_NAMESPACE "TextureScalabilityExport"
+
+namespace
+{
+	constexpr int32 MaxInheritanceDepth = 16;
+
+	const TCHAR* DefaultTablePath = TEXT("/Game/TextureManager/TextureScalabilityTable.TextureScalabilityTable");
+
+	bool ChangesAnything(const TArray<FTextureScalabilityTier>& Tiers)
+	{
+		return Tiers.ContainsByPredicate([](const FTextureScalabilityTier& Tier)
+			{
+				return Tier.LODBiasOffset != 0 || !Tier.bKeepResident;
+			});
+	}
+
+	UTextureScalabilityTable* FindOrCreateTable(const FSoftObjectPath& Path)
+	{
+		if (UTextureScalabilityTable* Existing = Cast<UTextureScalabilityTable>(Path.TryLoad()))
+		{
+			return Existing;
+		}
+
+		UPackage* Package = CreatePackage(*Path.GetLongPackageName());
+		if (!Package)
+		{
+			return nullptr;
+		}
+		Package->FullyLoad();
+
+		UTextureScalabilityTable* Table = NewObject<UTextureScalabilityTable>(
+			Package, FName(*Path.GetAssetName()), RF_Public | RF_Standalone | RF_Transactional);
+
+		FAssetRegistryModule& AssetRegistryModule =
+			FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+		AssetRegistryModule.AssetCreated(Table);
+		return Table;
+	}
+
+	bool EntriesEqual(const TArray<FTextureScalabilityEntry>& A, const TArray<FTextureScalabilityEntry>& B)
+	{
+		if (A.Num() != B.Num())
+		{
+			return false;
+		}
+		for (int32 Index = 0; Index < A.Num(); ++Index)
+		{
+			if (!FTextureScalabilityEntry::StaticStruct()->CompareScriptStruct(&A[Index], &B[Index], PPF_None))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	FDelegateHandle GPreSaveHandle;
+	FDelegateHandle GCookStartedHandle;
+	FTSTicker::FDelegateHandle GPendingRebuildHandle;
+
+	bool HasTable()
+	{
+		return !GetDefault<UTextureScalabilitySettings>()->Table.IsNull();
+	}
+
+	void OnObjectPreSave(UObject* Object, FObjectPreSaveContext Context)
+	{
+		if (!Context.IsProceduralSave() && Cast<UTexturePresetAsset>(Object) && HasTable()
+			&& !GPendingRebuildHandle.IsValid())
+		{
+			// Not from inside the save; once the preset is on disk
+			GPendingRebuildHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([](float)
+				{
+					GPendingRebuildHandle.Reset();
+					TextureScalabilityExport::BuildTable();
+					return false;
+				}));
+		}
+	}
+
+	void OnCookStarted(UE::Cook::ICookInfo& CookInfo)
+	{
+		// The cook writes what is in memory; nothing is saved back
+		if (HasTable())
+		{
+			TextureScalabilityExport::BuildTable(false);
+		}
+	}
+}
+
+namespace TextureScalabilityExport
+{
+	const TArray<FTextureScalabilityTier>* FindTiers(const UTexturePresetAsset* Preset)
+	{
+		for (int32 Depth = 0; Preset && Depth < MaxInheritanceDepth; ++Depth)
+		{
+			if (!Preset->ScalabilityTiers.IsEmpty())
+			{
+				return &Preset->ScalabilityTiers;
+			}
+			Preset = Preset->ParentPreset;
+		}
+		return nullptr;
+	}
+
+	UTextureScalabilityTable* BuildTable(bool bSave)
+	{
+		UTextureScalabilitySettings* Settings = GetMutableDefault<UTextureScalabilitySettings>();
+		if (Settings->Table.IsNull())
+		{
+			Settings->Table = TSoftObjectPtr<UTextureScalabilityTable>(FSoftObjectPath(DefaultTablePath));
+			Settings->TryUpdateDefaultConfigFile();
+		}
+
+		UTextureScalabilityTable* Table = FindOrCreateTable(Settings->Table.ToSoftObjectPath());
+		if (!Table)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Texture scalability: could not create %s"), *Settings->Table.ToString());
+			return nullptr;
+		}
+
+		TArray<FAssetData> PresetAssets;
+		IAssetRegistry::GetChecked().GetAssetsByClass(UTexturePresetAsset::StaticClass()->GetClassPathName(), PresetAssets, true);
+
+		FScopedSlowTask SlowTask(float(PresetAssets.Num()), LOCTEXT("BuildingTable", "Building texture scalability table..."));
+		SlowTask.MakeDialogDelayed(0.5f);
+
+		TArray<FTextureScalabilityEntry> Entries;
+		int32 NumPackages = 0;
+		for (const FAssetData& Asset : PresetAssets)
+		{
+			SlowTask.EnterProgressFrame(1);
+
+			const UTexturePresetAsset* Preset = Cast<UTexturePresetAsset>(Asset.GetAsset());
+			const TArray<FTextureScalabilityTier>* Tiers = FindTiers(Preset);
+			if (!Tiers || !ChangesAnything(*Tiers))
+			{
+				continue;
+			}
+
+			FTextureScalabilityEntry& Entry = Entries.AddDefaulted_GetRef();
+			Entry.Preset = Asset.AssetName;
+			Entry.Tiers = *Tiers;
+			for (const UTexture2D* Texture : Preset->Files)
+			{
+				if (Texture)
+				{
+					Entry.Packages.AddUnique(Texture->GetOutermost()->GetFName());
+				}
+			}
+			NumPackages += Entry.Packages.Num();
+		}
+
+		// Stable order keeps the asset diff small
+		Entries.Sort([](const FTextureScalabilityEntry& A, const FTextureScalabilityEntry& B)
+			{
+				return A.Preset.LexicalLess(B.Preset);
+			});
+
+		if (EntriesEqual(Table->Entries, Entries))
+		{
+			return Table;
+		}
+
+		Table->Modify();
+		Table->Entries = MoveTemp(Entries);
+		Table->MarkPackageDirty();
+
+		if (bSave)
+		{
+			FTextureManagerPhaseScope Phase(ETextureManagerPhase::Save);
+			FEditorFileUtils::PromptForCheckoutAndSave(
+				{ Table->GetOutermost() },
+				/*bCheckDirty=*/false,
+				/*bPromptToSave=*/false);
+			TextureManagerMetrics::AddPackagesSaved(1);
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("Texture scalability: %d presets, %d textures written to %s"),
+			Table->Entries.Num(), NumPackages, *Table->GetPathName());
+		return Table;
+	}
+
+	void Register()
+	{
+		GCookStartedHandle = UE::Cook::FDelegates::CookByTheBookStarted.AddStatic(&OnCookStarted);
+		if (GIsEditor && !IsRunningCommandlet())
+		{
+			GPreSaveHandle = FCoreUObjectDelegates::OnObjectPreSave.AddStatic(&OnObjectPreSave);
+		}
+	}
+
+	void Unregister()
+	{
+		UE::Cook::FDelegates::CookByTheBookStarted.Remove(GCookStartedHandle);
+		FCoreUObjectDelegates::OnObjectPreSave.Remove(GPreSaveHandle);
+		if (GPendingRebuildHandle.IsValid())
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(GPendingRebuildHandle);
+			GPendingRebuildHandle.Reset();
+		}
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,306 @@
+#include "TextureThumbnailCache.h"
+
+#include "Engine/Texture2D.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Brushes/SlateDynamicImageBrush.h"
+#include "Framework/Application/SlateApplication.h"
+#include "ImageCore.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "Tasks/Task.h"
+
+FTextureThumbnailCache::FTextureThumbnailCache(int32 InThumbnailSize, int32 InMaxEntries, int32 InMaxInFlight)
+	: ThumbnailSize(FMath::Max(InThumbnailSize, 8))
+	, MaxInFlight(FMath::Max(InMaxInFlight, 1))
+	, Brushes(FMath::Max(InMaxEntries, 1))
+{
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FTextureThumbnailCache::Tick),
+		0.0f);
+}
+
+FTextureThumbnailCache::~FTextureThumbnailCache()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	// Workers read straight from the texture; make sure none is still running
+	// before the strong references below are released
+	for (TPair<FName, FThumbnailRequest>& Pair : InFlight)
+	{
+		Pair.Value.Result->bCancelled = true;
+	}
+	for (TPair<FName, FThumbnailRequest>& Pair : InFlight)
+	{
+		Pair.Value.Task.Wait();
+	}
+}
+
+const FSlateBrush* FTextureThumbnailCache::GetThumbnail(const FAssetData& Asset)
+{
+	if (!Asset.IsValid())
+	{
+		return nullptr;
+	}
+
+	// Never load a texture for its thumbnail; unloaded ones only get the disk cache
+	return FindOrQueue(Asset.PackageName, Cast<UTexture2D>(Asset.FastGetAsset(false)));
+}
+
+const FSlateBrush* FTextureThumbnailCache::GetThumbnail(UTexture2D* Texture)
+{
+	if (!Texture)
+	{
+		return nullptr;
+	}
+
+	return FindOrQueue(Texture->GetOutermost()->GetFName(), Texture);
+}
+
+const FSlateBrush* FTextureThumbnailCache::FindOrQueue(FName PackageName, UTexture2D* Texture)
+{
+	if (const TSharedPtr<FSlateDynamicImageBrush>* Found = Brushes.FindAndTouch(PackageName))
+	{
+		return Found->Get();
+	}
+
+	if (Unavailable.Contains(PackageName) || InFlight.Contains(PackageName))
+	{
+		return nullptr;
+	}
+
+	// Nothing on disk last time; only a loaded texture can do better
+	if (!Texture && NotOnDisk.Contains(PackageName))
+	{
+		return nullptr;
+	}
+	NotOnDisk.Remove(PackageName);
+
+	for (const FThumbnailRequest& Existing : Queued)
+	{
+		if (Existing.PackageName == PackageName)
+		{
+			return nullptr;
+		}
+	}
+
+	FThumbnailRequest& Request = Queued.AddDefaulted_GetRef();
+	Request.PackageName = PackageName;
+	Request.Texture.Reset(Texture);
+
+	// The saved hash only describes what is on disk; a dirty package may differ
+	const bool bDirty = Texture && Texture->GetOutermost()->IsDirty();
+	if (!bDirty)
+	{
+		if (TOptional<FAssetPackageData> PackageData = IAssetRegistry::GetChecked().GetAssetPackageDataCopy(PackageName))
+		{
+			Request.PackageHash = PackageData->GetPackageSavedHash();
+		}
+	}
+
+	return nullptr;
+}
+
+void FTextureThumbnailCache::CancelRequest(FName PackageName)
+{
+	Queued.RemoveAll([PackageName](const FThumbnailRequest& Request)
+		{
+			return Request.PackageName == PackageName;
+		});
+
+	if (FThumbnailRequest* Request = InFlight.Find(PackageName))
+	{
+		// The worker notices on its next check; Tick() drops the result
+		Request->Result->bCancelled = true;
+	}
+}
+
+bool FTextureThumbnailCache::Tick(float DeltaTime)
+{
+	// 1) Collect finished work
+	for (auto It = InFlight.CreateIterator(); It; ++It)
+	{
+		FThumbnailRequest& Request = It.Value();
+		if (!Request.Result->bFinished)
+		{
+			continue;
+		}
+
+		if (!Request.Result->bCancelled)
+		{
+			if (Request.Result->Pixels.Num() > 0)
+			{
+				AddBrush(Request.PackageName, Request.Result->Width, Request.Result->Height, Request.Result->Pixels);
+			}
+			else if (Request.Texture.IsValid())
+			{
+				// Had the texture and still got nothing: no usable source data
+				Unavailable.Add(Request.PackageName);
+			}
+			else
+			{
+				// Not loaded and not on disk: asking again every frame finds nothing either
+				NotOnDisk.Add(Request.PackageName);
+			}
+		}
+
+		It.RemoveCurrent();
+	}
+
+	// 2) Start queued work, oldest first
+	while (InFlight.Num() < MaxInFlight && Queued.Num() > 0)
+	{
+		FThumbnailRequest Request = MoveTemp(Queued[0]);
+		Queued.RemoveAt(0);
+
+		const FName PackageName = Request.PackageName;
+		Dispatch(Request);
+		InFlight.Add(PackageName, MoveTemp(Request));
+	}
+
+	return true;
+}
+
+void FTextureThumbnailCache::Dispatch(FThumbnailRequest& Request)
+{
+	Request.Result = MakeShared<FThumbnailResult, ESPMode::ThreadSafe>();
+
+	const FString DiskPath = Request.PackageHash.IsZero()
+		? FString()
+		: GetDiskCachePath(Request.PackageHash);
+
+	UTexture2D* Texture = Request.Texture.Get();
+
+	// Pick the smallest source mip that is still at least thumbnail sized
+	int32 SourceMip = 0;
+#if WITH_EDITOR
+	if (Texture && Texture->Source.IsValid())
+	{
+		const int32 NumMips = Texture->Source.GetNumMips();
+		while (SourceMip + 1 < NumMips
+			&& FMath::Max(Texture->Source.GetSizeX(), Texture->Source.GetSizeY()) >> (SourceMip + 1) >= ThumbnailSize)
+		{
+			++SourceMip;
+		}
+	}
+	else
+	{
+		Texture = nullptr;
+	}
+#else
+	Texture = nullptr;
+#endif
+
+	Request.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[Result = Request.Result, Texture, SourceMip, DiskPath, Size = ThumbnailSize]()
+		{
+			ON_SCOPE_EXIT
+			{
+				Result->bFinished = true;
+			};
+
+			if (Result->bCancelled)
+			{
+				return;
+			}
+
+			// 1) On-disk cache: int32 width, int32 height, BGRA8 pixels
+			if (!DiskPath.IsEmpty())
+			{
+				TArray<uint8> Bytes;
+				if (FFileHelper::LoadFileToArray(Bytes, *DiskPath, FILEREAD_Silent) && Bytes.Num() > 8)
+				{
+					int32 Width = 0;
+					int32 Height = 0;
+					FMemory::Memcpy(&Width, Bytes.GetData(), sizeof(int32));
+					FMemory::Memcpy(&Height, Bytes.GetData() + sizeof(int32), sizeof(int32));
+
+					if (Width > 0 && Height > 0 && Bytes.Num() == 8 + Width * Height * 4)
+					{
+						Result->Width = Width;
+						Result->Height = Height;
+						Result->Pixels.Append(Bytes.GetData() + 8, Bytes.Num() - 8);
+						return;
+					}
+				}
+			}
+
+#if WITH_EDITOR
+			// 2) Decode the source mip. This touches source bulk data only,
+			// never the platform data, so no derived-data build is triggered.
+			if (!Texture || Result->bCancelled)
+			{
+				return;
+			}
+
+			FImage SourceImage;
+			if (!Texture->Source.GetMipImage(SourceImage, 0, 0, SourceMip))
+			{
+				return;
+			}
+
+			if (Result->bCancelled || SourceImage.SizeX <= 0 || SourceImage.SizeY <= 0)
+			{
+				return;
+			}
+
+			// Keep the aspect ratio, longest side = Size
+			int32 Width = Size;
+			int32 Height = Size;
+			if (SourceImage.SizeX > SourceImage.SizeY)
+			{
+				Height = FMath::Max(1, Size * SourceImage.SizeY / SourceImage.SizeX);
+			}
+			else if (SourceImage.SizeY > SourceImage.SizeX)
+			{
+				Width = FMath::Max(1, Size * SourceImage.SizeX / SourceImage.SizeY);
+			}
+
+			FImage Thumbnail;
+			SourceImage.ResizeTo(Thumbnail, Width, Height, ERawImageFormat::BGRA8, EGammaSpace::sRGB);
+
+			Result->Width = Width;
+			Result->Height = Height;
+			Result->Pixels.Append(Thumbnail.RawData.GetData(), Thumbnail.RawData.Num());
+
+			if (!DiskPath.IsEmpty())
+			{
+				TArray<uint8> Bytes;
+				Bytes.Reserve(8 + Result->Pixels.Num());
+				Bytes.Append(reinterpret_cast<const uint8*>(&Width), sizeof(int32));
+				Bytes.Append(reinterpret_cast<const uint8*>(&Height), sizeof(int32));
+				Bytes.Append(Result->Pixels);
+				FFileHelper::SaveArrayToFile(Bytes, *DiskPath);
+			}
+#endif
+		},
+		UE::Tasks::ETaskPriority::BackgroundNormal);
+}
+
+void FTextureThumbnailCache::AddBrush(FName PackageName, int32 Width, int32 Height, const TArray<uint8>& Pixels)
+{
+	if (!FSlateApplication::IsInitialized())
+	{
+		return;
+	}
+
+	const FName ResourceName(*FString::Printf(TEXT("TPMThumbnail_%s"), *PackageName.ToString()));
+
+	TSharedPtr<FSlateDynamicImageBrush> Brush = FSlateDynamicImageBrush::CreateWithImageData(
+		ResourceName,
+		FVector2D(Width, Height),
+		Pixels);
+
+	if (Brush.IsValid())
+	{
+		// Evicts the least recently drawn thumbnail once full
+		Brushes.Add(PackageName, Brush);
+	}
+}
+
+FString FTextureThumbnailCache::GetDiskCachePath(const FIoHash& Hash) const
+{
+	return FPaths::ProjectSavedDir() / TEXT("TextureManager") / TEXT("Thumbnails")
+		/ FString::Printf(TEXT("%s_%d.thumb"), *LexToString(Hash), ThumbnailSize);
+}
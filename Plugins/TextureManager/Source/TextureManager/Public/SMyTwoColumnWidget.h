@@ -4,54 +4,67 @@
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/DeclarativeSyntaxSupport.h"
 #include "Widgets/Views/SListView.h"
+#include "Widgets/Views/STreeView.h"
 #include "Widgets/Input/STextComboBox.h"
 #include "Widgets/Input/SSegmentedControl.h"
 #include "UObject/WeakObjectPtrTemplates.h"
-#include "Stats/Stats.h"
+#include "AssetRegistry/AssetData.h"
+#include "TextureManagerStats.h"
+#include "TextureMemoryEstimator.h"
+#include "TextureDuplicateFinder.h"
+#include "TextureCompressionOptimizer.h"
+#include "TexturePresetClustering.h"
 
 class IDetailsView;
+class FTextureThumbnailCache;
+class FTexturePreviewPool;
 class UTexture2D;
 class UTexturePresetAsset;
 struct FPropertyChangedEvent;
 
-DECLARE_STATS_GROUP(TEXT("Texture Preset Manager"), STATGROUP_TPM, STATCAT_Advanced);
+// Which "mode" the right side is in
+enum class ENavigationTab : uint8
+{
+	Files,
+	Presets
+};
 
-DECLARE_CYCLE_STAT(TEXT("Texture Preset Manager|OnSaveButtonClicked"),
-	STAT_TextureManager_OnSaveButtonClicked,
-	STATGROUP_TPM);
+// How the Files tab lays out its textures
+enum class ETextureGrouping : uint8
+{
+	Flat,
+	ByPreset,
+	ByFolder,
+	Duplicates
+};
 
-DECLARE_CYCLE_STAT(TEXT("Texture Preset Manager|OnPresetSaveButtonClicked"),
-	STAT_TextureManager_OnPresetSaveButtonClicked,
-	STATGROUP_TPM);
+// One node of the grouped Files tree. Group nodes only keep the asset data of
+// everything underneath them; child nodes are created the first time the group
+// is expanded so large projects don't pay for rows nobody looks at.
+struct FTextureTreeNode
+{
+	FString Label;
 
-// Wall-clock ms spent inside OnSaveButtonClicked (persistent accumulator).
-DECLARE_FLOAT_COUNTER_STAT(
-	TEXT("Texture Preset Manager|OnSaveButtonClicked Wall Time (ms)"),
-	STAT_TextureManager_OnSaveButtonClickedWallMs,
-	STATGROUP_TPM);
+	// Leaf: the texture this row stands for
+	FAssetData Asset;
 
-// Number of times OnSaveButtonClicked has run (persistent accumulator).
-DECLARE_DWORD_ACCUMULATOR_STAT(
-	TEXT("Texture Preset Manager|OnSaveButtonClicked Calls"),
-	STAT_TextureManager_OnSaveButtonClickedCalls,
-	STATGROUP_TPM);
+	// Group: every texture below this node (not yet turned into child nodes)
+	TArray<FAssetData> PendingAssets;
+	TArray<TSharedPtr<FTextureTreeNode>> Children;
 
-// Wall-clock accumulators for OnPresetSaveButtonClicked
-DECLARE_FLOAT_COUNTER_STAT(
-	TEXT("Texture Preset Manager|OnPresetSaveButtonClicked Wall Time (ms)"),
-	STAT_TextureManager_OnPresetSaveButtonClickedWallMs,
-	STATGROUP_TPM);
+	// ByFolder groups split further into sub folders on expansion
+	FString FolderPath;
+	bool bFolderGroup = false;
 
-DECLARE_DWORD_ACCUMULATOR_STAT(
-	TEXT("Texture Preset Manager|OnPresetSaveButtonClicked Calls"),
-	STAT_TextureManager_OnPresetSaveButtonClickedCalls,
-	STATGROUP_TPM);
+	bool bIsGroup = false;
+	bool bChildrenMaterialized = false;
 
-// Which "mode" the right side is in
-enum class ENavigationTab : uint8
-{
-	Files,
-	Presets
+	int32 NumTextures = 0;
+	int64 MemoryBytes = 0;
+
+	// Duplicates groups: index into DuplicateClusters
+	int32 ClusterIndex = INDEX_NONE;
+	int64 WastedBytes = 0;
 };
 
 class SMyTwoColumnWidget : public SCompoundWidget
@@ -86,6 +99,7 @@ private:
 	// ---------- Types ----------
 	using FTextureItem = TWeakObjectPtr<UTexture2D>;
 	using FPresetItem = TWeakObjectPtr<UTexturePresetAsset>;
+	using FTextureTreeItem = TSharedPtr<FTextureTreeNode>;
 
 	// ---------- State ----------
 
@@ -100,6 +114,37 @@ private:
 	TArray<FTextureItem> FilteredTextureItems;
 	TSharedPtr<SListView<FTextureItem>> TextureListView;
 
+	// The tree works from AllTextureAssets; the items are only loaded once
+	// the flat list or a whole-list action needs them
+	bool bTextureItemsLoaded = false;
+	void EnsureTextureItemsLoaded();
+
+	// Files tree (grouped alternative to the flat list)
+	ETextureGrouping Grouping = ETextureGrouping::Flat;
+	TArray<FAssetData> AllTextureAssets;
+	TArray<FTextureTreeItem> TextureTreeRoots;
+	TArray<FTextureTreeItem> CollapsedPlaceholder;
+	TSharedPtr<STreeView<FTextureTreeItem>> TextureTreeView;
+
+	// Duplicates grouping; rebuilt with the tree
+	TArray<FTextureDuplicateCluster> DuplicateClusters;
+	bool bDuplicateHashingRunning = false;
+
+	// Row thumbnails; rows remember their package so a released row can
+	// cancel its pending request
+	TSharedPtr<FTextureThumbnailCache> ThumbnailCache;
+	TMap<const ITableRow*, FName> ThumbnailRowPackages;
+
+	// Memory estimate per texture package for the tree's group totals, with
+	// the source id it was made for (zero = from registry tags). An entry is
+	// dropped when its texture changes.
+	struct FCachedMemoryEstimate
+	{
+		FGuid SourceId;
+		int64 Bytes = 0;
+	};
+	mutable TMap<FName, FCachedMemoryEstimate> MemoryEstimates;
+
 	// Presets list (right / Presets tab)
 	//TArray<FPresetItem> PresetItems;
 	TArray<FPresetItem> AllPresetItems;
@@ -110,6 +155,8 @@ private:
 	FTextureItem SelectedTexture;
 	FPresetItem  SelectedPreset;
 
+	// Copies shown in the details view; owned by PreviewPool
+	TSharedPtr<FTexturePreviewPool> PreviewPool;
 	UTexture2D* PreviewTexture = nullptr;
 	UTexturePresetAsset* PreviewPreset = nullptr;
 
@@ -133,6 +180,35 @@ private:
 	FString FilesSearchQuery;
 	FString PresetsSearchQuery;
 
+	// Set while a background alpha scan is running
+	bool bAlphaAnalysisRunning = false;
+
+	// Set while a background content scan is running
+	bool bContentAnalysisRunning = false;
+
+	// Filtered textures with a suggested preset; counted by UpdateContentStatus
+	// when the lists or the analysis change, not on every paint
+	int32 NumSuggestedTextures = 0;
+
+	// Alpha-free preset for the selected texture, by UpdateAlphaSuggestion
+	// when the selection, the presets or the analysis change
+	TWeakObjectPtr<UTexturePresetAsset> AlphaSuggestedPreset;
+	void UpdateAlphaSuggestion();
+
+	// Settings groups of the unassigned textures, from the last Group By Settings
+	FTextureClusteringResult SettingsClusters;
+
+	// Compression optimizer: set while it runs, and the outcome of the last run
+	bool bOptimizerRunning = false;
+	FText OptimizerStatus;
+
+	// Textures this tab queued are saved once the scheduler has rebuilt them
+	bool bSaveWhenRebuildsDone = false;
+
+	// Linked textures of the selected preset: as saved, and with the edits in the details panel
+	FTextureMemoryEstimate PresetMemoryCurrent;
+	FTextureMemoryEstimate PresetMemoryPreview;
+
 	// Dirty flag when the selected texture's settings diverge from its preset
 	bool bPendingPresetChange = false;
 	bool bPendingPropertyChange = false;
@@ -146,9 +222,77 @@ private:
 	TSharedRef<SWidget> BuildRightColumn();
 	TSharedRef<SWidget> BuildFilesList();
 	TSharedRef<SWidget> BuildPresetsList();
+	TSharedRef<SWidget> BuildTextureTree();
 
 	TSharedRef<ITableRow> GenerateTextureRow(FTextureItem Item, const TSharedRef<STableViewBase>& OwnerTable);
 	TSharedRef<ITableRow> GeneratePresetRow(FPresetItem Item, const TSharedRef<STableViewBase>& OwnerTable);
+	TSharedRef<ITableRow> GenerateTreeRow(FTextureTreeItem Item, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnTextureRowReleased(const TSharedRef<ITableRow>& Row);
+	FText GetTextureRowLabel(FTextureItem Item) const;
+
+	// ---------- Alpha analysis ----------
+
+	FText GetAlphaStatusText() const;
+	EVisibility GetAlphaSuggestionVisibility() const;
+	FReply OnAnalyzeAlphaClicked();
+	FReply OnApplyAlphaSuggestionClicked();
+
+	// ---------- Content suggestions (unassigned textures) ----------
+
+	EVisibility GetContentSuggestionVisibility() const;
+	FText GetContentStatusText() const;
+	void UpdateContentStatus();
+	UTexturePresetAsset* GetSuggestedPreset(const UTexture2D* Texture) const;
+	FReply OnSuggestPresetsClicked();
+	FReply OnApplySuggestionsClicked();
+
+	// ---------- Settings clustering (unassigned textures) ----------
+
+	FText GetClusteringStatusText() const;
+	FReply OnClusterSettingsClicked();
+	FReply OnAssignClustersClicked();
+
+	// ---------- Compression optimizer ----------
+
+	FText GetOptimizerStatusText() const { return OptimizerStatus; }
+	FReply OnOptimizeCompressionClicked();
+	void OnOptimizerComplete(const FTextureOptimizerResult& Result, UTexturePresetAsset* Preset);
+
+	// ---------- Memory estimate (Presets tab) ----------
+
+	void RefreshPresetMemoryEstimate();
+	FText GetPresetMemoryText() const;
+
+	// ---------- Rebuild scheduler ----------
+
+	FText GetRebuildStatusText() const;
+	void GatherRebuildPriority(TSet<FName>& OutPackages);
+	void OnRebuildsDrained();
+
+	EVisibility IsPresetsChosen() const
+	{
+		return ActiveTab == ENavigationTab::Presets ? EVisibility::Visible : EVisibility::Collapsed;
+	}
+
+	// ---------- Grouped tree ----------
+
+	ETextureGrouping GetGrouping() const { return Grouping; }
+	void OnGroupingChanged(ETextureGrouping NewGrouping);
+
+	void RebuildTextureTree();
+	FTextureTreeItem MakeGroupNode(const FString& Label, TArray<FAssetData>&& Assets) const;
+	void MaterializeChildren(const FTextureTreeItem& Node) const;
+	void OnGetTreeChildren(FTextureTreeItem Item, TArray<FTextureTreeItem>& OutChildren);
+	void OnTreeSelectionChanged(FTextureTreeItem Item, ESelectInfo::Type SelectInfo);
+
+	int64 GetAssetMemoryBytes(const FAssetData& Asset) const;
+
+	// ---------- Duplicates ----------
+
+	EVisibility GetDuplicatesVisibility() const;
+	FText GetDuplicatesStatusText() const;
+	FReply OnFindDuplicatesClicked();
+	FReply OnConsolidateDuplicatesClicked();
 
 	// ---------- Tab / selection logic ----------
 
@@ -169,6 +313,7 @@ private:
 	FReply OnSaveButtonClicked();
 	FReply OnPresetSaveButtonClicked();
 	FReply OnPresetNewButtonClicked();
+	FReply OnMergePresetsClicked();
 
 	// ---------- Change detection ----------
 
@@ -192,7 +337,6 @@ private:
 		return ActiveTab == ENavigationTab::Files;
 	}
 
-	UTexture2D* CloneTextureTransient(UTexture2D* Source);
 	void OnDetailsPropertyChanged(const FPropertyChangedEvent& Event);
 
 	void SaveDirtyTexturesAndPresets();
@@ -0,0 +1,40 @@
+// STextureManagerMetrics.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/DeclarativeSyntaxSupport.h"
+#include "Widgets/Views/SListView.h"
+#include "TextureManagerMetrics.h"
+
+// Latency percentiles per phase and per operation, refreshed while open
+class STextureManagerMetrics : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(STextureManagerMetrics) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	// Tab id of the Window > Texture Manager Metrics nomad tab
+	static const FName TabId;
+
+	static TSharedRef<class SDockTab> SpawnTab(const class FSpawnTabArgs& Args);
+
+private:
+	using FSummaryItem = TSharedPtr<FTextureManagerLatencySummary>;
+
+	TArray<FSummaryItem> Items;
+	TSharedPtr<SListView<FSummaryItem>> ListView;
+
+	// Metrics revision the list shows
+	uint32 ShownRevision = 0;
+
+	void Rebuild();
+	EActiveTimerReturnType OnRefreshTimer(double CurrentTime, float DeltaTime);
+
+	FReply OnResetClicked();
+	FReply OnExportClicked();
+
+	TSharedRef<ITableRow> GenerateRow(FSummaryItem Item, const TSharedRef<STableViewBase>& OwnerTable);
+};
@@ -0,0 +1,55 @@
+// STextureResidencyReport.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/DeclarativeSyntaxSupport.h"
+#include "Widgets/Views/SListView.h"
+#include "TextureResidencyReport.h"
+
+// Which table the report view shows
+enum class EResidencyReportView : uint8
+{
+	ByPreset,
+	ByGroup,
+	Textures
+};
+
+// Report window: totals per preset / texture group, and the textures that
+// pin the most memory, with pool and LOD group warnings on top
+class STextureResidencyReport : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(STextureResidencyReport) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	// Opens the report in its own window
+	static void OpenWindow();
+
+private:
+	using FTotalItem = TSharedPtr<FTextureResidencyTotal>;
+	using FEntryItem = TSharedPtr<FTextureResidencyEntry>;
+
+	FTextureResidencyReport Report;
+	EResidencyReportView View = EResidencyReportView::ByPreset;
+
+	TArray<FTotalItem> TotalItems;
+	TArray<FEntryItem> EntryItems;
+
+	TSharedPtr<SListView<FTotalItem>> TotalsListView;
+	TSharedPtr<SListView<FEntryItem>> EntriesListView;
+
+	void Rebuild();
+	void OnViewChanged(EResidencyReportView NewView);
+
+	FText GetSummaryText() const;
+	FText GetWarningsText() const;
+
+	FReply OnRefreshClicked();
+	FReply OnExportClicked();
+
+	TSharedRef<ITableRow> GenerateTotalRow(FTotalItem Item, const TSharedRef<STableViewBase>& OwnerTable);
+	TSharedRef<ITableRow> GenerateEntryRow(FEntryItem Item, const TSharedRef<STableViewBase>& OwnerTable);
+};
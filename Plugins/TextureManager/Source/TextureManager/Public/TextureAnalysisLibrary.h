@@ -0,0 +1,109 @@
+// TextureAnalysisLibrary.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UTexture2D;
+class UTexturePresetAsset;
+struct FImage;
+
+// What a texture actually does with its alpha channel
+enum class ETextureAlphaUsage : uint8
+{
+	Unknown,	// not analyzed yet
+	Absent,		// source format has no alpha
+	Constant,	// every pixel has the same alpha
+	Used		// alpha varies
+};
+
+struct FTextureAlphaInfo
+{
+	ETextureAlphaUsage Usage = ETextureAlphaUsage::Unknown;
+
+	// Only meaningful for Constant
+	uint8 ConstantAlpha = 255;
+
+	// Alpha can be dropped without changing how the texture looks
+	bool IsRemovable() const
+	{
+		return Usage == ETextureAlphaUsage::Absent
+			|| (Usage == ETextureAlphaUsage::Constant && ConstantAlpha == 255);
+	}
+};
+
+// What the pixels of a texture look like they are for
+enum class ETextureContentKind : uint8
+{
+	Unknown,
+	Color,		// regular sRGB colour
+	NormalMap,	// unit length vectors, blue dominant
+	Grayscale,	// R == G == B
+	Mask,		// linear data, mostly near 0 or 1
+	PackedORM	// independent data in each channel (occlusion / roughness / metallic)
+};
+
+struct FTextureContentInfo
+{
+	ETextureContentKind Kind = ETextureContentKind::Unknown;
+	FTextureAlphaInfo Alpha;
+
+	// Whether the texture should be sampled as sRGB
+	bool bSuggestSRGB = true;
+
+	// 0..1, how clearly the pixels matched Kind
+	float Confidence = 0.f;
+
+	// Raw statistics the classification is based on
+	float MeanUnitLengthError = 0.f;
+	float BlueDominantFraction = 0.f;
+	float GrayscaleFraction = 0.f;
+	float ExtremeFraction = 0.f;
+	float MaxChannelCorrelation = 0.f;
+};
+
+// Source pixel analysis, no UObject / UHT involved.
+// Results are cached per texture and keyed by its source id, so they stay
+// valid until the source art is reimported.
+namespace TextureAnalysisLibrary
+{
+	// Classify alpha of a decoded source image (vectorized, split across cores)
+	FTextureAlphaInfo ClassifyAlpha(const FImage& Image);
+
+	// Cached result, or Unknown if the texture hasn't been analyzed
+	FTextureAlphaInfo FindAlphaUsage(const UTexture2D* Texture);
+
+	// Analyze now on the calling (game) thread and cache the result
+	FTextureAlphaInfo AnalyzeAlphaUsage(UTexture2D* Texture);
+
+	// Analyze a batch on a background task; OnComplete runs on the game thread
+	void AnalyzeAlphaUsageAsync(const TArray<UTexture2D*>& Textures, TFunction<void()> OnComplete);
+
+	FText AlphaUsageToText(const FTextureAlphaInfo& Info);
+
+	// Memory saved by compressing this texture without alpha
+	int64 EstimateAlphaSavings(const UTexture2D* Texture);
+
+	// Best matching preset that does not use alpha, or nullptr
+	UTexturePresetAsset* SuggestPresetWithoutAlpha(
+		const UTexture2D* Texture,
+		const TArray<TWeakObjectPtr<UTexturePresetAsset>>& Presets);
+
+	// Classify what a decoded source image contains. Works on a small
+	// downsampled copy; the statistics kernels are vectorized and split across cores.
+	FTextureContentInfo ClassifyContent(const FImage& Image);
+
+	// Cached result, or Unknown if the texture hasn't been analyzed
+	FTextureContentInfo FindContentInfo(const UTexture2D* Texture);
+
+	// Analyze a batch with every core on a background task; also fills the alpha
+	// cache. OnComplete runs on the game thread.
+	void AnalyzeContentAsync(const TArray<UTexture2D*>& Textures, TFunction<void()> OnComplete);
+
+	FText ContentKindToText(ETextureContentKind Kind);
+
+	// Existing preset that best fits the analyzed content, or nullptr
+	UTexturePresetAsset* SuggestPresetForContent(
+		const FTextureContentInfo& Info,
+		const TArray<TWeakObjectPtr<UTexturePresetAsset>>& Presets);
+}
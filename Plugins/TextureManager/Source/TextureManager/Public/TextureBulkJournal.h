@@ -0,0 +1,54 @@
+// TextureBulkJournal.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UTexture2D;
+
+struct FTextureJournalBatch
+{
+	FGuid Id;
+	FString Label;
+	FDateTime Time;
+	int32 NumTextures = 0;
+};
+
+// Undo for bulk applies without the transaction buffer: before a batch
+// changes a texture, the old values of just the fields that change are
+// appended to Saved/TextureManager/Journal/<batch>.bin, keyed by texture
+// path, and flushed to disk record by record. Rolling back a batch writes
+// them back, also after a restart or a crash.
+// Field values are stored by name, so a journal survives fields being
+// added or reordered. Game thread only.
+namespace TextureBulkJournal
+{
+	// Start a batch; its file is created on the first Record
+	FGuid BeginBatch(const FString& Label);
+
+	// Remember the texture's current values of Fields (preset field names,
+	// see TexturePresetLibrary::GetApplicableFields) before they change.
+	// Only the first record of a texture in a batch counts.
+	void Record(const FGuid& Batch, const UTexture2D* Texture, const TArray<FName>& Fields);
+
+	// Close the files of open batches (they can be appended to no more)
+	void CloseBatches();
+
+	// Delete the files of rolled back batches; called by the scheduler once
+	// their rebuilds are done
+	void FinishRollbacks();
+
+	// Batches on disk, newest first
+	TArray<FTextureJournalBatch> ListBatches();
+
+	// Restore every texture of the batch through TextureRebuildScheduler; the
+	// file is deleted once the scheduler drains. Returns the number of textures queued; textures that no
+	// longer exist or already have the old values are skipped.
+	int32 Rollback(const FGuid& Batch);
+
+	// Delete batches beyond the newest MaxBatches
+	void Prune(int32 MaxBatches);
+
+	// Keep batches under Dir instead of Saved/TextureManager/Journal, e.g.
+	// for a benchmark; empty goes back to the default
+	void SetDirectory(const FString& Dir);
+}
@@ -0,0 +1,115 @@
+// TextureCompressionOptimizer.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/TextureDefines.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include "TexturePresetAsset.h"
+
+class UTexture2D;
+class UTexturePresetAsset;
+struct FImage;
+
+// How close a compressed, resized texture stays to its source
+struct FTextureQualityMetrics
+{
+	// Peak signal to noise ratio in dB over the channels the format keeps
+	float PSNR = 0.f;
+
+	// Mean structural similarity (8x8 windows), 1 = identical
+	float SSIM = 0.f;
+};
+
+struct FTextureOptimizerOptions
+{
+	// A candidate is only accepted if every texture reaches both thresholds
+	float MinPSNR = 40.f;
+	float MinSSIM = 0.97f;
+
+	// Tried for every compression setting; 0 = keep full size
+	TArray<int32> MaxTextureSizes = { 0, 4096, 2048, 1024, 512, 256 };
+	TArray<int32> LODBiases = { 0, 1, 2 };
+
+	// Longest side of the copy the metrics are measured on
+	int32 AnalysisSize = 1024;
+};
+
+struct FTextureOptimizerTextureResult
+{
+	TWeakObjectPtr<UTexture2D> Texture;
+
+	// At the chosen settings
+	FTextureQualityMetrics Metrics;
+
+	int64 CurrentBytes = 0;
+	int64 OptimizedBytes = 0;
+
+	// False if its source could not be read; it was left out of the search
+	bool bAnalyzed = false;
+};
+
+struct FTextureOptimizerResult
+{
+	// A candidate met the thresholds for every texture
+	bool bFound = false;
+
+	// Base settings (or the first texture's) with the winning compression, size and bias
+	FTexturePresetSettings Settings;
+
+	TArray<FTextureOptimizerTextureResult> Textures;
+
+	int64 CurrentBytes = 0;
+	int64 OptimizedBytes = 0;
+
+	// Worst texture at the chosen settings
+	FTextureQualityMetrics WorstMetrics;
+
+	int32 NumCandidates = 0;
+	int32 NumEvaluations = 0;
+
+	// Textures left out because their source could not be read
+	int32 NumUnreadable = 0;
+
+	// Why nothing was found
+	FText Message;
+};
+
+// Searches compression / size / LOD bias combinations for a set of textures
+// that will share one preset. Every candidate is compressed with a CPU block
+// encoder and compared to the source; the smallest combination that meets the
+// quality thresholds for every texture wins. The encoders are plain range fit
+// BC1/BC4/BC5, a little worse than the cooker's, so the result errs on the
+// safe side.
+namespace TextureCompressionOptimizer
+{
+	// Compression settings the CPU encoders can reproduce
+	bool CanSimulate(TextureCompressionSettings Compression);
+
+	// Compress and decode an RGBA32F image in place (block rows split across cores)
+	void EncodeDecode(FImage& Image, TextureCompressionSettings Compression, bool bHasAlpha);
+
+	// Compare two RGBA32F images of the same size over the channels the format keeps
+	FTextureQualityMetrics Measure(const FImage& Reference, const FImage& Test, TextureCompressionSettings Compression, bool bHasAlpha);
+
+	// Decode the sources, evaluate every (texture, candidate) pair in parallel on
+	// a background task and pick the smallest passing candidate. BaseSettings
+	// (a shared preset's) provides everything except compression, MaxTextureSize
+	// and LODBias; null measures every texture with its own settings. Either
+	// way the textures must share a sampler type. Textures whose source can't
+	// be read are left out and counted. OnComplete runs on the game thread.
+	void OptimizeAsync(
+		const TArray<UTexture2D*>& Textures,
+		const FTexturePresetSettings* BaseSettings,
+		const FTextureOptimizerOptions& Options,
+		TFunction<void(const FTextureOptimizerResult&)> OnComplete);
+
+	// Write the result into Preset (or a new preset under PackagePath when
+	// Preset is null, applying only compression, size and bias), then assign
+	// it to the result's analyzed textures and queue them on
+	// TextureRebuildScheduler under one journal batch
+	UTexturePresetAsset* WriteToPreset(
+		const FTextureOptimizerResult& Result,
+		UTexturePresetAsset* Preset,
+		const FString& PackagePath,
+		FName PresetName);
+}
@@ -0,0 +1,48 @@
+// TextureDDCWarmup.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+class ITargetPlatform;
+class UTexture2D;
+class UTexturePresetAsset;
+
+struct FTextureDDCWarmupStats
+{
+	int32 NumTextures = 0;
+	int32 NumPlatforms = 0;
+	int32 NumSkipped = 0;
+
+	// Texture derived data found in the cache / built, from the DDC's own
+	// counters (so they include mips and VT chunks, not one per texture)
+	int64 CacheHits = 0;
+	int64 CacheMisses = 0;
+
+	double Seconds = 0.0;
+};
+
+// Builds the cooked platform data of textures ahead of time so the DDC
+// (shared or local) already has it when someone opens or cooks them.
+// Used by UTextureDDCWarmupCommandlet after preset changes.
+namespace TextureDDCWarmup
+{
+	// Textures linked to the presets or to any preset derived from them, and
+	// members of folders using them
+	TArray<FSoftObjectPath> GetAffectedTextures(const TArray<UTexturePresetAsset*>& Presets);
+
+	// UTextureManagerSettings::WarmupPlatforms, else the active target platforms
+	TArray<const ITargetPlatform*> GetWarmupPlatforms();
+
+	// Load and build every texture for every platform, at most MaxInFlight
+	// textures at a time; cooked data is released as soon as a platform is
+	// done, and garbage is collected every few hundred textures. Presets
+	// applied at cook time are applied per platform first, so the keys match
+	// those of a cook of that platform; with bMultiPlatformCook they are
+	// applied once for all platforms, as a cook of all of them together does.
+	FTextureDDCWarmupStats Run(
+		const TArray<FSoftObjectPath>& Textures,
+		const TArray<const ITargetPlatform*>& Platforms,
+		int32 MaxInFlight,
+		bool bMultiPlatformCook = false);
+}
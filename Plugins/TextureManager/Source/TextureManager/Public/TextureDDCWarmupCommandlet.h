@@ -0,0 +1,31 @@
+// TextureDDCWarmupCommandlet.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TextureDDCWarmupCommandlet.generated.h"
+
+// Prebuilds the derived data of the textures affected by preset changes, so
+// the first person to open them (or the next cook) gets cache hits.
+//
+//   UnrealEditor-Cmd <Project> -run=TextureDDCWarmup -nullrhi
+//       [-presets=<Name>,<Name>] [-changed=<file>] [-all]
+//       [-targetplatform=<Platform>+<Platform>] [-maxinflight=<N>] [-multiplatform]
+//
+// -changed= takes a file listing changed files (e.g. git diff --name-only);
+// the preset .uasset files among them select the presets. Texture building
+// runs on the CPU, so -nullrhi on a build agent without a GPU is fine.
+// Platforms come from the Texture Manager settings, else -targetplatform=.
+// Keys match a cook of one platform each; -multiplatform matches one cook of
+// all the platforms together instead (cook-time presets keep only downscale
+// per platform there).
+UCLASS()
+class UTextureDDCWarmupCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UTextureDDCWarmupCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
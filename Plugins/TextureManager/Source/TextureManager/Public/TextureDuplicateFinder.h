@@ -0,0 +1,72 @@
+// TextureDuplicateFinder.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "IO/IoHash.h"
+
+class UTexture2D;
+struct FImage;
+
+// Hashes of a texture's decoded source pixels
+struct FTextureContentHash
+{
+	// Blake3 of dimensions, format and pixel bytes; equal = identical pixels
+	FIoHash Exact;
+
+	// 64 bit DCT hash of a 32x32 luminance copy; small Hamming distance = looks the same
+	uint64 Perceptual = 0;
+
+	bool IsValid() const { return !Exact.IsZero(); }
+};
+
+// Textures that are copies of each other
+struct FTextureDuplicateCluster
+{
+	// Keeper first (largest, then shortest path), the copies after it
+	TArray<FAssetData> Assets;
+
+	// Every member has the same exact hash
+	bool bExact = false;
+
+	// Every member has the keeper's CompressionSettings, SRGB and LODGroup tags
+	bool bSameBuildSettings = false;
+
+	// Safe to consolidate without looking at the group: identical pixels,
+	// built the same way
+	bool IsInterchangeable() const { return bExact && bSameBuildSettings; }
+
+	// Memory of everything but the keeper
+	int64 WastedBytes = 0;
+};
+
+// Duplicate detection. Hashes are computed on worker threads and cached by the
+// package's saved hash, both in memory and in Saved/TextureManager/ContentHashes.bin,
+// so unchanged textures are never decoded twice. Packages with unsaved changes
+// are cached by source id for the session only.
+namespace TextureDuplicateFinder
+{
+	// Hash a decoded source image (vectorized downsample and DCT)
+	FTextureContentHash ComputeHash(const FImage& Image);
+
+	// Cached hash, or an invalid one. Game thread.
+	FTextureContentHash FindHash(const FAssetData& Asset);
+
+	// Hash every texture without a cached hash on a background task, one texture
+	// per core. OnComplete runs on the game thread.
+	void ComputeHashesAsync(const TArray<UTexture2D*>& Textures, TFunction<void()> OnComplete);
+
+	// Number of differing perceptual hash bits still counted as a near duplicate
+	constexpr int32 DefaultMaxHammingDistance = 4;
+
+	// Clusters among Assets that have a cached hash, most wasted memory first
+	TArray<FTextureDuplicateCluster> FindClusters(const TArray<FAssetData>& Assets, int32 MaxHammingDistance = DefaultMaxHammingDistance);
+
+	// Replace every reference to the copies with the keeper and delete the copies
+	// (loads the cluster). Returns false if anything could not be consolidated.
+	bool ConsolidateCluster(const FTextureDuplicateCluster& Cluster);
+
+	// Same for several clusters; the presets that listed copies are saved once
+	// at the end. Returns the number of clusters not fully consolidated.
+	int32 ConsolidateClusters(const TArray<FTextureDuplicateCluster>& Clusters);
+}
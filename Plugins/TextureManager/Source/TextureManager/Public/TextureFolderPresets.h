@@ -0,0 +1,47 @@
+// TextureFolderPresets.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+class UTexture2D;
+class UTexturePresetAsset;
+
+// Presets assigned to content folders (UTextureManagerSettings::FolderPresets).
+// The deepest folder with a preset wins; a texture's own assignment wins over
+// any folder. Folders are resolved through a path trie built from the
+// settings, and the result is cached per package path, so asking for the
+// preset of every texture in a folder costs one walk per folder, not per texture.
+// Game thread only.
+namespace TextureFolderPresets
+{
+	// Folder (e.g. /Game/Props) whose preset covers PackagePath, empty if none
+	FString FindOwningFolder(FName PackagePath);
+
+	// Preset of the owning folder, or null (loads the preset)
+	UTexturePresetAsset* FindFolderPreset(FName PackagePath);
+
+	// The texture's own preset, else the folder's
+	UTexturePresetAsset* GetEffectivePreset(const UTexture2D* Texture);
+
+	// Textures under Folder that take their preset from Folder or one of its
+	// parents, i.e. not from a deeper folder preset
+	TArray<FAssetData> GetFolderMembers(const FString& Folder);
+
+	// Link the folder preset to a texture that has no preset of its own (e.g.
+	// right after import) and queue its rebuild on TextureRebuildScheduler,
+	// journaled; a cook-time preset is only linked. True if it was assigned.
+	bool ApplyFolderPreset(UTexture2D* Texture);
+
+	// Resolve and apply again for every member of the folders, one progress
+	// dialog and one journal batch for all; the rebuilds are queued on
+	// TextureRebuildScheduler. Folder links that no longer resolve are
+	// removed. Returns the number of textures queued.
+	int32 ReapplyFolders(const TArray<FString>& Folders);
+
+	// Set (null = clear) the preset of Folder, save the settings and re-apply
+	void SetFolderPreset(const FString& Folder, UTexturePresetAsset* Preset);
+
+	// Rebuild the trie on next use; called when the settings change
+	void Invalidate();
+}
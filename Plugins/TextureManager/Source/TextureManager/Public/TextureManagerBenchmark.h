@@ -0,0 +1,75 @@
+// TextureManagerBenchmark.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Size of a synthetic project
+struct FTextureManagerBenchmarkScenario
+{
+	int32 NumTextures = 1000;
+	int32 NumPresets = 10;
+
+	// e.g. "10000x100", the key results are compared by
+	FString GetName() const
+	{
+		return FString::Printf(TEXT("%dx%d"), NumTextures, NumPresets);
+	}
+};
+
+struct FTextureManagerBenchmarkResult
+{
+	FString Scenario;
+	FString Name;
+
+	// Microbenchmarks: number of textures (and Files entries) per run
+	int32 Size = 0;
+
+	int32 NumIterations = 0;
+	double MinMs = 0.0;
+	double MedianMs = 0.0;
+	double MeanMs = 0.0;
+	double MaxMs = 0.0;
+};
+
+// Times what the Texture Manager window does (list refreshes, preset filter,
+// search, apply to a selection, save dirty packages) on synthetic projects.
+// A project is generated in memory under /Game/__TextureManagerBenchmark:
+// tiny textures spread over folders, presets with varied settings, and
+// assignments skewed so a few presets own most textures while a tenth of the
+// textures have none. Nothing is written to Content; saves and journal
+// batches go to Saved/TextureManager/Benchmark and are deleted again, and
+// the rebuilds are not added to the rebuild cost model.
+// The widget needs Slate, so each benchmark makes the same TextureManagerLists
+// calls as its widget function, without the views. Also runs as automation
+// tests (TextureManager.Benchmark.*). Game thread only.
+namespace TextureManagerBenchmark
+{
+	TArray<FTextureManagerBenchmarkResult> RunScenario(const FTextureManagerBenchmarkScenario& Scenario, int32 NumIterations, int32 Seed);
+
+	// TexturePresetLibrary on its own, on transient textures and presets
+	// whose Files hold Size textures. Each run calls the function once per
+	// texture, so a linear function's time grows with Size, a function that
+	// is O(Files) per call with Size squared. Scenario is "Files<Size>".
+	TArray<FTextureManagerBenchmarkResult> RunMicro(const TArray<int32>& Sizes, int32 NumIterations);
+
+	// Clicks through NumSelections transient textures the way the window asks
+	// FTexturePreviewPool for previews, collecting garbage every 100. Passes
+	// when the object count and the pool's bytes after the first 100 do not
+	// grow; process memory is logged alongside.
+	bool CheckPreviewPoolLeak(int32 NumSelections);
+
+	// Per microbenchmark, the median at each size and the exponent of the
+	// growth from the size before (1 = linear, 2 = quadratic)
+	TArray<FString> DescribeScaling(const TArray<FTextureManagerBenchmarkResult>& Results);
+
+	bool SaveJson(const TArray<FTextureManagerBenchmarkResult>& Results, const FString& FilePath);
+	bool LoadJson(const FString& FilePath, TArray<FTextureManagerBenchmarkResult>& OutResults);
+
+	// Results whose median is more than Threshold (0.1 = 10%) and MinDeltaMs
+	// slower than the same scenario and benchmark in the baseline; one line each
+	TArray<FString> FindRegressions(
+		const TArray<FTextureManagerBenchmarkResult>& Results,
+		const TArray<FTextureManagerBenchmarkResult>& Baseline,
+		double Threshold,
+		double MinDeltaMs);
+}
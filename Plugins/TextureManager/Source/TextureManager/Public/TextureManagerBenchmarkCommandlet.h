@@ -0,0 +1,35 @@
+// TextureManagerBenchmarkCommandlet.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TextureManagerBenchmarkCommandlet.generated.h"
+
+// Times the Texture Manager on synthetic projects (TextureManagerBenchmark)
+// and compares the medians with a previous run.
+//
+//   UnrealEditor-Cmd <Project> -run=TextureManagerBenchmark -nullrhi
+//       [-scenarios=1000x10,10000x100,100000x1000] [-iterations=<N>] [-seed=<N>]
+//       [-output=<file.json>] [-baseline=<file.json>]
+//       [-threshold=<0.1>] [-mindelta=<ms>]
+//       [-micro [-sizes=100,1000,10000]]
+//       [-previewleak [-selections=1000]]
+//
+// Scenarios are <textures>x<presets>. -micro runs the TexturePresetLibrary
+// microbenchmarks at each of -sizes= instead, and logs how each scales.
+// Results go to -output= (default Saved/TextureManager/Benchmark.json).
+// With -baseline=, a benchmark whose
+// median got slower by more than -threshold= (fraction) and -mindelta=
+// milliseconds is reported and the commandlet returns 2.
+// -previewleak only runs the preview pool leak check, and returns 2 if the
+// previews grew memory.
+UCLASS()
+class UTextureManagerBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UTextureManagerBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,48 @@
+// TextureManagerLists.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UPackage;
+class UTexture2D;
+class UTexturePresetAsset;
+
+// What the Texture Manager window lists and how it filters and saves, without
+// the views: SMyTwoColumnWidget shows the results, TextureManagerBenchmark
+// times the same calls. Game thread only.
+namespace TextureManagerLists
+{
+	// /Game and the plugin's own content
+	TArray<FName> GetContentRoots();
+
+	// Registry entries of Class (and its subclasses) under Roots; nothing is loaded
+	TArray<FAssetData> QueryAssets(const UClass* Class, const TArray<FName>& Roots);
+
+	// Load the assets as list items; the ones that fail to load are left out
+	TArray<TWeakObjectPtr<UTexture2D>> LoadTextures(const TArray<FAssetData>& Assets);
+	TArray<TWeakObjectPtr<UTexturePresetAsset>> LoadPresets(const TArray<FAssetData>& Assets);
+
+	// PresetName, or the asset name if it has none
+	FString GetPresetLabel(const UTexturePresetAsset* Preset);
+
+	// Textures linked to Preset; with a null Preset, the ones linked to none
+	TArray<TWeakObjectPtr<UTexture2D>> FilterByPreset(
+		const TArray<TWeakObjectPtr<UTexture2D>>& Textures,
+		const UTexturePresetAsset* Preset);
+
+	// Items whose name (presets: label) contains Query; all for an empty Query
+	TArray<TWeakObjectPtr<UTexture2D>> SearchTextures(
+		const TArray<TWeakObjectPtr<UTexture2D>>& Textures,
+		const FString& Query);
+	TArray<TWeakObjectPtr<UTexturePresetAsset>> SearchPresets(
+		const TArray<TWeakObjectPtr<UTexturePresetAsset>>& Presets,
+		const FString& Query);
+
+	// Dirty packages of the textures and presets, each once. Textures that
+	// are not loaded can't be dirty and stay unloaded.
+	TArray<UPackage*> GatherDirtyPackages(
+		const TArray<FAssetData>& Textures,
+		const TArray<TWeakObjectPtr<UTexturePresetAsset>>& Presets);
+}
@@ -0,0 +1,96 @@
+// TextureManagerMetrics.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+
+struct FAssetData;
+
+// Phases every preset operation is made of
+enum class ETextureManagerPhase : uint8
+{
+	RegistryQuery,
+	Load,
+	Apply,
+	Rebuild,
+	Save,
+	Num
+};
+
+// One row of the metrics: a phase, or an operation (e.g. SavePreset) with
+// everything it did while it was open
+struct FTextureManagerLatencySummary
+{
+	FString Name;
+	bool bOperation = false;
+
+	int64 Count = 0;
+	double TotalSeconds = 0.0;
+	double P50Seconds = 0.0;
+	double P95Seconds = 0.0;
+	double P99Seconds = 0.0;
+	double MaxSeconds = 0.0;
+
+	// Totals; a phase row carries what its phase did (Load / Save)
+	int64 BytesLoaded = 0;
+	int64 PackagesSaved = 0;
+};
+
+// Latency histograms (log-spaced, 4 buckets per octave from 1 us) per phase and
+// per operation since the editor started, plus bytes loaded and packages saved.
+// Shown in Window > Texture Manager Metrics, written to CSV by
+// TextureManager.Metrics.DumpCsv [Path], cleared by TextureManager.Metrics.Reset.
+// Game thread only.
+namespace TextureManagerMetrics
+{
+	const TCHAR* GetPhaseName(ETextureManagerPhase Phase);
+
+	void AddSample(ETextureManagerPhase Phase, double Seconds);
+
+	// Counted for the Load / Save phase and every open operation
+	void AddBytesLoaded(int64 Bytes);
+	void AddPackagesSaved(int32 NumPackages);
+
+	// Load the asset as a timed Load sample, counting its package size.
+	// Already loaded assets are returned as they are and not counted.
+	UObject* LoadAsset(const FAssetData& Asset);
+
+	// Phases in order, then operations by name
+	TArray<FTextureManagerLatencySummary> GetSummaries();
+
+	// Bumped on every sample, so views only refresh when something was recorded
+	uint32 GetRevision();
+
+	void Reset();
+
+	bool SaveCsv(const FString& FilePath);
+}
+
+// Times its scope as a sample of Phase
+class FTextureManagerPhaseScope : public FNoncopyable
+{
+public:
+	explicit FTextureManagerPhaseScope(ETextureManagerPhase InPhase)
+		: Phase(InPhase)
+		, StartSeconds(FPlatformTime::Seconds())
+	{
+	}
+
+	~FTextureManagerPhaseScope()
+	{
+		TextureManagerMetrics::AddSample(Phase, FPlatformTime::Seconds() - StartSeconds);
+	}
+
+private:
+	ETextureManagerPhase Phase;
+	double StartSeconds;
+};
+
+// A user-facing operation. Its latency is recorded under Name; bytes loaded and
+// packages saved while it is open count towards it (and any operation around it).
+class FTextureManagerOperationScope : public FNoncopyable
+{
+public:
+	explicit FTextureManagerOperationScope(FName Name);
+	~FTextureManagerOperationScope();
+};
@@ -0,0 +1,66 @@
+// TextureManagerSettings.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "TexturePresetAsset.h"
+#include "TextureManagerSettings.generated.h"
+
+// A preset every texture under Folder uses unless a deeper folder or the
+// texture itself has one
+USTRUCT()
+struct FTextureFolderPreset
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, Category = "Folder", meta = (ContentDir, LongPackageName))
+    FDirectoryPath Folder;
+
+    UPROPERTY(EditAnywhere, Category = "Folder")
+    TSoftObjectPtr<UTexturePresetAsset> Preset;
+};
+
+// Project Settings > Plugins > Texture Manager (DefaultEditor.ini)
+UCLASS(config = Editor, defaultconfig, meta = (DisplayName = "Texture Manager"))
+class UTextureManagerSettings : public UDeveloperSettings
+{
+    GENERATED_BODY()
+
+public:
+    UTextureManagerSettings();
+
+    UPROPERTY(config, EditAnywhere, Category = "Folder Presets")
+    TArray<FTextureFolderPreset> FolderPresets;
+
+    // Platforms the DDC warm-up builds for (e.g. WindowsEditor, Android_ASTC).
+    // Empty = -targetplatform= on the command line, else the running platform.
+    UPROPERTY(config, EditAnywhere, Category = "DDC Warm-up")
+    TArray<FString> WarmupPlatforms;
+
+    // Textures building at once; each holds its source and mips in memory
+    UPROPERTY(config, EditAnywhere, Category = "DDC Warm-up", meta = (ClampMin = "1", ClampMax = "256"))
+    int32 WarmupMaxInFlight = 8;
+
+    // Texture rebuilds running at once after a preset change; 0 = half the cores
+    UPROPERTY(config, EditAnywhere, Category = "Rebuild Scheduler", meta = (ClampMin = "0", ClampMax = "64"))
+    int32 RebuildMaxInFlight = 0;
+
+    // Estimated build memory of the rebuilds running at once
+    UPROPERTY(config, EditAnywhere, Category = "Rebuild Scheduler", meta = (ClampMin = "256", Units = "Megabytes"))
+    int32 RebuildMemoryBudgetMB = 4096;
+
+    // Bulk applies that can still be rolled back (Saved/TextureManager/Journal)
+    UPROPERTY(config, EditAnywhere, Category = "Rebuild Scheduler", meta = (ClampMin = "1", ClampMax = "1000"))
+    int32 JournalMaxBatches = 20;
+
+#if WITH_EDITOR
+    virtual void PreEditChange(FProperty* PropertyAboutToChange) override;
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& Event) override;
+#endif
+
+private:
+    // Folder -> preset before the current edit (which can span several
+    // interactive changes), to re-apply only what changed
+    TMap<FString, FSoftObjectPath> FolderPresetsBeforeEdit;
+    bool bEditInProgress = false;
+};
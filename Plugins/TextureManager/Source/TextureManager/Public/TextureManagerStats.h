@@ -1,15 +1,90 @@
+// TextureManagerStats.h
 #pragma once
 
-//#include "Stats/Stats.h"
-//
-//// Declare group + cycle stats here so other cpp files can reference them
-//DECLARE_STATS_GROUP(TEXT("TextureManager"), STATGROUP_TextureManager, STATCAT_Advanced);
-//
-//DECLARE_CYCLE_STAT(TEXT("TextureManager|OnSaveButtonClicked"),
-//    STAT_TextureManager_OnSaveButtonClicked, STATGROUP_TextureManager);
-//
-//DECLARE_CYCLE_STAT(TEXT("TextureManager|OnPresetSaveButtonClicked"),
-//    STAT_TextureManager_OnPresetSaveButtonClicked, STATGROUP_TextureManager);
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+// ---------- Stats (stat TPM) ----------
+
+DECLARE_STATS_GROUP(TEXT("Texture Preset Manager"), STATGROUP_TPM, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT(TEXT("Texture Preset Manager|OnSaveButtonClicked"),
+	STAT_TextureManager_OnSaveButtonClicked,
+	STATGROUP_TPM);
+
+DECLARE_CYCLE_STAT(TEXT("Texture Preset Manager|OnPresetSaveButtonClicked"),
+	STAT_TextureManager_OnPresetSaveButtonClicked,
+	STATGROUP_TPM);
+
+DECLARE_CYCLE_STAT(TEXT("Texture Preset Manager|RefreshPresetList"),
+	STAT_TextureManager_RefreshPresetList,
+	STATGROUP_TPM);
+
+// Wall-clock ms spent inside OnSaveButtonClicked (persistent accumulator).
+DECLARE_FLOAT_COUNTER_STAT(
+	TEXT("Texture Preset Manager|OnSaveButtonClicked Wall Time (ms)"),
+	STAT_TextureManager_OnSaveButtonClickedWallMs,
+	STATGROUP_TPM);
+
+// Number of times OnSaveButtonClicked has run (persistent accumulator).
+DECLARE_DWORD_ACCUMULATOR_STAT(
+	TEXT("Texture Preset Manager|OnSaveButtonClicked Calls"),
+	STAT_TextureManager_OnSaveButtonClickedCalls,
+	STATGROUP_TPM);
+
+// Wall-clock accumulators for OnPresetSaveButtonClicked
+DECLARE_FLOAT_COUNTER_STAT(
+	TEXT("Texture Preset Manager|OnPresetSaveButtonClicked Wall Time (ms)"),
+	STAT_TextureManager_OnPresetSaveButtonClickedWallMs,
+	STATGROUP_TPM);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(
+	TEXT("Texture Preset Manager|OnPresetSaveButtonClicked Calls"),
+	STAT_TextureManager_OnPresetSaveButtonClickedCalls,
+	STATGROUP_TPM);
+
+// Transient texture / preset copies held for the details view (TexturePreviewPool)
+DECLARE_DWORD_ACCUMULATOR_STAT(
+	TEXT("Texture Preset Manager|Preview Objects"),
+	STAT_TextureManager_PreviewObjects,
+	STATGROUP_TPM);
+
+DECLARE_MEMORY_STAT(
+	TEXT("Texture Preset Manager|Preview Memory"),
+	STAT_TextureManager_PreviewMemory,
+	STATGROUP_TPM);
+
+// ---------- Insights ----------
 //
-//DECLARE_CYCLE_STAT(TEXT("TextureManager|RefreshPresetList"),
-//    STAT_TextureManager_RefreshPresetList, STATGROUP_TextureManager);
+// Enable with -trace=cpu,counters,memory,texturemanager (or
+// "Trace.Enable TextureManager" at runtime). Every refresh, filter, search,
+// apply, capture, clone, save and import path opens a scope on this channel;
+// the counters below show how much each bulk operation touched, and the LLM
+// tag shows what it allocated.
+
+UE_TRACE_CHANNEL_EXTERN(TextureManagerChannel)
+
+LLM_DECLARE_TAG(TextureManager);
+
+TRACE_DECLARE_INT_COUNTER_EXTERN(TextureManager_TexturesApplied);
+TRACE_DECLARE_INT_COUNTER_EXTERN(TextureManager_TexturesCaptured);
+TRACE_DECLARE_INT_COUNTER_EXTERN(TextureManager_ObjectsCloned);
+TRACE_DECLARE_INT_COUNTER_EXTERN(TextureManager_TexturesImported);
+TRACE_DECLARE_INT_COUNTER_EXTERN(TextureManager_PackagesSaved);
+TRACE_DECLARE_INT_COUNTER_EXTERN(TextureManager_ListedTextures);
+TRACE_DECLARE_INT_COUNTER_EXTERN(TextureManager_ListedPresets);
+TRACE_DECLARE_INT_COUNTER_EXTERN(TextureManager_RebuildsQueued);
+TRACE_DECLARE_INT_COUNTER_EXTERN(TextureManager_RebuildsRunning);
+TRACE_DECLARE_MEMORY_COUNTER_EXTERN(TextureManager_RebuildMemory);
+TRACE_DECLARE_INT_COUNTER_EXTERN(TextureManager_PreviewObjects);
+TRACE_DECLARE_MEMORY_COUNTER_EXTERN(TextureManager_PreviewMemory);
+
+// CPU scope named "TextureManager::<Name>" on TextureManagerChannel, with
+// allocations tagged for LLM. Name must be a string literal.
+#define TEXTURE_MANAGER_SCOPE(Name) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("TextureManager::" Name, TextureManagerChannel); \
+	LLM_SCOPE_BYTAG(TextureManager)
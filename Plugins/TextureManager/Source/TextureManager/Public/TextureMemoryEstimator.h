@@ -0,0 +1,99 @@
+// TextureMemoryEstimator.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/TextureDefines.h"
+#include "TexturePresetAsset.h"
+
+class UTexture2D;
+class UTextureLODSettings;
+struct FAssetData;
+
+// Everything the estimate depends on, resolved up front so Estimate() itself
+// is plain arithmetic (no UObjects, no derived data, safe on any thread)
+struct FTextureMemoryInputs
+{
+	int32 SourceSizeX = 0;
+	int32 SourceSizeY = 0;
+
+	// The source has an alpha channel the compressed format has to keep
+	bool bHasAlpha = false;
+
+	// Effective settings: the texture's own, or a preset's, with the platform
+	// overrides of the active device profile's platform already resolved
+	FTexturePresetSettings Settings;
+
+	// From the LOD group of Settings.TextureGroup (active device profile)
+	int32 GroupLODBias = 0;
+	int32 GroupMaxLODSize = 0;	// 0 = unlimited
+	int32 GroupMinLODSize = 1;
+	int32 GroupNumStreamedMips = -1;	// -1 = all
+	TEnumAsByte<TextureMipGenSettings> GroupMipGenSettings = TMGS_SimpleAverage;
+
+	// Mips that always stay resident for streamed textures
+	int32 MinResidentMips = 7;
+};
+
+struct FTextureMemoryEstimate
+{
+	// Largest mip that will actually be used after MaxTextureSize / LOD bias
+	int32 SizeX = 0;
+	int32 SizeY = 0;
+	int32 NumMips = 0;
+	int32 NumResidentMips = 0;
+
+	// Bits per pixel of the compressed format
+	int32 BitsPerPixel = 0;
+
+	// Always in GPU memory
+	int64 ResidentBytes = 0;
+
+	// Only in GPU memory when the streamer wants it
+	int64 StreamedBytes = 0;
+
+	// Stored in the cooked package
+	int64 CookedBytes = 0;
+
+	int64 GetTotalBytes() const { return ResidentBytes + StreamedBytes; }
+
+	FTextureMemoryEstimate& operator+=(const FTextureMemoryEstimate& Other)
+	{
+		ResidentBytes += Other.ResidentBytes;
+		StreamedBytes += Other.StreamedBytes;
+		CookedBytes += Other.CookedBytes;
+		return *this;
+	}
+};
+
+// Predicts GPU memory and cooked size from source dimensions and settings.
+// Pure CPU; never builds or loads derived data.
+namespace TextureMemoryEstimator
+{
+	FTextureMemoryEstimate Estimate(const FTextureMemoryInputs& Inputs);
+
+	// LOD groups of the active device profile, or nullptr
+	const UTextureLODSettings* GetActiveLODSettings();
+
+	// Bits per pixel and block size (1 or 4) of the format a setting compresses to
+	void GetFormatInfo(TextureCompressionSettings Compression, bool bHasAlpha, int32& OutBitsPerPixel, int32& OutBlockSize);
+
+	// The texture's own settings, in preset form
+	FTexturePresetSettings GetTextureSettings(const UTexture2D* Texture);
+
+	// Inputs for a loaded texture, using Settings instead of its own
+	FTextureMemoryInputs MakeInputs(const UTexture2D* Texture, const FTexturePresetSettings& Settings);
+
+	// Inputs from asset registry tags only (no load); false if the tags are missing
+	bool MakeInputs(const FAssetData& Asset, const FTexturePresetSettings* Settings, FTextureMemoryInputs& OutInputs);
+
+	// Game thread; loaded textures only
+	FTextureMemoryEstimate EstimateTexture(const UTexture2D* Texture);
+	FTextureMemoryEstimate EstimateTexture(const UTexture2D* Texture, const FTexturePresetSettings& Settings);
+
+	// Loaded textures exactly, anything else from its registry tags (never loads)
+	FTextureMemoryEstimate EstimateAsset(const FAssetData& Asset);
+
+	// Sum over the preset's linked textures as if they used Settings (only the
+	// fields the preset applies; the rest stay each texture's own)
+	FTextureMemoryEstimate EstimatePreset(const UTexturePresetAsset* Preset, const FTexturePresetSettings& Settings);
+}
@@ -6,8 +6,46 @@
 #include "Engine/TextureDefines.h"
 
 #include "Math/Color.h"
+#include "TextureScalabilityTable.h"
 #include "TexturePresetAsset.generated.h"
 
+// Size and LOD values for one platform or platform group ("Desktop",
+// "Mobile", "Console", ...). A platform's own entry wins over its group's.
+// Only the downscale reaches the texture when the preset is applied in the
+// editor; size, LOD bias and quality need Apply At Cook.
+USTRUCT(BlueprintType)
+struct FTexturePresetPlatformOverride
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, Category = "Platform", meta = (GetOptions = "/Script/TextureManager.TexturePresetAsset.GetPlatformOptions"))
+    FName Platform;
+
+    UPROPERTY(EditAnywhere, Category = "Platform", meta = (InlineEditConditionToggle))
+    bool bOverrideMaxTextureSize = false;
+
+    UPROPERTY(EditAnywhere, Category = "Platform", meta = (EditCondition = "bOverrideMaxTextureSize", ToolTip = "Only applied when the preset has Apply At Cook set"))
+    int32 MaxTextureSize = 0;
+
+    UPROPERTY(EditAnywhere, Category = "Platform", meta = (InlineEditConditionToggle))
+    bool bOverrideLODBias = false;
+
+    UPROPERTY(EditAnywhere, Category = "Platform", meta = (EditCondition = "bOverrideLODBias", ToolTip = "Only applied when the preset has Apply At Cook set"))
+    int32 LODBias = 0;
+
+    UPROPERTY(EditAnywhere, Category = "Platform", meta = (InlineEditConditionToggle))
+    bool bOverrideDownscaleFactor = false;
+
+    UPROPERTY(EditAnywhere, Category = "Platform", meta = (EditCondition = "bOverrideDownscaleFactor"))
+    float DownscaleFactor = 1.0f;
+
+    UPROPERTY(EditAnywhere, Category = "Platform", meta = (InlineEditConditionToggle))
+    bool bOverrideCompressionQuality = false;
+
+    UPROPERTY(EditAnywhere, Category = "Platform", meta = (EditCondition = "bOverrideCompressionQuality", ToolTip = "Only applied when the preset has Apply At Cook set"))
+    int32 CompressionQuality = 0;
+};
+
 USTRUCT(BlueprintType)
 struct FTexturePresetSettings
 {
@@ -41,8 +79,10 @@ struct FTexturePresetSettings
 
     // Compression
 
+    // Off compresses the textures without alpha (CompressionNoAlpha). A
+    // texture that uses its alpha keeps it when the preset is applied.
     UPROPERTY(EditAnywhere, Category = "Compression")
-    bool bUseAlpha = false;
+    bool bUseAlpha = true;
 
     UPROPERTY(EditAnywhere, Category = "Compression")
     TEnumAsByte<TextureCompressionSettings> CompressionSettings = TC_Default;
@@ -112,6 +152,13 @@ struct FTexturePresetSettings
 
     UPROPERTY(EditAnywhere, Category = "Other")
     bool VirtualTextureStreaming = false;
+
+    // Platforms
+
+    // Downscale goes into the texture's per-platform value; size, LOD bias
+    // and quality only apply at cook and are disabled without Apply At Cook
+    UPROPERTY(EditAnywhere, Category = "Platforms")
+    TArray<FTexturePresetPlatformOverride> PlatformOverrides;
 };
 
 
@@ -124,9 +171,58 @@ public:
     UPROPERTY(EditAnywhere, Category = "Texture Preset")
     FName PresetName;
 
+    // Settings not listed in OverriddenFields come from this preset
+    UPROPERTY(EditAnywhere, Category = "Texture Preset")
+    TObjectPtr<UTexturePresetAsset> ParentPreset;
+
+    // Fields of Settings this preset sets itself when it has a parent.
+    // Editing a field adds it; remove a name to inherit it again.
+    UPROPERTY(EditAnywhere, Category = "Texture Preset", meta = (EditCondition = "ParentPreset != nullptr", GetOptions = "GetSettingsFieldOptions"))
+    TArray<FName> OverriddenFields;
+
+    // Only these fields are applied to and captured from textures, so a
+    // preset can handle e.g. streaming alone. Empty = the parent's, or all.
+    UPROPERTY(EditAnywhere, Category = "Texture Preset", meta = (GetOptions = "GetAppliedFieldOptions"))
+    TArray<FName> AppliedFields;
+
+    // Saving the preset leaves its textures' packages alone; the cook
+    // applies the settings in memory instead (see TexturePresetCook)
+    UPROPERTY(EditAnywhere, Category = "Texture Preset")
+    bool bApplyAtCook = false;
+
     UPROPERTY(EditAnywhere, Category = "Texture Preset", meta = (ShowOnlyInnerProperties))
     FTexturePresetSettings Settings;
 
+    // Runtime changes per sg.TextureQuality (0 Low .. 4 Cinematic), cooked
+    // into the texture scalability table. Empty = the parent's, or none.
+    UPROPERTY(EditAnywhere, Category = "Scalability")
+    TArray<FTextureScalabilityTier> ScalabilityTiers;
+
     UPROPERTY(VisibleAnywhere, Category = "Files")
     TArray<UTexture2D*> Files;
+
+    // Call after changing Settings, ParentPreset or OverriddenFields from code;
+    // resolved settings of this preset and its children are rebuilt on next use
+    void NotifySettingsChanged();
+
+    uint32 GetSettingsRevision() const { return SettingsRevision; }
+
+    UFUNCTION()
+    static TArray<FName> GetSettingsFieldOptions();
+
+    UFUNCTION()
+    static TArray<FName> GetAppliedFieldOptions();
+
+    // Platform group names, then platform names
+    UFUNCTION()
+    static TArray<FName> GetPlatformOptions();
+
+#if WITH_EDITOR
+    virtual bool CanEditChange(const FProperty* InProperty) const override;
+    virtual void PostEditChangeChainProperty(FPropertyChangedChainEvent& Event) override;
+    virtual void PostEditUndo() override;
+#endif
+
+private:
+    uint32 SettingsRevision = 0;
 };
@@ -0,0 +1,101 @@
+// TexturePresetClustering.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include "TexturePresetAsset.h"
+
+class UTexture2D;
+class UTexturePresetAsset;
+
+struct FTextureClusteringOptions
+{
+	// Float settings closer than this count as equal (near-identical)
+	float FloatTolerance = 0.01f;
+
+	// Group regardless of LODBias / MaxTextureSize; members keep the most common values
+	bool bIgnoreSizeOverrides = false;
+
+	// Smaller groups are left alone rather than getting a preset of their own
+	int32 MinClusterSize = 2;
+
+	// Also consider textures that already have a preset
+	bool bIncludeAssigned = false;
+};
+
+// Textures whose settings only differ within the tolerance
+struct FTextureSettingsCluster
+{
+	// The most common exact settings among the members
+	FTexturePresetSettings Settings;
+
+	uint64 NearHash = 0;
+	uint64 ExactHash = 0;
+
+	// Largest first
+	TArray<FAssetData> Assets;
+
+	// Members whose settings already match Settings exactly
+	int32 NumExact = 0;
+
+	// Existing preset with the same settings; null = a new one is proposed
+	TWeakObjectPtr<UTexturePresetAsset> ExistingPreset;
+	FName ProposedName;
+};
+
+// Presets whose settings are exactly equal
+struct FPresetMergeGroup
+{
+	// Keeper first (most linked textures, then shortest name)
+	TArray<TWeakObjectPtr<UTexturePresetAsset>> Presets;
+};
+
+struct FTextureClusteringResult
+{
+	// Most members first
+	TArray<FTextureSettingsCluster> Clusters;
+
+	int32 NumTextures = 0;
+	int32 NumClustered = 0;
+	int32 NumGroups = 0;
+	double Seconds = 0.0;
+};
+
+// Groups textures by their settings to bootstrap presets on projects that
+// never had any. Runs on metadata only: loaded textures are captured exactly
+// (CaptureSettings), the rest from their asset registry tags. Hashing walks
+// FTexturePresetSettings by reflection, so new fields take part automatically.
+namespace TexturePresetClustering
+{
+	// Settings from the registry tags (no load); fields without a tag keep their defaults
+	FTexturePresetSettings CaptureFromTags(const FAssetData& Asset);
+
+	// Hash of every setting; near-identical settings hash the same when bQuantize is set
+	uint64 HashSettings(const FTexturePresetSettings& Settings, const FTextureClusteringOptions& Options, bool bQuantize);
+
+	// Capture and hash in parallel, then group. Game thread.
+	FTextureClusteringResult FindClusters(
+		const TArray<FAssetData>& Textures,
+		const TArray<TWeakObjectPtr<UTexturePresetAsset>>& ExistingPresets,
+		const FTextureClusteringOptions& Options = FTextureClusteringOptions());
+
+	// Create the proposed presets under PackagePath and assign every member,
+	// queued on TextureRebuildScheduler under one journal batch. Members whose loaded settings turn out not to match (a setting
+	// the tags didn't show) are skipped. Returns the number of textures assigned.
+	int32 AssignClusters(
+		const TArray<FTextureSettingsCluster>& Clusters,
+		const FString& PackagePath,
+		const FTextureClusteringOptions& Options,
+		int32& OutSkipped);
+
+	// Groups of presets that hash the same with every setting compared exactly
+	// and that agree on parent, overridden and applied fields, bApplyAtCook
+	// and scalability tiers
+	TArray<FPresetMergeGroup> FindDuplicatePresets(const TArray<TWeakObjectPtr<UTexturePresetAsset>>& Presets);
+
+	// Point every texture linked to a duplicate at the keeper (one undoable
+	// transaction), then consolidate the duplicates into redirectors to the
+	// keeper. Returns the number of presets merged away.
+	int32 MergePresets(const TArray<FPresetMergeGroup>& Groups);
+}
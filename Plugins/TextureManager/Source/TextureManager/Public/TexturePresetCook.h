@@ -0,0 +1,28 @@
+// TexturePresetCook.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UTexture2D;
+class UTexturePresetAsset;
+
+// Applies presets marked bApplyAtCook while cooking: each texture gets its
+// effective preset (own or folder) written onto it in memory right after it
+// loads, before the cooker builds its platform data. Nothing is marked dirty
+// or saved back to the source package. Only active in the cook commandlet.
+namespace TexturePresetCook
+{
+	void Register();
+	void Unregister();
+
+	// Hash of what the preset writes onto a texture for a platform (None = all)
+	FGuid GetPresetHash(const UTexturePresetAsset* Preset, FName PlatformName);
+
+	// Apply the texture's cook-time preset in memory. True if anything changed.
+	// PlatformName None (a multi-platform cook) keeps only the per-platform
+	// downscale; other platform overrides are dropped, with a warning once
+	// per preset when cooking.
+	// The preset hash is combined with the texture's own CompressionCacheId
+	// as it was before the first call, so repeated calls give the same key.
+	bool ApplyForCook(UTexture2D* Texture, FName PlatformName);
+}
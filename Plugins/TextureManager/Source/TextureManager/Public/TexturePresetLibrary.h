@@ -2,19 +2,73 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
 
+class UPackage;
 class UTexture2D;
 class UTexturePresetAsset;
 class UTexturePresetUserData;
+struct FTexturePresetSettings;
 
 // Simple namespace, no UObject / UHT involved
 namespace TexturePresetLibrary
 {
-	// Copy current texture settings into the preset asset
+	// Current texture settings in preset form
+	FTexturePresetSettings CaptureSettings(const UTexture2D* Texture);
+
+	// Copy the texture's current values of the fields the preset applies into the preset asset
 	void CaptureFromTexture(UTexturePresetAsset* PresetAsset, UTexture2D* Texture);
 
-	// Apply preset settings onto a texture
-	void ApplyToTexture(UTexturePresetAsset* PresetAsset, UTexture2D* Texture);
+	// Apply the fields the preset applies (resolved through its parents) onto a
+	// texture. False if the texture already matched and needs no rebuild.
+	bool ApplyToTexture(UTexturePresetAsset* PresetAsset, UTexture2D* Texture);
+
+	// Same with settings already resolved, e.g. for one platform
+	bool ApplySettingsToTexture(const FTexturePresetSettings& Settings, uint64 FieldMask, UTexture2D* Texture);
+
+	// Settings as they build for one platform (ini name, e.g. "Android"): the
+	// overrides of its group, then its own, replace size, LOD bias, downscale
+	// and compression quality. The result has no PlatformOverrides left.
+	FTexturePresetSettings ResolveForPlatform(const FTexturePresetSettings& Settings, FName PlatformName);
+
+	// Only the cook can apply per-platform size, LOD bias and quality; a preset
+	// applied in the editor keeps just the downscale overrides
+	void ClearCookOnlyOverrides(FTexturePresetSettings& Settings);
+	bool HasCookOnlyOverrides(const FTexturePresetSettings& Settings);
+
+	// Fields ApplyToTexture / CaptureFromTexture know how to transfer
+	TArray<FName> GetApplicableFields();
+
+	// Bit per GetApplicableFields() entry the preset applies: its AppliedFields,
+	// else the nearest ancestor's, else every field
+	uint64 GetAppliedFieldMask(const UTexturePresetAsset* PresetAsset);
+	uint64 GetAllFieldsMask();
+
+	// Copy the fields in FieldMask, e.g. to lay a partial preset over a texture's own settings
+	void CopyFields(const FTexturePresetSettings& From, FTexturePresetSettings& To, uint64 FieldMask);
+
+	// Fields the preset applies whose value on the texture differs
+	TArray<FName> DiffTexture(const UTexturePresetAsset* PresetAsset, const UTexture2D* Texture);
+
+	// Same with settings already resolved
+	TArray<FName> DiffSettings(const FTexturePresetSettings& Settings, uint64 FieldMask, const UTexture2D* Texture);
+
+	// Settings with every inherited field filled in from the parent chain.
+	// Cached per preset, rebuilt when it or an ancestor changed its revision.
+	FTexturePresetSettings ResolveSettings(const UTexturePresetAsset* PresetAsset);
+
+	// True when following ParentPreset leads back to the preset (or never ends)
+	bool HasInheritanceCycle(const UTexturePresetAsset* PresetAsset);
+
+	// Presets among Presets that inherit from BasePreset, directly or not
+	TArray<UTexturePresetAsset*> GetDerivedPresets(
+		const UTexturePresetAsset* BasePreset,
+		const TArray<TWeakObjectPtr<UTexturePresetAsset>>& Presets);
+
+	// Queue every preset's textures (its Files) on TextureRebuildScheduler,
+	// each texture at most once, unchanged ones not at all. Presets applied
+	// at cook time are skipped. Returns the number of textures queued.
+	int32 ApplyToLinkedTextures(const TArray<UTexturePresetAsset*>& Presets);
 
 	// Create a new preset asset (under PackagePath) from the texture's current settings
 	UTexturePresetAsset* CreatePresetAssetFromTexture(
@@ -38,5 +92,8 @@ namespace TexturePresetLibrary
 
 	void CopyProperties(UTexturePresetAsset* AssetIn, UTexturePresetAsset* AssetOut);
 
-	void RemovePresetFromTexture(UTexture2D* Texture);
+	// Unlink the texture from its preset and save the preset; with
+	// OutPackagesToSave the preset package is added there for the caller to
+	// save, e.g. once for many textures
+	void RemovePresetFromTexture(UTexture2D* Texture, TArray<UPackage*>* OutPackagesToSave = nullptr);
 }
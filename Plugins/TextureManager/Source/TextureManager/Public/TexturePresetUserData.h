@@ -13,4 +13,9 @@ class UTexturePresetUserData : public UAssetUserData
 public:
     UPROPERTY(VisibleAnywhere, Category = "Texture Preset")
     TObjectPtr<UTexturePresetAsset> AssignedPreset;
+
+    // AssignedPreset came from a folder preset (TextureFolderPresets) and
+    // follows the folder; false = assigned to this texture directly
+    UPROPERTY(VisibleAnywhere, Category = "Texture Preset")
+    bool bFromFolder = false;
 };
@@ -0,0 +1,74 @@
+// TexturePreviewPool.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Guid.h"
+#include "UObject/StrongObjectPtr.h"
+
+class UTexture2D;
+class UTexturePresetAsset;
+
+// Transient copies of textures and presets for the details view.
+//
+// The details view edits a copy so nothing reaches the asset until Save. A
+// copy is made once per source and kept in a small LRU; selecting the source
+// again copies its editable properties over the pooled object instead of
+// duplicating it (a texture copy carries its own source mips). A texture is
+// duplicated again only when its source art changed. Evicted copies are
+// released to the garbage collector.
+//
+// The objects and estimated bytes held by all pools are published as
+// "stat TPM" values and TextureManager/Preview trace counters. Game thread only.
+class FTexturePreviewPool
+{
+public:
+	explicit FTexturePreviewPool(int32 InMaxTextures = 4, int32 InMaxPresets = 4);
+	~FTexturePreviewPool();
+
+	FTexturePreviewPool(const FTexturePreviewPool&) = delete;
+	FTexturePreviewPool& operator=(const FTexturePreviewPool&) = delete;
+
+	// Copy of Source showing its current values; nullptr for nullptr
+	UTexture2D* GetTexture(UTexture2D* Source);
+
+	// Copy of Source with the settings it resolves to through its parents
+	UTexturePresetAsset* GetPreset(UTexturePresetAsset* Source);
+
+	// Same as GetPreset, but always the one scratch object, separate from the
+	// previews, for work that modifies its copy and throws it away
+	UTexturePresetAsset* GetScratchPreset(UTexturePresetAsset* Source);
+
+	// Release every copy, e.g. before assets are deleted
+	void Reset();
+
+	int32 GetNum() const { return Textures.Num() + Presets.Num() + (Scratch.Clone.IsValid() ? 1 : 0); }
+
+	// Across all pools
+	static int32 GetNumLiveObjects();
+	static int64 GetLiveBytes();
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<UObject> Source;
+		TStrongObjectPtr<UObject> Clone;
+
+		// Source art the texture copy was made from
+		FGuid SourceId;
+
+		int64 Bytes = 0;
+	};
+
+	// Most recently used last
+	FEntry* FindOrAdd(TArray<FEntry>& Entries, int32 MaxEntries, UObject* Source);
+
+	void Fill(FEntry& Entry, UObject* Source);
+	void Release(FEntry& Entry);
+
+	int32 MaxTextures;
+	int32 MaxPresets;
+
+	TArray<FEntry> Textures;
+	TArray<FEntry> Presets;
+	FEntry Scratch;
+};
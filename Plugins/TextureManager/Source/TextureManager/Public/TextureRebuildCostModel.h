@@ -0,0 +1,43 @@
+// TextureRebuildCostModel.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UTexture2D;
+class UTexturePresetAsset;
+struct FTextureMemoryInputs;
+
+struct FTextureRebuildEstimate
+{
+	int32 NumTextures = 0;
+
+	// Of NumTextures, how many had no history for their format / size / mips
+	// and were extrapolated from other buckets
+	int32 NumExtrapolated = 0;
+
+	double Seconds = 0.0;
+};
+
+// Learns how long textures take to rebuild, per compression format, size
+// (power of two of the built top mip) and with or without mips, as seconds
+// per megapixel. Fed by TexturePresetLibrary::ApplyToLinkedTextures, kept in
+// Saved/TextureManager/RebuildCosts.bin so it carries over sessions.
+// Game thread only.
+namespace TextureRebuildCostModel
+{
+	// Record that the texture, with its current settings, took Seconds to build
+	void AddSample(const UTexture2D* Texture, double Seconds);
+
+	// Predicted build time; bOutExtrapolated when its own bucket has no samples
+	double EstimateSeconds(const FTextureMemoryInputs& Inputs, bool& bOutExtrapolated);
+
+	// Time to rebuild the textures that would change if Preset were applied
+	// to them (unchanged ones are skipped, as on apply)
+	FTextureRebuildEstimate EstimateApply(const UTexturePresetAsset* Preset, const TArray<UTexture2D*>& Textures);
+
+	// Write the model if samples were added since the last save
+	void Save();
+
+	// While off, AddSample ignores builds, e.g. of a benchmark's synthetic textures
+	void SetRecording(bool bRecord);
+}
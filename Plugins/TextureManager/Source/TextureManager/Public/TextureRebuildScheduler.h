@@ -0,0 +1,60 @@
+// TextureRebuildScheduler.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UTexture2D;
+class UTexturePresetAsset;
+struct FTexturePresetSettings;
+
+struct FTextureRebuildSchedulerState
+{
+	int32 NumQueued = 0;
+	int32 NumBuilding = 0;
+	int32 NumDone = 0;
+
+	// Estimated memory the builds in flight hold
+	int64 BuildingBytes = 0;
+
+	bool bPaused = false;
+
+	bool IsIdle() const { return NumQueued == 0 && NumBuilding == 0; }
+};
+
+// Gives textures their preset and rebuilds them a few at a time instead of
+// all at once: a texture is only applied and started (PostEditChange) once
+// fewer than the allowed builds are running and its estimated build memory
+// fits the budget (UTextureManagerSettings). Textures a listener reports
+// through OnGatherPriority (e.g. visible or selected rows) go first.
+// Queued textures stay untouched until they start, so cancelling leaves
+// them as they were. Game thread only; runs from the core ticker.
+namespace TextureRebuildScheduler
+{
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnGatherPriority, TSet<FName>& /*PackageNames*/);
+
+	// Apply Preset to Texture and rebuild it when its turn comes. A texture
+	// already queued keeps its place and takes the newest preset. With a
+	// JournalBatch (TextureBulkJournal) the old values go to the journal
+	// instead of the transaction buffer.
+	void Enqueue(UTexturePresetAsset* Preset, UTexture2D* Texture, const FGuid& JournalBatch = FGuid());
+
+	// Same with settings already resolved; only the fields in FieldMask are
+	// written (TexturePresetLibrary::ApplySettingsToTexture). Not journaled.
+	void EnqueueSettings(const FTexturePresetSettings& Settings, uint64 FieldMask, UTexture2D* Texture);
+
+	void Pause();
+	void Resume();
+
+	// Drop what has not started; running builds finish
+	void Cancel();
+
+	// Build everything before returning, ignoring pause (commandlets)
+	void Flush();
+
+	FTextureRebuildSchedulerState GetState();
+
+	FOnGatherPriority& OnGatherPriority();
+
+	// The last running build finished and nothing is queued
+	FSimpleMulticastDelegate& OnDrained();
+}
@@ -0,0 +1,76 @@
+// TextureResidencyReport.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/TextureDefines.h"
+#include "TextureMemoryEstimator.h"
+
+// One texture in the report
+struct FTextureResidencyEntry
+{
+	FName PackageName;
+	FString AssetName;
+	FName PresetName;	// None = no preset assigned
+	TEnumAsByte<TextureGroup> Group = TEXTUREGROUP_World;
+
+	// NeverStream or bForceMiplevelsToBeResident
+	bool bPinned = false;
+
+	FTextureMemoryEstimate Estimate;
+
+	// Resident memory on top of what the texture would keep if it streamed
+	int64 PinnedExtraBytes = 0;
+};
+
+// Sum over a preset or a LOD group
+struct FTextureResidencyTotal
+{
+	FString Label;
+	int32 NumTextures = 0;
+	int32 NumPinned = 0;
+	int64 ResidentBytes = 0;
+	int64 StreamedBytes = 0;
+	int64 PinnedExtraBytes = 0;
+
+	void Add(const FTextureResidencyEntry& Entry)
+	{
+		++NumTextures;
+		NumPinned += Entry.bPinned ? 1 : 0;
+		ResidentBytes += Entry.Estimate.ResidentBytes;
+		StreamedBytes += Entry.Estimate.StreamedBytes;
+		PinnedExtraBytes += Entry.PinnedExtraBytes;
+	}
+};
+
+struct FTextureResidencyReport
+{
+	// Worst offenders first (largest PinnedExtraBytes, then ResidentBytes)
+	TArray<FTextureResidencyEntry> Entries;
+
+	// Sorted by ResidentBytes, largest first
+	TArray<FTextureResidencyTotal> ByPreset;
+	TArray<FTextureResidencyTotal> ByGroup;
+
+	FTextureResidencyTotal Total;
+
+	// r.Streaming.PoolSize (as configured in DefaultEngine.ini / device profile)
+	int64 PoolSizeBytes = 0;
+
+	// Findings about the pool and the LOD group settings
+	TArray<FString> Warnings;
+};
+
+// Always-resident memory per preset and per texture group, computed from
+// asset registry metadata and preset settings (textures are not loaded;
+// ones that already are use their exact settings)
+namespace TextureResidencyReport
+{
+	// Game thread. The per-texture estimates run in parallel.
+	FTextureResidencyReport Build();
+
+	// Human readable summary; MaxOffenders caps the per-texture ranking
+	FString ToString(const FTextureResidencyReport& Report, int32 MaxOffenders = 20);
+
+	// One line per texture
+	bool SaveCsv(const FTextureResidencyReport& Report, const FString& FilePath);
+}
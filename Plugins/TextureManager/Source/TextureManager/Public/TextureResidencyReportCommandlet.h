@@ -0,0 +1,22 @@
+// TextureResidencyReportCommandlet.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TextureResidencyReportCommandlet.generated.h"
+
+// Prints the texture residency report and writes it as CSV.
+//
+//   UnrealEditor-Cmd.exe <Project> -run=TextureResidencyReport [-csv=<path>] [-top=<N>]
+//
+// Default CSV path: Saved/TextureManager/ResidencyReport.csv
+UCLASS()
+class UTextureResidencyReportCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UTextureResidencyReportCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,29 @@
+// TextureScalabilityExport.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UTexturePresetAsset;
+class UTextureScalabilityTable;
+struct FTextureScalabilityTier;
+
+// Writes UTexturePresetAsset::ScalabilityTiers to the UTextureScalabilityTable
+// the runtime module loads (UTextureScalabilitySettings::Table), so the game
+// needs neither the presets nor the editor module.
+namespace TextureScalabilityExport
+{
+	// Tiers of the preset, else of its nearest parent that has any
+	const TArray<FTextureScalabilityTier>* FindTiers(const UTexturePresetAsset* Preset);
+
+	// Create or refill the table from every preset in the project and save
+	// it (bSave false: in memory only, as the cook needs it). Keeps the
+	// table's streaming pool sizes and leaves an unchanged table untouched.
+	// Null on failure.
+	UTextureScalabilityTable* BuildTable(bool bSave = true);
+
+	// Keep the table current once the project has one: rebuilt after a
+	// preset is saved (tiers or assigned textures changed) and when a cook
+	// starts. A project without a table only gets one from the menu entry.
+	void Register();
+	void Unregister();
+}
@@ -0,0 +1,92 @@
+// TextureThumbnailCache.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+#include "Containers/Ticker.h"
+#include "IO/IoHash.h"
+#include "Tasks/Task.h"
+#include "UObject/StrongObjectPtr.h"
+
+#include <atomic>
+
+class UTexture2D;
+struct FAssetData;
+struct FSlateBrush;
+struct FSlateDynamicImageBrush;
+
+// Small thumbnails for the Files rows.
+//
+// Thumbnails are made on worker threads from the texture's source mip (never
+// from platform / derived data) and kept in a bounded LRU. Finished thumbnails
+// are also written to Saved/TextureManager/Thumbnails, keyed by the package's
+// saved hash, so reopening the tab does not decode anything again.
+//
+// Only textures that are already loaded are ever decoded; for anything else
+// only the on-disk cache is consulted.
+class FTextureThumbnailCache : public TSharedFromThis<FTextureThumbnailCache>
+{
+public:
+	explicit FTextureThumbnailCache(int32 InThumbnailSize = 64, int32 InMaxEntries = 256, int32 InMaxInFlight = 4);
+	~FTextureThumbnailCache();
+
+	// Returns the thumbnail if it is ready, otherwise queues it and returns nullptr.
+	// Call this from the row that is about to be drawn so only visible rows ask.
+	const FSlateBrush* GetThumbnail(const FAssetData& Asset);
+	const FSlateBrush* GetThumbnail(UTexture2D* Texture);
+
+	// Drop a queued request / abandon an in-flight one (row scrolled away)
+	void CancelRequest(FName PackageName);
+
+	int32 GetThumbnailSize() const { return ThumbnailSize; }
+
+private:
+	// Shared between the game thread and one worker task
+	struct FThumbnailResult
+	{
+		std::atomic<bool> bCancelled{ false };
+		std::atomic<bool> bFinished{ false };
+
+		int32 Width = 0;
+		int32 Height = 0;
+		TArray<uint8> Pixels; // BGRA8
+	};
+
+	struct FThumbnailRequest
+	{
+		FName PackageName;
+		FIoHash PackageHash;
+
+		// Keeps the texture alive while a worker reads its source; only ever
+		// created and released on the game thread
+		TStrongObjectPtr<UTexture2D> Texture;
+
+		TSharedPtr<FThumbnailResult, ESPMode::ThreadSafe> Result;
+		UE::Tasks::FTask Task;
+	};
+
+	const FSlateBrush* FindOrQueue(FName PackageName, UTexture2D* Texture);
+
+	bool Tick(float DeltaTime);
+	void Dispatch(FThumbnailRequest& Request);
+	void AddBrush(FName PackageName, int32 Width, int32 Height, const TArray<uint8>& Pixels);
+
+	FString GetDiskCachePath(const FIoHash& Hash) const;
+
+	int32 ThumbnailSize;
+	int32 MaxInFlight;
+
+	TLruCache<FName, TSharedPtr<FSlateDynamicImageBrush>> Brushes;
+
+	// Waiting for a free worker slot, oldest first
+	TArray<FThumbnailRequest> Queued;
+	TMap<FName, FThumbnailRequest> InFlight;
+
+	// No source data and nothing on disk; don't keep asking
+	TSet<FName> Unavailable;
+
+	// Not loaded and nothing on disk; asked again once the texture is loaded
+	TSet<FName> NotOnDisk;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+};
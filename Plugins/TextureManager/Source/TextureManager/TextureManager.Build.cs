@@ -35,6 +35,8 @@ public class TextureManager : ModuleRules
 				"PropertyEditor", 
 				"ApplicationCore",
                 "Projects",
+				"DeveloperSettings",
+				"TextureManagerRuntime",
             }
 			);
 			
@@ -51,6 +53,11 @@ public class TextureManager : ModuleRules
 				"EditorFramework",
 				"AssetTools",
                 "ToolMenus",
+				"ImageCore",
+				"ContentBrowser",
+				"TargetPlatform",
+				"DerivedDataCache",
+				"Json",
             }
 			);
 		
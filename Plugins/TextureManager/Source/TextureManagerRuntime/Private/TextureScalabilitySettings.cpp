@@ -0,0 +1,11 @@
+#include "TextureScalabilitySettings.h"
+
+#include "TextureScalabilityTable.h"
+
+UTextureScalabilitySettings::UTextureScalabilitySettings()
+{
+	CategoryName = TEXT("Plugins");
+	SectionName = TEXT("TextureScalability");
+	Table = TSoftObjectPtr<UTextureScalabilityTable>(
+		FSoftObjectPath(TEXT("/Game/TextureManager/TextureScalabilityTable.TextureScalabilityTable")));
+}
@@ -0,0 +1,236 @@
+#include "TextureScalabilitySubsystem.h"
+
+#include "TextureScalabilitySettings.h"
+#include "TextureScalabilityTable.h"
+
+#include "ContentStreaming.h"
+#include "Engine/Level.h"
+#include "Engine/Texture2D.h"
+#include "Engine/World.h"
+#include "Scalability.h"
+#include "UObject/UObjectIterator.h"
+
+namespace
+{
+	int32 GetTextureQuality()
+	{
+		return Scalability::GetQualityLevels().TextureQuality;
+	}
+}
+
+bool UTextureScalabilitySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// The editor owns the assets; a server never renders them
+	return !GIsEditor && !IsRunningDedicatedServer() && GetDefault<UTextureScalabilitySettings>()->bEnabled;
+}
+
+void UTextureScalabilitySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const UTextureScalabilitySettings* Settings = GetDefault<UTextureScalabilitySettings>();
+	UTextureScalabilityTable* LoadedTable = Settings->Table.LoadSynchronous();
+	if (!LoadedTable && !Settings->Table.IsNull())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Texture scalability: table %s not found (not cooked?)"),
+			*Settings->Table.ToString());
+	}
+
+	SinkHandle = IConsoleManager::Get().RegisterConsoleVariableSink_Handle(
+		FConsoleCommandDelegate::CreateUObject(this, &UTextureScalabilitySubsystem::OnConsoleVariablesChanged));
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(
+		this, &UTextureScalabilitySubsystem::OnPostLoadMap);
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(
+		this, &UTextureScalabilitySubsystem::OnLevelAddedToWorld);
+
+	SetTable(LoadedTable);
+}
+
+void UTextureScalabilitySubsystem::Deinitialize()
+{
+	IConsoleManager::Get().UnregisterConsoleVariableSink_Handle(SinkHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	if (PendingApplyHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PendingApplyHandle);
+		PendingApplyHandle.Reset();
+	}
+
+	RestoreTextures();
+	RestorePoolSize();
+	Table = nullptr;
+	EntryByPackage.Reset();
+
+	Super::Deinitialize();
+}
+
+void UTextureScalabilitySubsystem::SetTable(UTextureScalabilityTable* InTable)
+{
+	RestoreTextures();
+
+	Table = InTable;
+	EntryByPackage.Reset();
+	if (Table)
+	{
+		for (int32 Index = 0; Index < Table->Entries.Num(); ++Index)
+		{
+			for (const FName Package : Table->Entries[Index].Packages)
+			{
+				EntryByPackage.Add(Package, Index);
+			}
+		}
+	}
+
+	AppliedTier = INDEX_NONE;
+	ApplyCurrentTier();
+}
+
+int32 UTextureScalabilitySubsystem::ApplyCurrentTier()
+{
+	AppliedTier = GetTextureQuality();
+	ApplyPoolSize();
+	if (!Table)
+	{
+		return 0;
+	}
+
+	IRenderAssetStreamingManager& Streaming = IStreamingManager::Get().GetRenderAssetStreamingManager();
+
+	int32 NumChanged = 0;
+	for (TObjectIterator<UTexture2D> It; It; ++It)
+	{
+		UTexture2D* Texture = *It;
+		const int32* EntryIndex = EntryByPackage.Find(Texture->GetOutermost()->GetFName());
+		if (!EntryIndex)
+		{
+			continue;
+		}
+
+		FOriginalState* Original = Originals.Find(Texture);
+		if (!Original)
+		{
+			Original = &Originals.Add(Texture, { Texture->LODBias, (bool)Texture->bForceMiplevelsToBeResident });
+		}
+
+		const FTextureScalabilityTier Tier = Table->Entries[*EntryIndex].GetTier(AppliedTier);
+		const int32 LODBias = Original->LODBias + Tier.LODBiasOffset;
+		const bool bResident = Original->bForceMiplevelsToBeResident && Tier.bKeepResident;
+		if (Texture->LODBias == LODBias && (bool)Texture->bForceMiplevelsToBeResident == bResident)
+		{
+			continue;
+		}
+
+		Texture->LODBias = LODBias;
+		Texture->bForceMiplevelsToBeResident = bResident;
+		Texture->UpdateCachedLODBias();
+		Streaming.UpdateIndividualRenderAsset(Texture);
+		++NumChanged;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Texture scalability: tier %d applied, %d textures changed"), AppliedTier, NumChanged);
+	return NumChanged;
+}
+
+void UTextureScalabilitySubsystem::OnConsoleVariablesChanged()
+{
+	// The sink fires for any console variable
+	if (GetTextureQuality() != AppliedTier)
+	{
+		ApplyCurrentTier();
+	}
+}
+
+void UTextureScalabilitySubsystem::OnPostLoadMap(UWorld* World)
+{
+	// Textures the map brought in; the ones already changed are skipped
+	ApplyCurrentTier();
+	ForgetUnloadedTextures();
+}
+
+void UTextureScalabilitySubsystem::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	// World partition and level streaming add several levels in a row;
+	// apply once for all of them on the next tick
+	if (!Table || PendingApplyHandle.IsValid())
+	{
+		return;
+	}
+
+	PendingApplyHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UTextureScalabilitySubsystem::ApplyToNewTextures));
+}
+
+bool UTextureScalabilitySubsystem::ApplyToNewTextures(float DeltaTime)
+{
+	PendingApplyHandle.Reset();
+
+	// Streamed-out levels took their textures with them
+	ForgetUnloadedTextures();
+	ApplyCurrentTier();
+	return false;
+}
+
+void UTextureScalabilitySubsystem::ForgetUnloadedTextures()
+{
+	for (auto It = Originals.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UTextureScalabilitySubsystem::ApplyPoolSize()
+{
+	const int32 TierPoolSizeMB = (Table && Table->StreamingPoolSizeMB.IsValidIndex(AppliedTier))
+		? Table->StreamingPoolSizeMB[AppliedTier]
+		: 0;
+	if (TierPoolSizeMB <= 0)
+	{
+		// Tiers without a value leave the pool as configured, not as the last tier had it
+		RestorePoolSize();
+		return;
+	}
+
+	// Scalability priority: a device profile or console value still wins
+	if (IConsoleVariable* PoolSize = IConsoleManager::Get().FindConsoleVariable(TEXT("r.Streaming.PoolSize")))
+	{
+		if (OriginalPoolSizeMB == INDEX_NONE)
+		{
+			OriginalPoolSizeMB = PoolSize->GetInt();
+		}
+		PoolSize->Set(TierPoolSizeMB, ECVF_SetByScalability);
+	}
+}
+
+void UTextureScalabilitySubsystem::RestorePoolSize()
+{
+	if (OriginalPoolSizeMB == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (IConsoleVariable* PoolSize = IConsoleManager::Get().FindConsoleVariable(TEXT("r.Streaming.PoolSize")))
+	{
+		PoolSize->Set(OriginalPoolSizeMB, ECVF_SetByScalability);
+	}
+	OriginalPoolSizeMB = INDEX_NONE;
+}
+
+void UTextureScalabilitySubsystem::RestoreTextures()
+{
+	IRenderAssetStreamingManager& Streaming = IStreamingManager::Get().GetRenderAssetStreamingManager();
+	for (const TPair<TWeakObjectPtr<UTexture2D>, FOriginalState>& Pair : Originals)
+	{
+		if (UTexture2D* Texture = Pair.Key.Get())
+		{
+			Texture->LODBias = Pair.Value.LODBias;
+			Texture->bForceMiplevelsToBeResident = Pair.Value.bForceMiplevelsToBeResident;
+			Texture->UpdateCachedLODBias();
+			Streaming.UpdateIndividualRenderAsset(Texture);
+		}
+	}
+	Originals.Reset();
+}
@@ -0,0 +1,26 @@
+// TextureScalabilitySettings.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "TextureScalabilitySettings.generated.h"
+
+class UTextureScalabilityTable;
+
+// Project Settings > Plugins > Texture Scalability (DefaultGame.ini)
+UCLASS(config = Game, defaultconfig, meta = (DisplayName = "Texture Scalability"))
+class TEXTUREMANAGERRUNTIME_API UTextureScalabilitySettings : public UDeveloperSettings
+{
+    GENERATED_BODY()
+
+public:
+    UTextureScalabilitySettings();
+
+    // Loaded at startup. Nothing references it from a map, so add its folder
+    // to "Additional Asset Directories to Cook" in the packaging settings.
+    UPROPERTY(config, EditAnywhere, Category = "Scalability")
+    TSoftObjectPtr<UTextureScalabilityTable> Table;
+
+    UPROPERTY(config, EditAnywhere, Category = "Scalability")
+    bool bEnabled = true;
+};
@@ -0,0 +1,76 @@
+// TextureScalabilitySubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "TextureScalabilitySubsystem.generated.h"
+
+class ULevel;
+class UTexture2D;
+class UTextureScalabilityTable;
+class UWorld;
+
+// Applies the scalability table for the current sg.TextureQuality: LOD bias
+// and forced residency of every loaded texture per preset, and the streaming
+// pool size (back to the configured one for tiers without). Runs at startup, whenever the texture quality changes, after
+// each map load and once a frame after streaming levels were added (for the
+// textures that came with them). Games only; never touches assets in the
+// editor.
+UCLASS()
+class TEXTUREMANAGERRUNTIME_API UTextureScalabilitySubsystem : public UEngineSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // Replace the table (null = restore every texture) and apply it
+    void SetTable(UTextureScalabilityTable* InTable);
+
+    // Apply the current tier to all loaded textures. Returns the number changed.
+    int32 ApplyCurrentTier();
+
+    // sg.TextureQuality last applied, INDEX_NONE before the first apply
+    int32 GetAppliedTier() const { return AppliedTier; }
+
+private:
+    void OnConsoleVariablesChanged();
+    void OnPostLoadMap(UWorld* World);
+    void OnLevelAddedToWorld(ULevel* Level, UWorld* World);
+    bool ApplyToNewTextures(float DeltaTime);
+    void ForgetUnloadedTextures();
+    void RestoreTextures();
+    void ApplyPoolSize();
+    void RestorePoolSize();
+
+    UPROPERTY()
+    TObjectPtr<UTextureScalabilityTable> Table;
+
+    // Package -> index into Table->Entries
+    TMap<FName, int32> EntryByPackage;
+
+    // Values as cooked, so tiers never stack
+    struct FOriginalState
+    {
+        int32 LODBias = 0;
+        bool bForceMiplevelsToBeResident = false;
+    };
+    TMap<TWeakObjectPtr<UTexture2D>, FOriginalState> Originals;
+
+    // r.Streaming.PoolSize before a tier first set it; INDEX_NONE while no
+    // tier has a pool size
+    int32 OriginalPoolSizeMB = INDEX_NONE;
+
+    int32 AppliedTier = INDEX_NONE;
+
+    FConsoleVariableSinkHandle SinkHandle;
+    FDelegateHandle PostLoadMapHandle;
+    FDelegateHandle LevelAddedHandle;
+
+    // Set while an apply for newly streamed levels is waiting for the next tick
+    FTSTicker::FDelegateHandle PendingApplyHandle;
+};
@@ -0,0 +1,60 @@
+// TextureScalabilityTable.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "TextureScalabilityTable.generated.h"
+
+// What one texture quality tier does to a preset's textures
+USTRUCT(BlueprintType)
+struct TEXTUREMANAGERRUNTIME_API FTextureScalabilityTier
+{
+    GENERATED_BODY()
+
+    // Added to each texture's own LODBias; 1 = half resolution
+    UPROPERTY(EditAnywhere, Category = "Scalability", meta = (ClampMin = "0", ClampMax = "8"))
+    int8 LODBiasOffset = 0;
+
+    // Off = textures forced resident (bForceMiplevelsToBeResident) stream like any other
+    UPROPERTY(EditAnywhere, Category = "Scalability")
+    bool bKeepResident = true;
+};
+
+// One preset: its tiers and the packages of the textures it is assigned to
+USTRUCT()
+struct TEXTUREMANAGERRUNTIME_API FTextureScalabilityEntry
+{
+    GENERATED_BODY()
+
+    UPROPERTY(VisibleAnywhere, Category = "Scalability")
+    FName Preset;
+
+    // Index = sg.TextureQuality (0 Low .. 4 Cinematic); missing tiers use the last one
+    UPROPERTY(VisibleAnywhere, Category = "Scalability")
+    TArray<FTextureScalabilityTier> Tiers;
+
+    UPROPERTY(VisibleAnywhere, Category = "Scalability")
+    TArray<FName> Packages;
+
+    FTextureScalabilityTier GetTier(int32 Quality) const
+    {
+        return Tiers.IsEmpty() ? FTextureScalabilityTier() : Tiers[FMath::Clamp(Quality, 0, Tiers.Num() - 1)];
+    }
+};
+
+// Preset -> per-tier texture settings, built in the editor from the presets
+// (TextureScalabilityExport) and read at runtime by UTextureScalabilitySubsystem.
+// Only presets that change anything at some tier are listed.
+UCLASS(BlueprintType)
+class TEXTUREMANAGERRUNTIME_API UTextureScalabilityTable : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(VisibleAnywhere, Category = "Scalability")
+    TArray<FTextureScalabilityEntry> Entries;
+
+    // r.Streaming.PoolSize per sg.TextureQuality; 0 or missing = leave as configured
+    UPROPERTY(EditAnywhere, Category = "Scalability")
+    TArray<int32> StreamingPoolSizeMB;
+};